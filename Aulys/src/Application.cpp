@@ -32,6 +32,7 @@ namespace Aulys
 
 		// Create our renderer.
 		Renderer::init();
+		this->mFramePacer = FramePacer::create();
 
 		// Create the universal, engine-managed imgui layer. The client application also has access
 		// to this, as it is a protected member of the Application base class.
@@ -93,6 +94,42 @@ namespace Aulys
 		overlay->onAttach();
 	};
 
+	void Application::setFixedTimestep(Timestep step) {
+		AU_CORE_ASSERT(step.getDuration() > FrameClock::duration::zero(),
+					   "[Application::setFixedTimestep] The fixed timestep must be positive, got {0}.", step);
+		this->mFixedStep = step.getDuration();
+		this->mFixedAccumulator = FrameClock::duration::zero();
+	};
+
+	/* Application::runFixedUpdates(Timestep frameTime)
+	 * The accumulator is in whole clock ticks, so the steps taken only depend on the frame times and
+	 * never on float rounding. Every layer gets exactly mFixedStep as its Timestep.
+	 */
+	void Application::runFixedUpdates(Timestep frameTime)
+	{
+		this->mFixedAccumulator += frameTime.getDuration();
+
+		uint32_t steps = 0;
+		while (this->mFixedAccumulator >= this->mFixedStep && steps < this->mMaxFixedSteps) {
+			for (Layer* layer : this->mLayerStack) {
+				layer->onFixedUpdate(this->mFixedStep);
+			}
+			this->mFixedAccumulator -= this->mFixedStep;
+			this->mFixedStepCount++;
+			steps++;
+		}
+
+		// We fell behind by more than we're allowed to catch up on - forget about the rest.
+		if (this->mFixedAccumulator >= this->mFixedStep) {
+			AU_LOG_TRACE("[Application::runFixedUpdates] Dropped {0} fixed steps after a {1}ms frame.",
+						 this->mFixedAccumulator / this->mFixedStep, frameTime.getMilliSeconds());
+			this->mFixedAccumulator %= this->mFixedStep;
+		}
+
+		this->mFixedAlpha = std::chrono::duration<float>(this->mFixedAccumulator)
+		                  / std::chrono::duration<float>(this->mFixedStep);
+	};
+
 /**************************************************************************************************/
 /*** Default run - a little demo for the people who forgot to override Application::Run. ***/
 /**************************************************************************************************/
@@ -16,6 +16,7 @@
 #include "Renderer/Shader.h"
 #include "Renderer/Buffer.h"
 #include "Renderer/OrthographicCamera.h"
+#include "Renderer/FramePacer.h"
 
 namespace Aulys
 {
@@ -35,14 +36,42 @@ namespace Aulys
 
 		static inline Application& get() { return *sInstance; };
 		inline Window& getWindow() const { return *mWindow; };
+		// For main loops that use it, see FramePacer.h - its settings and the frame stats.
+		inline FramePacer& getFramePacer() const { return *mFramePacer; };
+
+		// The fixed-step simulation. Every frame, runFixedUpdates calls Layer::onFixedUpdate once for
+		// every whole fixed timestep that has passed, carrying the remainder over to the next frame.
+		// If a frame took so long that more than maxFixedSteps steps are due, the rest are dropped
+		// (the simulation slows down) instead of trying to catch up and making the next frame slower
+		// still.
+		void setFixedTimestep(Timestep step);
+		inline Timestep getFixedTimestep() const { return mFixedStep; };
+		inline void setMaxFixedSteps(uint32_t maxSteps) { mMaxFixedSteps = maxSteps; };
+		inline uint32_t getMaxFixedSteps() const { return mMaxFixedSteps; };
+		// How far we are between the last fixed step and the next one, in [0, 1). Render the state
+		// as mix(previous, current, alpha) and motion looks smooth at any frame rate.
+		inline float getFixedAlpha() const { return mFixedAlpha; };
+		// Fixed steps run since startup - the same inputs on the same step give the same state, which
+		// is what recording and replaying relies on.
+		inline uint64_t getFixedStepCount() const { return mFixedStepCount; };
 	protected:
 		Uni<Window> mWindow;
+		Uni<FramePacer> mFramePacer;
 		ImGuiLayer* mImGuiLayer;
 
 		bool mRunning = true;
 		LayerStack mLayerStack;
 
-		float mLastFrameTime = 0.0f;
+		FrameClock::time_point mLastFrameTime;
+
+		// Call once per frame with the frame's deltaTime, before rendering.
+		void runFixedUpdates(Timestep frameTime);
+
+		FrameClock::duration mFixedStep = std::chrono::microseconds(8333); // 120Hz
+		FrameClock::duration mFixedAccumulator = FrameClock::duration::zero();
+		uint32_t mMaxFixedSteps = 8;
+		float mFixedAlpha = 0.0f;
+		uint64_t mFixedStepCount = 0;
 
 		OrthographicCamera mCamera;
 
@@ -2,19 +2,35 @@
 
 #include "pch.h"
 
-namespace Aulys 
+#include <chrono>
+
+namespace Aulys
 {
-	class Timestep 
+	// The clock all frame and simulation timing is done with. It's monotonic, so a changed system
+	// time can't make a frame take negative time, and its ticks are nanoseconds on every platform
+	// we build for.
+	using FrameClock = std::chrono::steady_clock;
+
+	// A span of time, kept as whole clock ticks. Summing these (as the fixed-step accumulator in
+	// Application does) is exact, unlike summing float seconds, which lose precision the longer the
+	// program runs.
+	class Timestep
 	{
 	public:
-		Timestep(float time = 0.0f) : mTime(time) {
-			
+		Timestep(float seconds = 0.0f)
+			: mTime(std::chrono::duration_cast<FrameClock::duration>(std::chrono::duration<double>(seconds))) {
+
+		}
+
+		Timestep(FrameClock::duration time) : mTime(time) {
+
 		}
 
-		float getSeconds() const { return mTime; }
-		float getMilliSeconds() const { return mTime * 1000.0f; }
+		float getSeconds() const { return std::chrono::duration<float>(mTime).count(); }
+		float getMilliSeconds() const { return std::chrono::duration<float, std::milli>(mTime).count(); }
+		FrameClock::duration getDuration() const { return mTime; }
 	private:
-		float mTime; // in seconds.
+		FrameClock::duration mTime;
 	}; // class Timestep
 
 	inline std::ostream& operator<<(std::ostream& os, const Timestep& t) {
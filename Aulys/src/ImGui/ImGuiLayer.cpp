@@ -53,13 +53,18 @@ namespace Aulys
 		Application& app = Application::get();
 		auto window = static_cast<GLFWwindow*>(app.getWindow().getNativeWindow());
 
-		ImGui_ImplGlfw_InitForOpenGL(window, true);
+		mPlatformBackend = window != nullptr;
+		if (mPlatformBackend) {
+			ImGui_ImplGlfw_InitForOpenGL(window, true);
+		}
 		ImGui_ImplOpenGL3_Init("#version 410");
 	};
 
 	void ImGuiLayer::onDetach() {
 		ImGui_ImplOpenGL3_Shutdown();
-		ImGui_ImplGlfw_Shutdown();
+		if (mPlatformBackend) {
+			ImGui_ImplGlfw_Shutdown();
+		}
 		ImGui::DestroyContext();
 	};
 
@@ -99,7 +104,17 @@ namespace Aulys
 
 	void ImGuiLayer::begin() {
 		 ImGui_ImplOpenGL3_NewFrame();
-		 ImGui_ImplGlfw_NewFrame();
+		 if (mPlatformBackend) {
+			 ImGui_ImplGlfw_NewFrame();
+		 }
+		 else {
+			 // What the GLFW backend would have filled in. A fixed step, so the UI comes out the
+			 // same every run.
+			 ImGuiIO& io = ImGui::GetIO();
+			 Application& app = Application::get();
+			 io.DisplaySize = ImVec2(app.getWindow().getWidth(), app.getWindow().getHeight());
+			 io.DeltaTime = 1.0f / 60.0f;
+		 }
 		 ImGui::NewFrame();
 	};
 
@@ -26,5 +26,8 @@ namespace Aulys
 		void end();
 	private:
 		float mTime = 0.0f;
+		// False without a GLFW window (a HeadlessWindow), where begin() does the platform backend's
+		// job itself.
+		bool mPlatformBackend = true;
 	}; // class ImGuiLayer : public Layer
 }; // namespace Aulys
@@ -18,6 +18,11 @@ namespace Aulys
 		virtual void onAttach() {};
 		virtual void onDetach() {};
 		virtual void onUpdate(Timestep ts) {};
+		// Called zero or more times per frame, always with the same Timestep (see
+		// Application::runFixedUpdates). Simulation goes here, so that it behaves the same no matter
+		// the frame rate - onUpdate is then left to render, using Application::getFixedAlpha to
+		// interpolate between the last two simulation states.
+		virtual void onFixedUpdate(Timestep ts) {};
 		virtual void onImGuiRender(Timestep ts) {};
 		virtual void onEvent(Event& event) {};
 
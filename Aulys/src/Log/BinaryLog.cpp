@@ -0,0 +1,260 @@
+#include "src/pch.h"
+
+#include "BinaryLog.h"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+#ifdef AU_PLATFORM_LINUX
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace Aulys {
+	std::atomic<uint32_t> BinaryLog::sNextSiteId = 0;
+	std::atomic<bool> BinaryLog::sOpen = false;
+	std::atomic<uint64_t> BinaryLog::sDropped = 0;
+	spdlog::level::level_enum BinaryLog::sLevel = spdlog::level::trace;
+
+	namespace {
+		// Everything about the segment that's currently being written. Only touched with sMutex held.
+		struct Segment {
+			std::string pathPrefix;
+			size_t size = 0;
+			uint32_t maxSegments = 0;
+
+			uint32_t index = 0;
+			uint8_t* data = nullptr;
+			size_t used = 0;
+			std::chrono::steady_clock::time_point start;
+#ifdef AU_PLATFORM_LINUX
+			int fd = -1;
+#else
+			// No mmap - the segment is kept in memory and written out when it's full or on flush.
+			std::vector<uint8_t> memory;
+#endif
+		};
+
+		std::mutex sMutex;
+		Segment sSegment;
+
+		std::string segmentPath(const std::string& prefix, uint32_t index) {
+			return prefix + "." + std::to_string(index) + BinaryLogFormat::Extension;
+		}
+
+		// Writes what we have of the current segment and trims its file to that length.
+		void finishSegment() {
+			if (!sSegment.data) {
+				return;
+			}
+#ifdef AU_PLATFORM_LINUX
+			munmap(sSegment.data, sSegment.size);
+			if (ftruncate(sSegment.fd, (off_t)sSegment.used) != 0) {
+				// Not fatal, the file just keeps its zeroed tail.
+			}
+			::close(sSegment.fd);
+			sSegment.fd = -1;
+#else
+			std::ofstream file(segmentPath(sSegment.pathPrefix, sSegment.index), std::ios::binary | std::ios::trunc);
+			file.write((const char*)sSegment.data, (std::streamsize)sSegment.used);
+			sSegment.memory = {};
+#endif
+			sSegment.data = nullptr;
+			sSegment.used = 0;
+		}
+
+		bool startSegment(uint32_t index) {
+			const std::string path = segmentPath(sSegment.pathPrefix, index);
+#ifdef AU_PLATFORM_LINUX
+			const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (fd < 0) {
+				return false;
+			}
+			if (ftruncate(fd, (off_t)sSegment.size) != 0) {
+				::close(fd);
+				return false;
+			}
+			void* mapped = mmap(nullptr, sSegment.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (mapped == MAP_FAILED) {
+				::close(fd);
+				return false;
+			}
+			sSegment.fd = fd;
+			sSegment.data = (uint8_t*)mapped;
+#else
+			sSegment.memory.assign(sSegment.size, 0);
+			sSegment.data = sSegment.memory.data();
+#endif
+			sSegment.index = index;
+			sSegment.start = std::chrono::steady_clock::now();
+
+			BinaryLogFormat::SegmentHeader header = {};
+			std::memcpy(header.magic, BinaryLogFormat::Magic, sizeof(header.magic));
+			header.version = BinaryLogFormat::Version;
+			header.segment = index;
+			header.wallClockNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+			header.steadyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				sSegment.start.time_since_epoch()).count();
+			std::memcpy(sSegment.data, &header, sizeof(header));
+			sSegment.used = sizeof(header);
+
+			// Keep only the newest maxSegments around, like the rotating text sink does.
+			if (index >= sSegment.maxSegments) {
+				std::error_code ec;
+				std::filesystem::remove(segmentPath(sSegment.pathPrefix, index - sSegment.maxSegments), ec);
+			}
+			return true;
+		}
+
+		// Makes room for `size` bytes in the current segment, moving on to the next one if needed.
+		uint8_t* reserve(size_t size) {
+			if (!sSegment.data) {
+				return nullptr;
+			}
+			if (sSegment.used + size + sizeof(BinaryLogFormat::RecordHeader) > sSegment.size) {
+				// Leave room for the zeroed End record, so readers always find one.
+				const uint32_t next = sSegment.index + 1;
+				finishSegment();
+				if (!startSegment(next) || sSegment.used + size + sizeof(BinaryLogFormat::RecordHeader) > sSegment.size) {
+					return nullptr;
+				}
+			}
+			uint8_t* at = sSegment.data + sSegment.used;
+			sSegment.used += size;
+			return at;
+		}
+
+		uint8_t* writeRecordHeader(uint8_t* at, BinaryLogFormat::Record kind, size_t bodySize) {
+			BinaryLogFormat::RecordHeader header = {};
+			header.kind = (uint8_t)kind;
+			header.size = (uint32_t)bodySize;
+			std::memcpy(at, &header, sizeof(header));
+			return at + sizeof(header);
+		}
+
+		template<class T>
+		uint8_t* writeValue(uint8_t* at, const T& v) {
+			std::memcpy(at, &v, sizeof(T));
+			return at + sizeof(T);
+		}
+
+		size_t stringSize(const char* s) {
+			return sizeof(uint16_t) + std::min<size_t>(std::strlen(s), UINT16_MAX);
+		}
+
+		uint8_t* writeString(uint8_t* at, const char* s, size_t length) {
+			const uint16_t n = (uint16_t)std::min<size_t>(length, UINT16_MAX);
+			at = writeValue(at, n);
+			std::memcpy(at, s, n);
+			return at + n;
+		}
+
+		uint8_t* writeString(uint8_t* at, const char* s) {
+			return writeString(at, s, std::strlen(s));
+		}
+
+		// Flushes the last segment when the program exits.
+		struct CloseOnExit {
+			~CloseOnExit() { BinaryLog::close(); }
+		} sCloseOnExit;
+	};
+
+	void BinaryLog::open(const std::string& pathPrefix, size_t segmentSize, uint32_t maxSegments,
+						 spdlog::level::level_enum level) {
+		AU_CORE_ASSERT(segmentSize > sizeof(BinaryLogFormat::SegmentHeader) + 1024,
+					   "[BinaryLog::open] A segment of {0} bytes is too small to hold anything.", segmentSize);
+		AU_CORE_ASSERT(maxSegments > 0, "[BinaryLog::open] We need to keep at least one segment.");
+		std::lock_guard<std::mutex> lock(sMutex);
+		finishSegment();
+
+		sSegment.pathPrefix = pathPrefix;
+		sSegment.size = segmentSize;
+		sSegment.maxSegments = maxSegments;
+		sLevel = level;
+
+		// Get rid of the segments of the previous run, the decoder would happily mix them in.
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(pathPrefix).parent_path(), ec);
+		for (uint32_t i = 0; std::filesystem::remove(segmentPath(pathPrefix, i), ec); i++) { }
+
+		sOpen = startSegment(0);
+	}
+
+	void BinaryLog::close() {
+		std::lock_guard<std::mutex> lock(sMutex);
+		sOpen = false;
+		finishSegment();
+	}
+
+	void BinaryLog::flush() {
+		std::lock_guard<std::mutex> lock(sMutex);
+		if (!sSegment.data) {
+			return;
+		}
+#ifdef AU_PLATFORM_LINUX
+		msync(sSegment.data, sSegment.used, MS_ASYNC);
+#else
+		std::ofstream file(segmentPath(sSegment.pathPrefix, sSegment.index), std::ios::binary | std::ios::trunc);
+		file.write((const char*)sSegment.data, (std::streamsize)sSegment.used);
+#endif
+	}
+
+	void BinaryLog::commit(Site& site, const char* format, size_t formatLength, bool isLiteral,
+						   const std::vector<uint8_t>& args, size_t argc) {
+		const auto now = std::chrono::steady_clock::now();
+		std::lock_guard<std::mutex> lock(sMutex);
+
+		// The first literal a site sees becomes its format. If that happens after the site was
+		// already written into this segment (without a format), it has to be written again.
+		if (isLiteral && !site.format) {
+			site.format = format;
+			site.definedInSegment = UINT32_MAX;
+		}
+		const bool inlineFormat = !isLiteral || site.format != format;
+
+		const size_t entrySize = sizeof(BinaryLogFormat::RecordHeader) + sizeof(uint32_t) + sizeof(uint64_t)
+			+ sizeof(uint8_t) + (inlineFormat ? sizeof(uint16_t) + std::min<size_t>(formatLength, UINT16_MAX) : 0)
+			+ sizeof(uint8_t) + args.size();
+		const size_t siteSize = sizeof(BinaryLogFormat::RecordHeader) + sizeof(uint32_t) + 2 * sizeof(uint8_t)
+			+ sizeof(uint32_t) + stringSize(site.file) + stringSize(site.baseFile) + stringSize(site.func)
+			+ stringSize(site.prettyFunc) + stringSize(site.format ? site.format : "");
+
+		// Reserve room for the site definition along with the entry, so that if this entry starts a new
+		// segment, the definition goes into that one too.
+		uint8_t* at = reserve(entrySize + siteSize);
+		if (!at) {
+			sDropped++;
+			return;
+		}
+		if (site.definedInSegment != sSegment.index) {
+			at = writeRecordHeader(at, BinaryLogFormat::Record::Site, siteSize - sizeof(BinaryLogFormat::RecordHeader));
+			at = writeValue(at, site.id);
+			at = writeValue(at, (uint8_t)site.level);
+			at = writeValue(at, site.flags);
+			at = writeValue(at, (uint32_t)site.line);
+			at = writeString(at, site.file);
+			at = writeString(at, site.baseFile);
+			at = writeString(at, site.func);
+			at = writeString(at, site.prettyFunc);
+			at = writeString(at, site.format ? site.format : "");
+			site.definedInSegment = sSegment.index;
+		}
+		else {
+			// We reserved room for a site record that isn't needed after all, give it back.
+			sSegment.used -= siteSize;
+		}
+
+		at = writeRecordHeader(at, BinaryLogFormat::Record::Entry, entrySize - sizeof(BinaryLogFormat::RecordHeader));
+		at = writeValue(at, site.id);
+		at = writeValue(at, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - sSegment.start).count());
+		at = writeValue(at, (uint8_t)(inlineFormat ? BinaryLogFormat::EntryFlags::InlineFormat : 0));
+		if (inlineFormat) {
+			at = writeString(at, format, formatLength);
+		}
+		at = writeValue(at, (uint8_t)std::min<size_t>(argc, UINT8_MAX));
+		std::memcpy(at, args.data(), args.size());
+	}
+}; // namespace Aulys
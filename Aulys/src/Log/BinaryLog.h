@@ -0,0 +1,173 @@
+#pragma once
+
+#include "Log/BinaryLogFormat.h"
+
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/ostr.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/* A log sink for long runs where the text log files are too slow and too big. Instead of formatting
+ * messages, every log call writes the id of its call site, a timestamp and the raw bytes of its
+ * arguments into memory mapped segment files. Everything that's the same for every call from one
+ * place (file, line, function, level and the format string itself) is written only once per segment.
+ *
+ * The segments are turned back into text by the aulys-logdecode tool (LogDecode/), which formats
+ * them with the same {FILE}/{FUNC}/{LOGLVL}/... tokens and header format as the text loggers.
+ *
+ * You don't use this directly: define LOGGING_SINK_BINARY in AulysConf.h and the AU_LOG_ and LOG_
+ * macros in Log.h write into it as well. Log::Init opens it.
+ *
+ * Arguments that aren't numbers, chars, bools or strings (e.g. glm types, events) are formatted to a
+ * string when they're logged, so they cost about as much as they do in the text loggers. */
+
+namespace Aulys {
+
+	class BinaryLog
+	{
+	public:
+		// One of these lives in a function-local static at every log statement (see AU_BINARY_LOG__ in
+		// Log.h), which is how call sites get their ids without any lookups.
+		struct Site {
+			Site(bool client, bool oneLine, spdlog::level::level_enum level,
+				 const char* file, const char* baseFile, int line, const char* func, const char* prettyFunc)
+				: id(sNextSiteId++), level(level),
+				  flags((client ? BinaryLogFormat::SiteFlags::Client : 0) | (oneLine ? BinaryLogFormat::SiteFlags::OneLine : 0)),
+				  line(line), file(file), baseFile(baseFile), func(func), prettyFunc(prettyFunc) {};
+
+			const uint32_t id;
+			const spdlog::level::level_enum level;
+			const uint8_t flags;
+			const int line;
+			const char* const file;
+			const char* const baseFile;
+			const char* const func;
+			const char* const prettyFunc;
+
+			// The literal format string seen on the first call - later calls with the same pointer
+			// don't need to write it again. Both are guarded by BinaryLog's mutex.
+			const char* format = nullptr;
+			uint32_t definedInSegment = UINT32_MAX; // The last segment this site's Record::Site went into.
+		};
+
+		// Starts a new run of segments named `pathPrefix`.0.aulb, `pathPrefix`.1.aulb and so on,
+		// removing the ones of a previous run. Only the last maxSegments segments are kept around.
+		static void open(const std::string& pathPrefix, size_t segmentSize, uint32_t maxSegments,
+						 spdlog::level::level_enum level = spdlog::level::trace);
+		// Trims the current segment to the size that's actually in use. Called on exit, too.
+		static void close();
+		static void flush();
+
+		static bool shouldLog(spdlog::level::level_enum level) {
+			return sOpen.load(std::memory_order_relaxed) && level >= sLevel;
+		}
+
+		// A string literal as the format gets written once per segment (in the Site record)...
+		template<size_t N, class... Args>
+		static void write(Site& site, const char (&format)[N], const Args&... args) {
+			std::vector<uint8_t>& buf = scratch();
+			encodeArgs(buf, args...);
+			commit(site, format, N - 1, true, buf, sizeof...(Args));
+		}
+
+		// ...anything else is copied into every entry.
+		template<class... Args>
+		static void write(Site& site, const std::string& format, const Args&... args) {
+			std::vector<uint8_t>& buf = scratch();
+			encodeArgs(buf, args...);
+			commit(site, format.data(), format.size(), false, buf, sizeof...(Args));
+		}
+
+		// How many entries didn't make it into a segment (too big for one, or the file couldn't be
+		// created).
+		static uint64_t droppedCount() { return sDropped.load(std::memory_order_relaxed); }
+
+	private:
+		static void commit(Site& site, const char* format, size_t formatLength, bool isLiteral,
+						   const std::vector<uint8_t>& args, size_t argc);
+
+		// Per-thread buffer the arguments get encoded into before they're copied into the segment
+		// under the lock.
+		static std::vector<uint8_t>& scratch() {
+			thread_local std::vector<uint8_t> buf;
+			buf.clear();
+			return buf;
+		}
+
+		template<class T>
+		static void put(std::vector<uint8_t>& buf, const T& v) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			const size_t at = buf.size();
+			buf.resize(at + sizeof(T));
+			std::memcpy(buf.data() + at, &v, sizeof(T));
+		}
+
+		static void putString(std::vector<uint8_t>& buf, const char* s, size_t length) {
+			const uint16_t n = (uint16_t)std::min<size_t>(length, UINT16_MAX);
+			put(buf, n);
+			buf.insert(buf.end(), s, s + n);
+		}
+
+		template<class T>
+		static void encodeArg(std::vector<uint8_t>& buf, const T& v) {
+			using BinaryLogFormat::Arg;
+			if constexpr (std::is_same_v<T, bool>) {
+				put(buf, Arg::Bool); put(buf, (uint8_t)v);
+			}
+			else if constexpr (std::is_same_v<T, char>) {
+				put(buf, Arg::Char); put(buf, v);
+			}
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+				put(buf, Arg::Int); put(buf, (int64_t)v);
+			}
+			else if constexpr (std::is_integral_v<T>) {
+				put(buf, Arg::UInt); put(buf, (uint64_t)v);
+			}
+			else if constexpr (std::is_same_v<T, float>) {
+				put(buf, Arg::Float); put(buf, v);
+			}
+			else if constexpr (std::is_floating_point_v<T>) {
+				put(buf, Arg::Double); put(buf, (double)v);
+			}
+			else if constexpr (std::is_convertible_v<const T&, const char*>) {
+				const char* s = v;
+				put(buf, Arg::String);
+				s ? putString(buf, s, std::strlen(s)) : putString(buf, "(null)", 6);
+			}
+			else if constexpr (std::is_convertible_v<const T&, fmt::string_view>) {
+				const fmt::string_view s = v;
+				put(buf, Arg::String); putString(buf, s.data(), s.size());
+			}
+			else {
+				const std::string s = fmt::format("{}", v);
+				put(buf, Arg::String); putString(buf, s.data(), s.size());
+			}
+		}
+
+		template<class... Args>
+		static void encodeArgs(std::vector<uint8_t>& buf, const Args&... args) {
+			(encodeArg(buf, args), ...);
+		}
+
+		static std::atomic<uint32_t> sNextSiteId;
+		static std::atomic<bool> sOpen;
+		static std::atomic<uint64_t> sDropped;
+		static spdlog::level::level_enum sLevel;
+	}; // class BinaryLog
+}; // namespace Aulys
+
+// The call site information every Site gets constructed with, see COMMON_LOG_ARGS__ in AulysConf.h.
+#ifdef AU_COMPILER_GCC
+	#define AU_BINARY_SITE_ARGS__ __FILE__, __BASE_FILE__, __LINE__, __FUNCTION__, __PRETTY_FUNCTION__
+#elif AU_COMPILER_MSVC
+	#define AU_BINARY_SITE_ARGS__ __FILE__, "[!!] BASEFILE - IS UNDEFINED ON MSVC", __LINE__, __FUNCTION__,\
+                                  "[!!] PRETTYFUNC - IS UNDEFINED ON MSVC"
+#else
+	#define AU_BINARY_SITE_ARGS__ "FILE", "BASE_FILE", __LINE__, "FUNCTION", "PRETTY_FUNCTION"
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+/* The on-disk layout of the binary log segments written by BinaryLog (see BinaryLog.h) and read back
+ * by aulys-logdecode. It's kept free of any engine includes so the decoder can use it on its own.
+ *
+ * A segment file starts with a SegmentHeader, followed by records. Every record starts with a
+ * RecordHeader, and its size lets a reader skip records it doesn't know. A zeroed RecordHeader (kind
+ * End) marks the end of the data - segments are preallocated with zeroes, so this is also what a
+ * reader finds after a crash.
+ *
+ * All integers are little endian and unaligned.
+ *
+ * Record::Site (one per log statement per segment, written before its first entry in that segment):
+ *     u32 siteId, u8 level (spdlog::level), u8 flags (SiteFlags), u32 line,
+ *     str file, str baseFile, str func, str prettyFunc, str format (empty if not a literal)
+ * Record::Entry (one per log call):
+ *     u32 siteId, u64 nanoseconds since SegmentHeader::steadyNs, u8 flags (EntryFlags),
+ *     [str format, only with EntryFlags::InlineFormat], u8 argc, args...
+ *
+ * Where str is a u16 length followed by that many bytes (no terminator), and every arg is a u8 Arg
+ * tag followed by its payload. */
+
+namespace Aulys {
+namespace BinaryLogFormat {
+
+	constexpr char Magic[4] = { 'A', 'U', 'L', 'B' };
+	constexpr uint32_t Version = 1;
+	constexpr const char* Extension = ".aulb";
+
+	struct SegmentHeader {
+		char magic[4];
+		uint32_t version;
+		uint32_t segment; // Index of the segment within its run, starting at 0.
+		uint32_t reserved;
+		int64_t wallClockNs; // system_clock at the time the segment was opened, in ns since the epoch.
+		int64_t steadyNs; // steady_clock at the same moment, the entries' timestamps are relative to it.
+	};
+	static_assert(sizeof(SegmentHeader) == 32, "SegmentHeader must have no padding.");
+
+	enum class Record : uint8_t {
+		End = 0,
+		Site = 1,
+		Entry = 2,
+	};
+
+	struct RecordHeader {
+		uint8_t kind; // Record
+		uint8_t reserved[3];
+		uint32_t size; // Size of the record body following this header.
+	};
+	static_assert(sizeof(RecordHeader) == 8, "RecordHeader must have no padding.");
+
+	namespace SiteFlags {
+		constexpr uint8_t Client = 1 << 0; // Logged through LOG_* rather than AU_LOG_*.
+		constexpr uint8_t OneLine = 1 << 1; // A *_LINE call, the message goes right after the header.
+	};
+
+	enum class Arg : uint8_t {
+		Int = 0, // i64
+		UInt = 1, // u64
+		Float = 2, // f32
+		Double = 3, // f64
+		Bool = 4, // u8
+		Char = 5, // u8
+		String = 6, // str - also used for anything that's formatted through operator<<.
+	};
+
+	// Entries carry their own format string when it isn't a literal (e.g. LOG_TRACE(ss.str())).
+	namespace EntryFlags {
+		constexpr uint8_t InlineFormat = 1 << 0;
+	};
+
+}; // namespace BinaryLogFormat
+}; // namespace Aulys
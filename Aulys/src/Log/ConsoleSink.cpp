@@ -4,23 +4,31 @@
 
 namespace Aulys {
 	ConsoleSink& ConsoleSink::operator<<(const char* msg) {
-		auto lastline = (lines.size() != 0 && lines.back().message.length() != 0) ? lines.back() : LogItem("\n", spdlog::level::info, false);
-		if (lastline.isRaw) {
-			lines.back() = LogItem(lastline.message + msg, spdlog::level::info, true);
-		} 
-		else {
-			lines.push_back(LogItem(msg, spdlog::level::info, true));
-		}
-		return *this;
+		return *this << std::string(msg);
 	}
 
 	ConsoleSink& ConsoleSink::operator<<(const std::string& msg) {
-		auto lastline = (lines.size() != 0 && lines.back().message.length() != 0) ? lines.back() : LogItem("\n", spdlog::level::info, false);
-		if (lastline.isRaw) {
-			lines.back() = LogItem(lastline.message + msg, spdlog::level::info, true);
-		} 
-		else {
-			lines.push_back(LogItem(msg, spdlog::level::info, true));
+		// Raw text keeps getting appended to the current raw line until a '\n' closes it, so that
+		// e.g. `*sink << "a" << 1 << "\n"` ends up as one line. Every '\n' starts a new line, which
+		// keeps one item == one row for the clipper in draw().
+		size_t start = 0;
+		while (true) {
+			const size_t end = msg.find('\n', start);
+			std::string segment = msg.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+			if (mRawLineOpen) {
+				line(mNextLine - 1).message += segment;
+			}
+			else if (!segment.empty() || end != std::string::npos) {
+				pushLine(LogItem(segment, spdlog::level::info, true));
+			}
+
+			if (end == std::string::npos) {
+				mRawLineOpen = mRawLineOpen || !segment.empty();
+				break;
+			}
+			mRawLineOpen = false;
+			start = end + 1;
 		}
 		return *this;
 	}
@@ -29,12 +37,42 @@ namespace Aulys {
 		std::stringstream ss(msg.message);
 		std::string buf;
 		while(getline(ss, buf, '\n')) {
-			lines.push_back(LogItem(buf, msg.lvl, msg.isRaw, msg.isCommand));
+			pushLine(LogItem(buf, msg.lvl, msg.isRaw, msg.isCommand));
 		}
+		mRawLineOpen = false;
 		return *this;
 	}
 
-	ConsoleSink::ConsoleSink(const std::string& windowName) : mWindowName(windowName) {
+	void ConsoleSink::pushLine(LogItem&& item) {
+		if (mLines.size() < mCapacity) {
+			mLines.push_back(std::move(item));
+		}
+		else {
+			// Full - the slot we're about to write holds the oldest line, so drop it from the filters.
+			// Each filter's index array is sorted, so the evicted line can only ever be at the front.
+			const uint64_t evicted = mNextLine - mCapacity;
+			for (auto& visible : mVisible) {
+				if (!visible.empty() && visible.front() == evicted) {
+					visible.pop_front();
+				}
+			}
+			line(mNextLine) = std::move(item);
+		}
+
+		const LogItem& pushed = line(mNextLine);
+		for (size_t i = 0; i < sFilterLevels.size(); i++) {
+			if (pushed.isRaw || pushed.isCommand || pushed.lvl >= sFilterLevels[i]) {
+				mVisible[i].push_back(mNextLine);
+			}
+		}
+		mNextLine++;
+	}
+
+	ConsoleSink::ConsoleSink(const std::string& windowName, size_t capacity)
+		: mCapacity(capacity), mWindowName(windowName) {
+		AU_CORE_ASSERT(mCapacity > 0, "[ConsoleSink::ConsoleSink] The capacity has to be at least one line.");
+		mLines.reserve(mCapacity);
+
 		this->commands.push_back(
 			CommandItem( "help", [this](std::vector<std::string> argv, ConsoleSink* sink) -> uint32_t {
 				*sink << "Welcome to the Aulys Engine!\n" << "This is the help menu for the in-engine ConsoleSink command utility.\n"
@@ -66,11 +104,19 @@ namespace Aulys {
 			ImGui::GetStyle().ItemSpacing.y + ImGui::GetFrameHeightWithSpacing(); // 1 separator, 1 input text
 
 		ImGui::BeginChild("ScrollingRegion", { 0, -height }, false, ImGuiWindowFlags_HorizontalScrollbar);
-			for (int i = 0; i < lines.size(); i++) {
-				if (lines[i].isRaw) { ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(LOG_CONSOLE_RAWCOLOR)); ImGui::TextUnformatted(lines[i].message.c_str()); ImGui::PopStyleColor(); continue; }
-				if (lines[i].isCommand) { ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(LOG_CONSOLE_COMMANDCOLOR)); ImGui::TextUnformatted(lines[i].message.c_str()); ImGui::PopStyleColor(); continue; }
-				if (this->level() <= lines[i].lvl) { ImGui::TextUnformatted(lines[i].message.c_str()); }
+			// Only the rows that are actually on screen get submitted to ImGui.
+			const auto& visible = mVisible[mFilter];
+			ImGuiListClipper clipper;
+			clipper.Begin((int)visible.size());
+			while (clipper.Step()) {
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+					const LogItem& item = line(visible[i]);
+					if (item.isRaw) { ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(LOG_CONSOLE_RAWCOLOR)); ImGui::TextUnformatted(item.message.c_str()); ImGui::PopStyleColor(); continue; }
+					if (item.isCommand) { ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(LOG_CONSOLE_COMMANDCOLOR)); ImGui::TextUnformatted(item.message.c_str()); ImGui::PopStyleColor(); continue; }
+					ImGui::TextUnformatted(item.message.c_str());
+				}
 			}
+			clipper.End();
 
 			if (scrollToBottom || (autoScroll && (ImGui::GetScrollY() <= ImGui::GetScrollMaxY())) ) {
 				ImGui::SetScrollHereY(1.0f);
@@ -111,36 +157,36 @@ namespace Aulys {
 
 		ImGui::SameLine();
 
-		if (this->level() == spdlog::level::trace) {
-			if (ImGui::Button("Trace")) { this->set_level(spdlog::level::trace); }
+		if (mFilter == 0) {
+			if (ImGui::Button("Trace")) { mFilter = 0; }
 		}
 		else {
-			if (ImGui::SmallButton("Trace")) { this->set_level(spdlog::level::trace); }
+			if (ImGui::SmallButton("Trace")) { mFilter = 0; }
 		}
 		ImGui::SameLine();
 
-		if (this->level() == spdlog::level::info) {
-			if (ImGui::Button("Info")) { this->set_level(spdlog::level::info); }
+		if (mFilter == 1) {
+			if (ImGui::Button("Info")) { mFilter = 1; }
 		}
 		else {
-			if (ImGui::SmallButton("Info")) { this->set_level(spdlog::level::info); }
+			if (ImGui::SmallButton("Info")) { mFilter = 1; }
 		}
 		ImGui::SameLine();
 
-		if (this->level() == spdlog::level::warn) {
-			if (ImGui::Button("Warn")) { this->set_level(spdlog::level::warn); }
+		if (mFilter == 2) {
+			if (ImGui::Button("Warn")) { mFilter = 2; }
 		}
 
 		else {
-			if (ImGui::SmallButton("Warn")) { this->set_level(spdlog::level::warn); }
+			if (ImGui::SmallButton("Warn")) { mFilter = 2; }
 		}
 		ImGui::SameLine();
 
-		if (this->level() == spdlog::level::err) {
-			if (ImGui::Button("Error")) { this->set_level(spdlog::level::err); }
+		if (mFilter == 3) {
+			if (ImGui::Button("Error")) { mFilter = 3; }
 		}
 		else {
-			if (ImGui::SmallButton("Error")) { this->set_level(spdlog::level::err); }
+			if (ImGui::SmallButton("Error")) { mFilter = 3; }
 		}
 		ImGui::SameLine();
 
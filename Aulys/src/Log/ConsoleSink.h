@@ -4,8 +4,12 @@
 
 #include "imgui.h"
 
+#include <array>
+#include <deque>
+
 #define LOG_CONSOLE_RAWCOLOR 0.8f, 0.6f, 0.6f, 1.0f
 #define LOG_CONSOLE_COMMANDCOLOR 0.4f, 0.9f, 0.4f, 1.0f
+#define LOG_CONSOLE_DEFAULT_CAPACITY 16384 // How many lines the console keeps before dropping the oldest.
 
 namespace Aulys {
 	struct LogItem {
@@ -36,7 +40,7 @@ namespace Aulys {
 
 		ConsoleSink& operator<<(const LogItem& msg);
 
-		ConsoleSink(const std::string& windowName = "ConsoleSink");
+		ConsoleSink(const std::string& windowName = "ConsoleSink", size_t capacity = LOG_CONSOLE_DEFAULT_CAPACITY);
 
 		void draw();
 
@@ -49,16 +53,40 @@ namespace Aulys {
 
 		int textEditCallback(ImGuiInputTextCallbackData* data);
 
+		size_t capacity() const { return mCapacity; }
+		size_t size() const { return mLines.size(); }
+
 	protected:
 		void sink_it_(const spdlog::details::log_msg& msg) override;
 
 		void flush_() override { };
 
 	private:
+		// Appends a line to the ring buffer, overwriting the oldest one once we're at capacity, and
+		// keeps the per-filter index arrays below in sync.
+		void pushLine(LogItem&& item);
+		// Lines are addressed by their absolute number (how many lines were pushed before them), the
+		// slot in mLines is just that modulo the capacity.
+		LogItem& line(uint64_t number) { return mLines[number % mCapacity]; }
+
+		// The levels the filter buttons select. A line is shown under a filter if it's at least at that
+		// level, or if it's raw text/a command echo.
+		static constexpr std::array<spdlog::level::level_enum, 4> sFilterLevels = {
+			spdlog::level::trace, spdlog::level::info, spdlog::level::warn, spdlog::level::err };
+
 		char inputBuf[256] = "";
 		std::vector<std::string> history;
 		int historyIndex = -1;
-		std::vector<LogItem> lines;
+
+		size_t mCapacity;
+		std::vector<LogItem> mLines; // Ring buffer of at most mCapacity lines.
+		uint64_t mNextLine = 0; // Absolute number of the next line to be pushed.
+		bool mRawLineOpen = false; // Does raw text get appended to the last line (no '\n' seen yet)?
+		// For every filter level, the absolute numbers of the lines it shows, oldest first. Updated on
+		// every push and eviction, so switching filters or drawing never has to scan the whole buffer.
+		std::array<std::deque<uint64_t>, sFilterLevels.size()> mVisible;
+		size_t mFilter = 0; // Index into sFilterLevels.
+
 		bool autoScroll = true;
 		bool scrollToBottom = false;
 		std::string mWindowName;
@@ -48,15 +48,87 @@
  *         return os << "A string of your making!";
  *     } */
 
+// Every macro below is guarded twice:
+// - At compile time by AU_LOG_ACTIVE_LEVEL (AulysConf.h). Levels below it expand to
+//   AU_LOG_STRIPPED__, which is never executed and gets removed by the optimiser, so neither the
+//   arguments nor the format strings survive into e.g. Dist builds. The arguments are still
+//   type-checked, so a stripped call can't rot.
+// - At runtime by AU_LOG_IF__, which asks the logset whether anything would be logged at this level
+//   before touching the arguments. This means e.g. `LT("{0}", someMatrix)` doesn't stream the matrix
+//   through operator<< (or indent anything) if the trace level is switched off.
+// They're all wrapped in do { } while(0), so they behave like a single statement.
+#define AU_LOG_IF__(logset, lvl, ...)\
+                    do { if (::Aulys::Log::shouldLog(logset, spdlog::level::lvl)) { __VA_ARGS__; } } while (0)
+#define AU_LOG_STRIPPED__(...)      do { if (false) { __VA_ARGS__; } } while (0)
+
+// With LOGGING_SINK_BINARY, every call also goes into the binary log (see Log/BinaryLog.h). Each call
+// site gets its own static BinaryLog::Site the first time it's hit - it lives in a lambda because we
+// also log from constexpr functions, which can't have statics of their own. Note that the arguments
+// are evaluated once for the binary log and once more for the text loggers, if those want the message.
+#ifdef LOGGING_SINK_BINARY
+	#define AU_BINARY_LOG__(client, oneLine, lvl, ...)\
+                    if (::Aulys::BinaryLog::shouldLog(spdlog::level::lvl)) {\
+                        ::Aulys::BinaryLog::write(\
+                            [](const auto&... siteArgs) -> ::Aulys::BinaryLog::Site& {\
+                                static ::Aulys::BinaryLog::Site site(siteArgs...); return site; }\
+                            (client, oneLine, spdlog::level::lvl, AU_BINARY_SITE_ARGS__), __VA_ARGS__);\
+                    }
+#else
+	#define AU_BINARY_LOG__(client, oneLine, lvl, ...)
+#endif
+
+#define AU_CORE_LOG_IF__(lvl, ...)  AU_LOG_IF__(::Aulys::Log::mCoreLogset, lvl, __VA_ARGS__)
+#define AU_CLIENT_LOG_IF__(lvl, ...) AU_LOG_IF__(::Aulys::Log::mClientLogset, lvl, __VA_ARGS__)
+
+#if AU_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+	#define AU_CORE_TRACE_IF__(...)     AU_CORE_LOG_IF__(trace, __VA_ARGS__)
+	#define AU_CLIENT_TRACE_IF__(...)   AU_CLIENT_LOG_IF__(trace, __VA_ARGS__)
+#else
+	#define AU_CORE_TRACE_IF__(...)     AU_LOG_STRIPPED__(__VA_ARGS__)
+	#define AU_CLIENT_TRACE_IF__(...)   AU_LOG_STRIPPED__(__VA_ARGS__)
+#endif
+
+#if AU_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+	#define AU_CORE_INFO_IF__(...)      AU_CORE_LOG_IF__(info, __VA_ARGS__)
+	#define AU_CLIENT_INFO_IF__(...)    AU_CLIENT_LOG_IF__(info, __VA_ARGS__)
+#else
+	#define AU_CORE_INFO_IF__(...)      AU_LOG_STRIPPED__(__VA_ARGS__)
+	#define AU_CLIENT_INFO_IF__(...)    AU_LOG_STRIPPED__(__VA_ARGS__)
+#endif
+
+#if AU_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+	#define AU_CORE_WARN_IF__(...)      AU_CORE_LOG_IF__(warn, __VA_ARGS__)
+	#define AU_CLIENT_WARN_IF__(...)    AU_CLIENT_LOG_IF__(warn, __VA_ARGS__)
+#else
+	#define AU_CORE_WARN_IF__(...)      AU_LOG_STRIPPED__(__VA_ARGS__)
+	#define AU_CLIENT_WARN_IF__(...)    AU_LOG_STRIPPED__(__VA_ARGS__)
+#endif
+
+#if AU_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+	#define AU_CORE_ERROR_IF__(...)     AU_CORE_LOG_IF__(err, __VA_ARGS__)
+	#define AU_CLIENT_ERROR_IF__(...)   AU_CLIENT_LOG_IF__(err, __VA_ARGS__)
+#else
+	#define AU_CORE_ERROR_IF__(...)     AU_LOG_STRIPPED__(__VA_ARGS__)
+	#define AU_CLIENT_ERROR_IF__(...)   AU_LOG_STRIPPED__(__VA_ARGS__)
+#endif
+
 // Core log macros
-#define AU_LOG_TRACE(...)           AU_HEADER_TRACE__("", COMMON_LOG_ARGS__("Trace"));\
-                                    AU_LOG_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace"))
-#define AU_LOG_INFO(...)            AU_HEADER_INFO__("", COMMON_LOG_ARGS__("Info"));\
-                                    AU_LOG_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Info"))
-#define AU_LOG_WARN(...)            AU_HEADER_WARN__("", COMMON_LOG_ARGS__("Warn"));\
-                                    AU_LOG_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Warn"))
-#define AU_LOG_ERROR(...)           AU_HEADER_ERROR__("", COMMON_LOG_ARGS__("Error"));\
-                                    AU_LOG_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Error"))
+#define AU_LOG_TRACE(...)           AU_CORE_TRACE_IF__(\
+                                    AU_BINARY_LOG__(false, false, trace, __VA_ARGS__);\
+                                    AU_HEADER_TRACE__("", COMMON_LOG_ARGS__("Trace"));\
+                                    AU_LOG_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace")))
+#define AU_LOG_INFO(...)            AU_CORE_INFO_IF__(\
+                                    AU_BINARY_LOG__(false, false, info, __VA_ARGS__);\
+                                    AU_HEADER_INFO__("", COMMON_LOG_ARGS__("Info"));\
+                                    AU_LOG_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Info")))
+#define AU_LOG_WARN(...)            AU_CORE_WARN_IF__(\
+                                    AU_BINARY_LOG__(false, false, warn, __VA_ARGS__);\
+                                    AU_HEADER_WARN__("", COMMON_LOG_ARGS__("Warn"));\
+                                    AU_LOG_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Warn")))
+#define AU_LOG_ERROR(...)           AU_CORE_ERROR_IF__(\
+                                    AU_BINARY_LOG__(false, false, err, __VA_ARGS__);\
+                                    AU_HEADER_ERROR__("", COMMON_LOG_ARGS__("Error"));\
+                                    AU_LOG_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Error")))
 
 #define ALOGT(...)                  AU_LOG_TRACE(__VA_ARGS__)
 #define ALOGI(...)                  AU_LOG_INFO(__VA_ARGS__)
@@ -68,10 +140,18 @@
 #define ALW(...)                    AU_LOG_WARN(__VA_ARGS__)
 #define ALE(...)                    AU_LOG_ERROR(__VA_ARGS__)
 
-#define AU_LOG_TRACE_LINE(...)      AU_HEADER_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace"))
-#define AU_LOG_INFO_LINE(...)       AU_HEADER_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace"))
-#define AU_LOG_WARN_LINE(...)       AU_HEADER_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace"))
-#define AU_LOG_ERROR_LINE(...)      AU_HEADER_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace"))
+#define AU_LOG_TRACE_LINE(...)      AU_CORE_TRACE_IF__(\
+                                    AU_BINARY_LOG__(false, true, trace, __VA_ARGS__);\
+                                    AU_HEADER_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace")))
+#define AU_LOG_INFO_LINE(...)       AU_CORE_INFO_IF__(\
+                                    AU_BINARY_LOG__(false, true, info, __VA_ARGS__);\
+                                    AU_HEADER_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace")))
+#define AU_LOG_WARN_LINE(...)       AU_CORE_WARN_IF__(\
+                                    AU_BINARY_LOG__(false, true, warn, __VA_ARGS__);\
+                                    AU_HEADER_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace")))
+#define AU_LOG_ERROR_LINE(...)      AU_CORE_ERROR_IF__(\
+                                    AU_BINARY_LOG__(false, true, err, __VA_ARGS__);\
+                                    AU_HEADER_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace")))
 
 #define ALOGTL(...)                 AU_LOG_TRACE_LINE(__VA_ARGS__);
 #define ALOGIL(...)                 AU_LOG_INFO_LINE(__VA_ARGS__);
@@ -85,14 +165,22 @@
 
 // Client log macros
 
-#define LOG_TRACE(...)              HEADER_TRACE__("", COMMON_LOG_ARGS__("Trace"));\
-                                    LOG_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace"))
-#define LOG_INFO(...)               HEADER_INFO__("", COMMON_LOG_ARGS__("Info"));\
-                                    LOG_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Info"))
-#define LOG_WARN(...)               HEADER_WARN__("", COMMON_LOG_ARGS__("Warn"));\
-                                    LOG_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Warn"))
-#define LOG_ERROR(...)              HEADER_ERROR__("", COMMON_LOG_ARGS__("Error"));\
-                                    LOG_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Error"))
+#define LOG_TRACE(...)              AU_CLIENT_TRACE_IF__(\
+                                    AU_BINARY_LOG__(true, false, trace, __VA_ARGS__);\
+                                    HEADER_TRACE__("", COMMON_LOG_ARGS__("Trace"));\
+                                    LOG_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace")))
+#define LOG_INFO(...)               AU_CLIENT_INFO_IF__(\
+                                    AU_BINARY_LOG__(true, false, info, __VA_ARGS__);\
+                                    HEADER_INFO__("", COMMON_LOG_ARGS__("Info"));\
+                                    LOG_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Info")))
+#define LOG_WARN(...)               AU_CLIENT_WARN_IF__(\
+                                    AU_BINARY_LOG__(true, false, warn, __VA_ARGS__);\
+                                    HEADER_WARN__("", COMMON_LOG_ARGS__("Warn"));\
+                                    LOG_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Warn")))
+#define LOG_ERROR(...)              AU_CLIENT_ERROR_IF__(\
+                                    AU_BINARY_LOG__(true, false, err, __VA_ARGS__);\
+                                    HEADER_ERROR__("", COMMON_LOG_ARGS__("Error"));\
+                                    LOG_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Error")))
 
 #define LOGT(...)                   LOG_TRACE(__VA_ARGS__)
 #define LOGI(...)                   LOG_INFO(__VA_ARGS__)
@@ -104,10 +192,18 @@
 #define LW(...)                     LOG_WARN(__VA_ARGS__)
 #define LE(...)                     LOG_ERROR(__VA_ARGS__)
 
-#define LOG_TRACE_LINE(...)         HEADER_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace"))
-#define LOG_INFO_LINE(...)          HEADER_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Info"))
-#define LOG_WARN_LINE(...)          HEADER_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Warn"))
-#define LOG_ERROR_LINE(...)         HEADER_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Error"))
+#define LOG_TRACE_LINE(...)         AU_CLIENT_TRACE_IF__(\
+                                    AU_BINARY_LOG__(true, true, trace, __VA_ARGS__);\
+                                    HEADER_TRACE__(__VA_ARGS__, COMMON_LOG_ARGS__("Trace")))
+#define LOG_INFO_LINE(...)          AU_CLIENT_INFO_IF__(\
+                                    AU_BINARY_LOG__(true, true, info, __VA_ARGS__);\
+                                    HEADER_INFO__(__VA_ARGS__, COMMON_LOG_ARGS__("Info")))
+#define LOG_WARN_LINE(...)          AU_CLIENT_WARN_IF__(\
+                                    AU_BINARY_LOG__(true, true, warn, __VA_ARGS__);\
+                                    HEADER_WARN__(__VA_ARGS__, COMMON_LOG_ARGS__("Warn")))
+#define LOG_ERROR_LINE(...)         AU_CLIENT_ERROR_IF__(\
+                                    AU_BINARY_LOG__(true, true, err, __VA_ARGS__);\
+                                    HEADER_ERROR__(__VA_ARGS__, COMMON_LOG_ARGS__("Error")))
 
 #define LOGTL(...)                  LOG_TRACE_LINE(__VA_ARGS__);
 #define LOGIL(...)                  LOG_INFO_LINE(__VA_ARGS__);
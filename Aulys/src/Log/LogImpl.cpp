@@ -15,29 +15,59 @@ namespace Aulys
 	{
 		spdlog::flush_every(std::chrono::seconds(5));
 
+		// Nothing below AU_LOG_ACTIVE_LEVEL gets compiled in anyway, so let the loggers' runtime level
+		// agree with it - that way shouldLog() also rejects them early.
+		const auto activeLevel = static_cast<spdlog::level::level_enum>(AU_LOG_ACTIVE_LEVEL);
+
+#if defined(LOGGING_CORE_SINK_FILE_ROTATE) || defined(LOGGING_CLIENT_SINK_FILE_ROTATE)
 		auto filemtSinkLogger = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
 			Path("logs/log.txt").get(), 1048576 * 5, 3);
-		filemtSinkLogger->set_level(spdlog::level::trace);
+		filemtSinkLogger->set_level(activeLevel);
+#endif
+
+		// Without a text file to write to, the loggers only need what the console shows - anything
+		// below that is left to the binary log (if there is one) and never gets formatted.
+#ifdef LOGGING_CLIENT_SINK_FILE_ROTATE
+		const auto clientLevel = activeLevel;
+#else
+		const auto clientLevel = std::max(activeLevel, spdlog::level::info);
+#endif
+#ifdef LOGGING_CORE_SINK_FILE_ROTATE
+		const auto coreLevel = activeLevel;
+#else
+		const auto coreLevel = std::max(activeLevel, spdlog::level::info);
+#endif
 
-		Log::mClientLogset->logger->set_level(spdlog::level::trace);
+		Log::mClientLogset->logger->set_level(clientLevel);
 		Log::mClientLogset->logger->set_pattern(LOGGING_CLIENT_LOGGER_PATTERN);
 		Log::mClientLogset->logger->sinks()[0]->set_level(spdlog::level::info);
-		Log::mClientLogset->logger->sinks().push_back(filemtSinkLogger);
 
-		Log::mClientLogset->header->set_level(spdlog::level::trace);
+		Log::mClientLogset->header->set_level(clientLevel);
 		Log::mClientLogset->header->set_pattern(LOGGING_CLIENT_HEADER_PATTERN);
 		Log::mClientLogset->header->sinks()[0]->set_level(spdlog::level::info);
+
+#ifdef LOGGING_CLIENT_SINK_FILE_ROTATE
+		Log::mClientLogset->logger->sinks().push_back(filemtSinkLogger);
 		Log::mClientLogset->header->sinks().push_back(filemtSinkLogger);
+#endif
 
-		Log::mCoreLogset->header->set_level(spdlog::level::trace);
+		Log::mCoreLogset->header->set_level(coreLevel);
 		Log::mCoreLogset->header->set_pattern(LOGGING_CORE_HEADER_PATTERN);
 		Log::mCoreLogset->header->sinks()[0]->set_level(spdlog::level::info);
-		Log::mCoreLogset->header->sinks().push_back(filemtSinkLogger);
 
-		Log::mCoreLogset->logger->set_level(spdlog::level::trace);
+		Log::mCoreLogset->logger->set_level(coreLevel);
 		Log::mCoreLogset->logger->set_pattern(LOGGING_CORE_LOGGER_PATTERN);
 		Log::mCoreLogset->logger->sinks()[0]->set_level(spdlog::level::info);
+
+#ifdef LOGGING_CORE_SINK_FILE_ROTATE
+		Log::mCoreLogset->header->sinks().push_back(filemtSinkLogger);
 		Log::mCoreLogset->logger->sinks().push_back(filemtSinkLogger);
+#endif
+
+#ifdef LOGGING_SINK_BINARY
+		BinaryLog::open(Path(LOGGING_BINARY_PATH).get(), LOGGING_BINARY_SEGMENT_SIZE,
+						LOGGING_BINARY_MAX_SEGMENTS, activeLevel);
+#endif
 	};
 
 	std::string Log::indent(const std::string& msg) {
@@ -68,5 +98,8 @@ namespace Aulys
 		mClientLogset->logger->flush();
 		mCoreLogset->header->flush();
 		mCoreLogset->logger->flush();
+#ifdef LOGGING_SINK_BINARY
+		BinaryLog::flush();
+#endif
 	};
 }; // namespace Aulys
@@ -3,6 +3,7 @@
 #include "pch.h"
 
 #include "Core/Core.h"
+#include "Log/BinaryLog.h"
 
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
@@ -35,6 +36,17 @@ namespace Aulys {
 
 		static void flush();
 
+		// True if either logger of the set (or the binary log) would actually output something at this
+		// level. The macros in Log.h check this before evaluating any of their arguments, so a disabled
+		// trace call costs one branch.
+		static bool shouldLog(const std::shared_ptr<Logset>& logset, spdlog::level::level_enum lvl) {
+			return logset->header->should_log(lvl) || logset->logger->should_log(lvl)
+#ifdef LOGGING_SINK_BINARY
+				|| BinaryLog::shouldLog(lvl)
+#endif
+				;
+		}
+
 		static std::shared_ptr<Logset> mClientLogset;
 		static std::shared_ptr<Logset> mCoreLogset;
 	};
@@ -42,18 +54,6 @@ namespace Aulys {
 /*** Common formatters ***/
 /**************************************************************************************************/
 
-	inline std::ostream& operator<<(std::ostream& os, const glm::vec2& v) {
-		return os << "{" << v.x << ", " << v.y << "}";
-	}
-
-	inline std::ostream& operator<<(std::ostream& os, const glm::vec3& v) {
-		return os << "{" << v.x << ", " << v.y << ", " << v.z << "}";
-	}
-
-	inline std::ostream& operator<<(std::ostream& os, const glm::vec4& v) {
-		return os << "{" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << "}";
-	}
-
 	inline std::string print(const glm::mat4& m) {
 		std::stringstream ss;
 		ss << "["
@@ -77,46 +77,69 @@ namespace Aulys {
 		return ss.str();
 	}
 
-	inline std::ostream& operator<<(std::ostream& os, const glm::mat4& m) {
+}; // namespace Aulys
 
-		return os << print(m);
+// The stream operators live in glm's namespace, because fmt finds them through ADL when it formats
+// log arguments (for std::array<glm::...> glm is an associated namespace as well).
+namespace glm {
+
+	inline std::ostream& operator<<(std::ostream& os, const glm::vec2& v) {
+		return os << "{" << v.x << ", " << v.y << "}";
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, const glm::vec3& v) {
+		return os << "{" << v.x << ", " << v.y << ", " << v.z << "}";
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, const glm::vec4& v) {
+		return os << "{" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << "}";
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, const glm::mat4& m) {
+		return os << ::Aulys::print(m);
 	}
 
 	inline std::ostream& operator<<(std::ostream& os, const std::array<glm::mat4, 6>& m) {
+		using ::Aulys::print;
 		return os << "{" << print(m[0]) << ",\n" << print(m[1]) << ",\n"
 			<< print(m[2]) << ",\n" << print(m[3]) << ",\n"
 			<< print(m[4]) << ",\n" << print(m[5]) << "}";
 	}
 
 	inline std::ostream& operator<<(std::ostream& os, const std::array<glm::mat4, 4>& m) {
+		using ::Aulys::print;
 		return os << "{" << print(m[0]) << ",\n" << print(m[1]) << ",\n"
 			<< print(m[2]) << ",\n" << print(m[3]) << "}";
 	}
 
-
 	inline std::ostream& operator<<(std::ostream& os, const std::array<glm::vec4, 3>& m) {
+		using ::Aulys::print;
 		return os << "{" << print(m[0]) << ",\n" << print(m[1]) << ",\n" << print(m[2]) << "}";
 	}
 
 	inline std::ostream& operator<<(std::ostream& os, const std::array<glm::vec4, 4>& m) {
+		using ::Aulys::print;
 		return os << "{" << print(m[0]) << ",\n" << print(m[1]) << ",\n" << print(m[2]) << ",\n"
 			<< print(m[3]) << "}";
 	}
 
 	inline std::ostream& operator<<(std::ostream& os, const std::array<glm::vec4, 5>& m) {
+		using ::Aulys::print;
 		return os << "{" << print(m[0]) << ",\n" << print(m[1]) << ",\n" << print(m[2]) << ",\n"
 			<< print(m[3]) << ",\n" << print(m[4]) << "}";
 	}
 
 	inline std::ostream& operator<<(std::ostream& os, const std::array<glm::vec3, 4>& m) {
+		using ::Aulys::print;
 		return os << "{" << print(m[0]) << ",\n" << print(m[1]) << ",\n" << print(m[2]) << ",\n"
 			<< print(m[3]) << "}";
-	};
+	}
 
-};
+}; // namespace glm
 
 template<class... Args>
-inline void AU_HEADER_TRACE__(const std::string& msg, Args... args) {
+inline void AU_HEADER_TRACE__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mCoreLogset->header->should_log(spdlog::level::trace)) { return; }
 	std::stringstream ss; // Create the input string.
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
 	// Then call trace with the log args.
@@ -127,7 +150,8 @@ inline void AU_HEADER_TRACE__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void AU_LOG_TRACE__(const std::string& msg, Args... args) {
+inline void AU_LOG_TRACE__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mCoreLogset->logger->should_log(spdlog::level::trace)) { return; }
 	::Aulys::Log::mCoreLogset->logger->trace(
 		::Aulys::Log::indent(msg),
 		args...
@@ -135,7 +159,8 @@ inline void AU_LOG_TRACE__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void AU_HEADER_INFO__(const std::string& msg, Args... args) {
+inline void AU_HEADER_INFO__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mCoreLogset->header->should_log(spdlog::level::info)) { return; }
 	std::stringstream ss; // Create the input string.
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
 	// Then call INFO with the log args.
@@ -146,7 +171,8 @@ inline void AU_HEADER_INFO__(const std::string& msg, Args... args) {
 }
 
 template<class... Args> 
-inline void AU_LOG_INFO__(const std::string& msg, Args... args) {
+inline void AU_LOG_INFO__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mCoreLogset->logger->should_log(spdlog::level::info)) { return; }
 	::Aulys::Log::mCoreLogset->logger->info(
 		::Aulys::Log::indent(msg),
 		args...
@@ -154,7 +180,8 @@ inline void AU_LOG_INFO__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void AU_HEADER_WARN__(const std::string& msg, Args... args) {
+inline void AU_HEADER_WARN__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mCoreLogset->header->should_log(spdlog::level::warn)) { return; }
 	std::stringstream ss; // Create the input string.
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
 	// Then call warn with the log args.
@@ -165,7 +192,8 @@ inline void AU_HEADER_WARN__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void AU_LOG_WARN__(const std::string& msg, Args... args) { 
+inline void AU_LOG_WARN__(const std::string& msg, const Args&... args) { 
+	if (!::Aulys::Log::mCoreLogset->logger->should_log(spdlog::level::warn)) { return; }
 	::Aulys::Log::mCoreLogset->logger->warn(
 		::Aulys::Log::indent(msg),
 		args...
@@ -173,7 +201,8 @@ inline void AU_LOG_WARN__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void AU_HEADER_ERROR__(const std::string& msg, Args... args) {
+inline void AU_HEADER_ERROR__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mCoreLogset->header->should_log(spdlog::level::err)) { return; }
 	std::stringstream ss; // Create the input string.
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
 	// Then call error with the log args.
@@ -184,7 +213,8 @@ inline void AU_HEADER_ERROR__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void AU_LOG_ERROR__(const std::string& msg, Args... args) {
+inline void AU_LOG_ERROR__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mCoreLogset->logger->should_log(spdlog::level::err)) { return; }
 	::Aulys::Log::mCoreLogset->logger->error(
 		::Aulys::Log::indent(msg),
 		args...
@@ -194,7 +224,8 @@ inline void AU_LOG_ERROR__(const std::string& msg, Args... args) {
 
 // Aulys logs
 template<class... Args>
-inline void HEADER_TRACE__(const std::string& msg, Args... args) {
+inline void HEADER_TRACE__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->header->should_log(spdlog::level::trace)) { return; }
 	std::stringstream ss; // Create the input string.
 
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
@@ -206,7 +237,8 @@ inline void HEADER_TRACE__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void LOG_TRACE__(const std::string& msg, Args... args) {
+inline void LOG_TRACE__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->logger->should_log(spdlog::level::trace)) { return; }
 	::Aulys::Log::mClientLogset->logger->trace(
 		::Aulys::Log::indent(msg),
 		args...
@@ -214,7 +246,8 @@ inline void LOG_TRACE__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void HEADER_INFO__(const std::string& msg, Args... args) {
+inline void HEADER_INFO__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->header->should_log(spdlog::level::info)) { return; }
 	std::stringstream ss; // Create the input string.
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
 	// Then call INFO with the log args.
@@ -225,7 +258,8 @@ inline void HEADER_INFO__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void LOG_INFO__(const std::string& msg, Args... args) {
+inline void LOG_INFO__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->logger->should_log(spdlog::level::info)) { return; }
 	::Aulys::Log::mClientLogset->logger->info(
 		::Aulys::Log::indent(msg),
 		args...
@@ -233,7 +267,8 @@ inline void LOG_INFO__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void HEADER_WARN__(const std::string& msg, Args... args) {
+inline void HEADER_WARN__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->header->should_log(spdlog::level::warn)) { return; }
 	std::stringstream ss; // Create the input string.
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
 	// Then call warn with the log args.
@@ -244,7 +279,8 @@ inline void HEADER_WARN__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void LOG_WARN__(const std::string& msg, Args... args) {
+inline void LOG_WARN__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->logger->should_log(spdlog::level::warn)) { return; }
 	::Aulys::Log::mClientLogset->logger->warn(
 		::Aulys::Log::indent(msg),
 		args...
@@ -252,7 +288,8 @@ inline void LOG_WARN__(const std::string& msg, Args... args) {
 }
  
 template<class... Args>
-inline void HEADER_ERROR__(const std::string& msg, Args... args) {
+inline void HEADER_ERROR__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->header->should_log(spdlog::level::err)) { return; }
 	std::stringstream ss; // Create the input string.
 	ss << LOGGING_CORE_HEADER_FORMAT << " " << msg;
 	// Then call error with the log args.
@@ -264,7 +301,8 @@ inline void HEADER_ERROR__(const std::string& msg, Args... args) {
 }
 
 template<class... Args>
-inline void LOG_ERROR__(const std::string& msg, Args... args) {
+inline void LOG_ERROR__(const std::string& msg, const Args&... args) {
+	if (!::Aulys::Log::mClientLogset->logger->should_log(spdlog::level::err)) { return; }
 	::Aulys::Log::mClientLogset->logger->error(
 		::Aulys::Log::indent(msg),
 		args...
@@ -0,0 +1,162 @@
+#include "src/pch.h"
+
+#include "Platform/Headless/HeadlessWindow.h"
+#include "Platform/OpenGL/OpenGLHeadlessContext.h"
+
+#include "Events/ApplicationEvent.h"
+
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace Aulys
+{
+	namespace
+	{
+		// The nearest-rank percentile of an already sorted list.
+		double percentile(const std::vector<double>& sorted, double p) {
+			const size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+			return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+		}
+	}; // namespace
+
+	HeadlessProps HeadlessWindow::fromEnvironment(HeadlessProps props) {
+		if (const char* enabled = std::getenv("AULYS_HEADLESS")) {
+			props.enabled = std::string(enabled) != "0" && std::string(enabled) != "";
+		}
+		if (const char* frames = std::getenv("AULYS_HEADLESS_FRAMES")) {
+			props.frames = (uint32_t)std::strtoul(frames, nullptr, 10);
+		}
+		if (const char* out = std::getenv("AULYS_HEADLESS_OUT")) {
+			props.outputDir = out;
+		}
+		if (const char* dumpEvery = std::getenv("AULYS_HEADLESS_DUMP_EVERY")) {
+			props.dumpEvery = (uint32_t)std::strtoul(dumpEvery, nullptr, 10);
+		}
+		return props;
+	}
+
+	HeadlessWindow::HeadlessWindow(const WindowProps& props, const HeadlessProps& headless)
+		: mWidth(props.width), mHeight(props.height), mProps(headless)
+	{
+		ALOGIL("Creating (headless) Window \"{0}\" ({1}, {2}), {3} frames into \"{4}\"", props.title,
+			props.width, props.height, mProps.frames, mProps.outputDir);
+
+		mContext = std::make_unique<OpenGLHeadlessContext>(mWidth, mHeight);
+		mContext->init();
+
+		std::filesystem::create_directories(mProps.outputDir);
+		mFrameMs.reserve(mProps.frames);
+		mLastSwap = FrameClock::now();
+	}
+
+	HeadlessWindow::~HeadlessWindow() = default;
+
+	void HeadlessWindow::onUpdate()
+	{
+		swapBuffers();
+		pollEvents();
+	}
+
+	void HeadlessWindow::swapBuffers()
+	{
+		mContext->swapBuffers();
+
+		// Swap to swap, like a frame time on screen would be. The first frame has nothing before
+		// it, so it's from the window's creation - shaders compiling and all.
+		const FrameClock::time_point now = FrameClock::now();
+		mFrameMs.push_back(std::chrono::duration<double, std::milli>(now - mLastSwap).count());
+		mLastSwap = now;
+
+		const bool last = mProps.frames != 0 && mFrame + 1 == mProps.frames;
+		if (last || (mProps.dumpEvery != 0 && (mFrame + 1) % mProps.dumpEvery == 0)) {
+			dumpFrame();
+		}
+		mFrame++;
+
+		if (last) {
+			writeTiming();
+			if (mEventCallback) {
+				WindowCloseEvent event;
+				mEventCallback(event);
+			}
+		}
+	}
+
+	// Timesteps are measured like LinuxWindow's, so anything driven by them runs at the speed it
+	// really renders at. Something wanting the same frames every run should step by a fixed amount
+	// itself.
+	Timestep HeadlessWindow::calculateDeltaTime(FrameClock::time_point& lastFrameTime) const {
+		const FrameClock::time_point now = FrameClock::now();
+		const Timestep deltatime = lastFrameTime == FrameClock::time_point{} ?
+			FrameClock::duration::zero() : now - lastFrameTime;
+		lastFrameTime = now;
+		return deltatime;
+	}
+
+	// As a binary PPM, which wants no library and which anything can convert.
+	void HeadlessWindow::dumpFrame() const {
+		const std::vector<uint8_t> pixels = mContext->readPixels();
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "frame_%04u.ppm", mFrame);
+		const std::filesystem::path path = std::filesystem::path(mProps.outputDir) / name;
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			AU_LOG_ERROR("[HeadlessWindow::dumpFrame] Couldn't open {0} to write frame {1} to.",
+				path.string(), mFrame);
+			return;
+		}
+		file << "P6\n" << mWidth << " " << mHeight << "\n255\n";
+		file.write((const char*)pixels.data(), pixels.size());
+	}
+
+	// The statistics leave the first frame out, as it's mostly the Application starting up.
+	void HeadlessWindow::writeTiming() const {
+		std::vector<double> sorted(mFrameMs.begin() + std::min<size_t>(1, mFrameMs.size()), mFrameMs.end());
+		std::sort(sorted.begin(), sorted.end());
+
+		double mean = 0.0;
+		for (double ms : sorted) {
+			mean += ms;
+		}
+		mean = sorted.empty() ? 0.0 : mean / sorted.size();
+
+		const std::filesystem::path path = std::filesystem::path(mProps.outputDir) / "timing.json";
+		std::ofstream file(path, std::ios::trunc);
+		if (!file) {
+			AU_LOG_ERROR("[HeadlessWindow::writeTiming] Couldn't open {0}.", path.string());
+			return;
+		}
+		file << "{\n";
+		file << "  \"frames\": " << mFrame << ",\n";
+		file << "  \"width\": " << mWidth << ",\n";
+		file << "  \"height\": " << mHeight << ",\n";
+		file << "  \"renderer\": \"" << (const char*)glGetString(GL_RENDERER) << "\",\n";
+		file << "  \"frame_ms\": [";
+		for (size_t i = 0; i < mFrameMs.size(); i++) {
+			file << (i == 0 ? "" : ", ") << mFrameMs[i];
+		}
+		file << "],\n";
+		if (!sorted.empty()) {
+			file << "  \"mean_ms\": " << mean << ",\n";
+			file << "  \"median_ms\": " << percentile(sorted, 50.0) << ",\n";
+			file << "  \"p95_ms\": " << percentile(sorted, 95.0) << ",\n";
+			file << "  \"p99_ms\": " << percentile(sorted, 99.0) << ",\n";
+			file << "  \"max_ms\": " << sorted.back() << "\n";
+		}
+		else {
+			file << "  \"mean_ms\": 0\n";
+		}
+		file << "}\n";
+
+		AU_LOG_INFO("[HeadlessWindow] {0} frames done, median {1:.3f}ms, p99 {2:.3f}ms. Wrote {3}.",
+			mFrame, sorted.empty() ? 0.0 : percentile(sorted, 50.0),
+			sorted.empty() ? 0.0 : percentile(sorted, 99.0), path.string());
+	}
+
+}; // namespace Aulys
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Platform/Window.h"
+
+#include "Core/Timestep.h"
+
+#include <vector>
+
+namespace Aulys
+{
+	class OpenGLHeadlessContext;
+
+	// A window with nothing on screen, for running the normal Application loop on a machine without
+	// a display (CI, a server, llvmpipe): the frames go to an offscreen framebuffer instead, some of
+	// them get written out as images, and the time between swaps gets written out as timing.json
+	// when it's done. Window::Create makes one of these instead of the platform's window when
+	// WindowProps::headless (or the environment, see HeadlessProps) says so.
+	//
+	// There's no input at all - no events other than the WindowCloseEvent it sends itself after the
+	// last frame, and Input says nothing's pressed.
+	class HeadlessWindow : public Window
+	{
+	public:
+		HeadlessWindow(const WindowProps& props, const HeadlessProps& headless);
+		virtual ~HeadlessWindow();
+
+		// props, with whatever AULYS_HEADLESS* variables are set written over it.
+		static HeadlessProps fromEnvironment(HeadlessProps props);
+
+		void onUpdate() override;
+		// Flushes, counts the frame and dumps it if it's one to dump. After the last, writes out the
+		// timings and asks the Application to close.
+		void swapBuffers() override;
+		void pollEvents() override {};
+
+		inline unsigned int getWidth() const override { return mWidth; };
+		inline unsigned int getHeight() const override { return mHeight; };
+		bool isFullscreen() const override { return false; };
+		void setFullscreen(bool fullscreen = true) override {};
+
+		inline void setEventCallback(const std::function<void(Event&)> callback) override {
+			mEventCallback = callback;
+		};
+
+		// There's nothing to sync to, so it's always off and the FramePacer doesn't wait.
+		void setVSync(bool enabled) override {};
+		bool isVSync() const override { return false; };
+		float getRefreshRate() const override { return 0.0f; };
+		Timestep calculateDeltaTime(FrameClock::time_point& lastFrameTime) const override;
+
+		// There isn't one.
+		void* getNativeWindow() const override { return nullptr; };
+
+	private:
+		void dumpFrame() const;
+		void writeTiming() const;
+
+		unsigned int mWidth, mHeight;
+		HeadlessProps mProps;
+
+		Uni<OpenGLHeadlessContext> mContext;
+		std::function<void(Event&)> mEventCallback;
+
+		uint32_t mFrame = 0;
+		FrameClock::time_point mLastSwap;
+		std::vector<double> mFrameMs{};
+	}; // class HeadlessWindow : public Window
+
+}; // namespace Aulys
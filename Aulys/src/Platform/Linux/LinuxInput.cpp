@@ -11,6 +11,10 @@ namespace Aulys
 
 	bool LinuxInput::isKeyPressedImpl(int keycode) {
 		auto window = static_cast<GLFWwindow*>(Application::get().getWindow().getNativeWindow());
+		// A HeadlessWindow hasn't got a GLFW window, or any input.
+		if (window == nullptr) {
+			return false;
+		}
 		
 		auto state = glfwGetKey(window, keycode);
 		return (state == GLFW_PRESS) || (state == GLFW_REPEAT);
@@ -18,12 +22,18 @@ namespace Aulys
 
 	bool LinuxInput::isMouseButtonPressedImpl(int keycode) {
 		auto window = static_cast<GLFWwindow*>(Application::get().getWindow().getNativeWindow());
+		if (window == nullptr) {
+			return false;
+		}
 
 		return glfwGetMouseButton(window, keycode) == GLFW_PRESS;
 	}
 
 	std::pair<float, float> LinuxInput::getMousePosImpl() {
 		auto window = static_cast<GLFWwindow*>(Application::get().getWindow().getNativeWindow());
+		if (window == nullptr) {
+			return { 0.0f, 0.0f };
+		}
 		
 		double xpos, ypos;
 		glfwGetCursorPos(window, &xpos, &ypos);
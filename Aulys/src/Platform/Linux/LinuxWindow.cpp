@@ -177,8 +177,20 @@ namespace Aulys
 
 
 	void LinuxWindow::onUpdate()
+	{
+		swapBuffers();
+		pollEvents();
+	};
+
+
+	void LinuxWindow::swapBuffers()
 	{
 		mContext->swapBuffers();
+	};
+
+
+	void LinuxWindow::pollEvents()
+	{
 		glfwPollEvents();
 	};
 
@@ -201,11 +213,22 @@ namespace Aulys
 		return mData.vSync;
 	};
 
+	float LinuxWindow::getRefreshRate() const
+	{
+		// Windowed, we're on whatever monitor we're on - the primary one is the best guess.
+		GLFWmonitor* monitor = glfwGetWindowMonitor(mWindow);
+		const GLFWvidmode* mode = glfwGetVideoMode(monitor ? monitor : glfwGetPrimaryMonitor());
+		return mode ? (float)mode->refreshRate : 0.0f;
+	};
+
 	// Takes the lastFrameTime as an output parameter - it uses this to calculate the deltaTime and
-	// then writes into it the new FrameTime for next use.
-	Timestep LinuxWindow::calculateDeltaTime(float& lastFrameTime) const {
-		Timestep deltatime = (float)glfwGetTime() - lastFrameTime;
-		lastFrameTime = deltatime.getSeconds() + lastFrameTime;
+	// then writes into it the new FrameTime for next use. A default constructed lastFrameTime means
+	// there was no last frame, which gives a deltaTime of zero rather than the time since the epoch.
+	Timestep LinuxWindow::calculateDeltaTime(FrameClock::time_point& lastFrameTime) const {
+		const FrameClock::time_point now = FrameClock::now();
+		const Timestep deltatime = lastFrameTime == FrameClock::time_point{} ?
+			FrameClock::duration::zero() : now - lastFrameTime;
+		lastFrameTime = now;
 		return deltatime;
 	};
 
@@ -28,6 +28,8 @@ namespace Aulys
 		virtual ~LinuxWindow();
 
 		void onUpdate() override;
+		void swapBuffers() override;
+		void pollEvents() override;
 
 		inline unsigned int getWidth() const override { return mData.width; };
 		inline unsigned int getHeight() const override { return mData.height; };
@@ -40,7 +42,8 @@ namespace Aulys
 
 		void setVSync(bool enabled) override;
 		bool isVSync() const override;
-		Timestep calculateDeltaTime(float& lastFrameTime) const override;
+		float getRefreshRate() const override;
+		Timestep calculateDeltaTime(FrameClock::time_point& lastFrameTime) const override;
 
         void* getNativeWindow() const override { return this->mWindow; };
 
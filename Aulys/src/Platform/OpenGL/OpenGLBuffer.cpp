@@ -50,4 +50,80 @@ namespace Aulys
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
+	/* Uniform Buffer Impl */
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+		: mSize(size), mBinding(binding) {
+		glCreateBuffers(1, &mRendererID);
+		// DSA, so nothing gets bound along the way. Zeroed, rather than whatever the driver had.
+		std::vector<uint8_t> zeroes(size, 0);
+		glNamedBufferData(mRendererID, size, zeroes.data(), GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, mRendererID);
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer() {
+		glDeleteBuffers(1, &mRendererID);
+	}
+
+	void OpenGLUniformBuffer::setData(const void* data, uint32_t size, uint32_t offset) {
+		AU_CORE_ASSERT(offset + size <= mSize, "OpenGLUniformBuffer::setData: writing {0} bytes at"
+				" offset {1} runs off the end of the buffer ({2} bytes).", size, offset, mSize);
+		glNamedBufferSubData(mRendererID, offset, size, data);
+	}
+
+	/* Shader Storage Buffer Impl */
+
+	OpenGLShaderStorageBuffer::OpenGLShaderStorageBuffer(uint32_t size, uint32_t binding)
+		: mSize(size), mBinding(binding) {
+		glCreateBuffers(1, &mRendererID);
+		// Read back as well as written, hence GL_DYNAMIC_READ.
+		glNamedBufferData(mRendererID, size, nullptr, GL_DYNAMIC_READ);
+		clear();
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, mRendererID);
+	}
+
+	OpenGLShaderStorageBuffer::~OpenGLShaderStorageBuffer() {
+		if (mFence) {
+			glDeleteSync((GLsync)mFence);
+		}
+		glDeleteBuffers(1, &mRendererID);
+	}
+
+	void OpenGLShaderStorageBuffer::setData(const void* data, uint32_t size, uint32_t offset) {
+		AU_CORE_ASSERT(offset + size <= mSize, "OpenGLShaderStorageBuffer::setData: writing {0} bytes"
+				" at offset {1} runs off the end of the buffer ({2} bytes).", size, offset, mSize);
+		glNamedBufferSubData(mRendererID, offset, size, data);
+	}
+
+	void OpenGLShaderStorageBuffer::getData(void* data, uint32_t size, uint32_t offset) const {
+		AU_CORE_ASSERT(offset + size <= mSize, "OpenGLShaderStorageBuffer::getData: reading {0} bytes"
+				" at offset {1} runs off the end of the buffer ({2} bytes).", size, offset, mSize);
+		glGetNamedBufferSubData(mRendererID, offset, size, data);
+	}
+
+	void OpenGLShaderStorageBuffer::clear() {
+		glClearNamedBufferData(mRendererID, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+	}
+
+	void OpenGLShaderStorageBuffer::bind() const {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, mBinding, mRendererID);
+	}
+
+	void OpenGLShaderStorageBuffer::fence() {
+		if (mFence) {
+			glDeleteSync((GLsync)mFence);
+		}
+		mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		// Otherwise the fence can sit in our command queue, never sent, and isReady never be true.
+		glFlush();
+	}
+
+	bool OpenGLShaderStorageBuffer::isReady() const {
+		if (!mFence) {
+			return true;
+		}
+		GLint status = GL_UNSIGNALED;
+		glGetSynciv((GLsync)mFence, GL_SYNC_STATUS, 1, nullptr, &status);
+		return status == GL_SIGNALED;
+	}
+
 }; // namespace Aulys
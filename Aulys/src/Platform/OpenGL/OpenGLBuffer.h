@@ -40,4 +40,45 @@ namespace Aulys
 		uint32_t mRendererID;
 		uint32_t mCount;
 	}; // class OpenGLIndexBuffer : public IndexBuffer
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		OpenGLUniformBuffer(uint32_t size, uint32_t binding);
+		virtual ~OpenGLUniformBuffer();
+
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) override;
+
+		virtual uint32_t getSize() const override { return mSize; }
+		virtual uint32_t getBinding() const override { return mBinding; }
+
+	private:
+		uint32_t mRendererID;
+		uint32_t mSize;
+		uint32_t mBinding;
+	}; // class OpenGLUniformBuffer : public UniformBuffer
+
+	class OpenGLShaderStorageBuffer : public ShaderStorageBuffer
+	{
+	public:
+		OpenGLShaderStorageBuffer(uint32_t size, uint32_t binding);
+		virtual ~OpenGLShaderStorageBuffer();
+
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) override;
+		virtual void getData(void* data, uint32_t size, uint32_t offset = 0) const override;
+		virtual void clear() override;
+
+		virtual void bind() const override;
+		virtual void fence() override;
+		virtual bool isReady() const override;
+
+		virtual uint32_t getSize() const override { return mSize; }
+		virtual uint32_t getBinding() const override { return mBinding; }
+
+	private:
+		uint32_t mRendererID;
+		uint32_t mSize;
+		uint32_t mBinding;
+		void* mFence = nullptr; // A GLsync, or nullptr before the first fence.
+	}; // class OpenGLShaderStorageBuffer : public ShaderStorageBuffer
 }; // namespace Aulys
@@ -8,7 +8,8 @@
 namespace Aulys 
 {
 	OpenGLFrameBuffer::OpenGLFrameBuffer() {
-		glGenFramebuffers(1, &mRendererID);
+		// Created rather than just named, so the attachments can be changed without binding it.
+		glCreateFramebuffers(1, &mRendererID);
 	}
 
 	OpenGLFrameBuffer::~OpenGLFrameBuffer() {
@@ -20,17 +21,37 @@ namespace Aulys
 	}
 
 	void OpenGLFrameBuffer::unbind() noexcept {
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glBindFramebuffer(GL_FRAMEBUFFER, sWindowFramebuffer);
 	}
 
 	OpenGLFrameBuffer::operator bool() const noexcept {
 		return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
 	}
 
-	void OpenGLFrameBuffer::attachTexture(Ref<Texture2D> texture) {
-		glBindFramebuffer(GL_FRAMEBUFFER, mRendererID);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->getID(), 0);
+	void OpenGLFrameBuffer::attachTexture(Ref<Texture2D> texture, uint32_t slot) {
+		AU_CORE_ASSERT(slot < 8, "[OpenGLFrameBuffer::attachTexture]: slot {0} is past the eight colour"
+				" attachments GL promises.", slot);
+		glNamedFramebufferTexture(mRendererID, GL_COLOR_ATTACHMENT0 + slot, texture->getID(), 0);
+		mColourAttachments |= 1u << slot;
+		updateDrawBuffers();
 
 		// You could add depth and stencil stuff here.
 	}
+
+	void OpenGLFrameBuffer::detachTexture(uint32_t slot) {
+		glNamedFramebufferTexture(mRendererID, GL_COLOR_ATTACHMENT0 + slot, 0, 0);
+		mColourAttachments &= ~(1u << slot);
+		updateDrawBuffers();
+	}
+
+	void OpenGLFrameBuffer::updateDrawBuffers() noexcept {
+		// Gaps get GL_NONE, so output n still lands in attachment n.
+		GLenum buffers[8];
+		GLsizei count = 0;
+		for (uint32_t slot = 0; slot < 8 && (mColourAttachments >> slot); slot++) {
+			buffers[slot] = (mColourAttachments & (1u << slot)) ? GL_COLOR_ATTACHMENT0 + slot : GL_NONE;
+			count = slot + 1;
+		}
+		glNamedFramebufferDrawBuffers(mRendererID, count, buffers);
+	}
 }; // namespace Aulys
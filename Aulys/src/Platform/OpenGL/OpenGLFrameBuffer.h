@@ -12,7 +12,8 @@ namespace Aulys
 		~OpenGLFrameBuffer();
 		virtual void bind() noexcept override;
 		virtual void unbind() noexcept override;
-		virtual void attachTexture(Ref<Texture2D> texture) override;
+		virtual void attachTexture(Ref<Texture2D> texture, uint32_t slot = 0) override;
+		virtual void detachTexture(uint32_t slot) override;
 
 		// OpenGL ID get
 		virtual explicit operator int() const noexcept override { return mRendererID; }
@@ -22,7 +23,17 @@ namespace Aulys
 		virtual explicit operator bool() const noexcept override;
 		virtual bool isValid() const noexcept { return (bool)*this; }
 
+		// What unbind goes back to. The window's own framebuffer is 0, unless there's no window -
+		// OpenGLHeadlessContext makes one to stand in for it, and sets it here.
+		static void setWindowFramebuffer(uint32_t id) noexcept { sWindowFramebuffer = id; }
+
 	private:
+		// Points glDrawBuffers at whatever's in mColourAttachments.
+		void updateDrawBuffers() noexcept;
+
 		uint32_t mRendererID;
+		uint32_t mColourAttachments = 0; // Bit n is set if GL_COLOR_ATTACHMENTn has a texture.
+
+		static inline uint32_t sWindowFramebuffer = 0;
 	}; // class FrameBuffer
 }; // namespace Aulys
@@ -0,0 +1,95 @@
+#include "src/pch.h"
+
+#include "OpenGLFramePacer.h"
+
+#include "glad/glad.h"
+
+namespace Aulys
+{
+	OpenGLFramePacer::OpenGLFramePacer() {
+		for (PendingFrame& f : mFrames) {
+			glGenQueries(1, &f.beginQuery);
+			glGenQueries(1, &f.endQuery);
+		}
+	}
+
+	OpenGLFramePacer::~OpenGLFramePacer() {
+		for (PendingFrame& f : mFrames) {
+			glDeleteQueries(1, &f.beginQuery);
+			glDeleteQueries(1, &f.endQuery);
+		}
+		for (void* fence : mFences) {
+			glDeleteSync((GLsync)fence);
+		}
+	}
+
+	void OpenGLFramePacer::beginGpuFrame(uint64_t frame) {
+		PendingFrame& f = mFrames[frame % sMaxFramesInFlight];
+		// Still not collected after sMaxFramesInFlight frames - that's as far behind as we let the
+		// GPU get, so wait for it.
+		if (f.pending) {
+			resolve(f);
+		}
+
+		GLint64 gpuNow = 0;
+		glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+		f.cpuAtBegin = FrameClock::now();
+		f.gpuAtBegin = gpuNow;
+		f.frame = frame;
+		glQueryCounter(f.beginQuery, GL_TIMESTAMP);
+	}
+
+	void OpenGLFramePacer::endGpuFrame(uint64_t frame) {
+		PendingFrame& f = mFrames[frame % sMaxFramesInFlight];
+		glQueryCounter(f.endQuery, GL_TIMESTAMP);
+		f.pending = true;
+	}
+
+	FrameClock::duration OpenGLFramePacer::throttle(uint32_t maxQueued, bool useFinish) {
+		const FrameClock::time_point start = FrameClock::now();
+		if (useFinish) {
+			glFinish();
+			for (void* fence : mFences) {
+				glDeleteSync((GLsync)fence);
+			}
+			mFences.clear();
+			return FrameClock::now() - start;
+		}
+
+		mFences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		while (mFences.size() > maxQueued) {
+			// A generous timeout, so that a lost context can't hang us forever.
+			constexpr GLuint64 timeoutNs = 1000000000;
+			glClientWaitSync((GLsync)mFences.front(), GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+			glDeleteSync((GLsync)mFences.front());
+			mFences.pop_front();
+		}
+		return FrameClock::now() - start;
+	}
+
+	void OpenGLFramePacer::collectGpuFrames() {
+		for (PendingFrame& f : mFrames) {
+			if (!f.pending) {
+				continue;
+			}
+			// The end query is the later of the two, if it's there, both are.
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(f.endQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available) {
+				resolve(f);
+			}
+		}
+	}
+
+	void OpenGLFramePacer::resolve(PendingFrame& f) {
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(f.beginQuery, GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(f.endQuery, GL_QUERY_RESULT, &end);
+		f.pending = false;
+
+		const auto gpuTime = std::chrono::nanoseconds(end - begin);
+		const auto gpuDone = f.cpuAtBegin + std::chrono::duration_cast<FrameClock::duration>(
+			std::chrono::nanoseconds((int64_t)end - f.gpuAtBegin));
+		onGpuFrameDone(f.frame, std::chrono::duration_cast<FrameClock::duration>(gpuTime), gpuDone);
+	}
+}; // namespace Aulys
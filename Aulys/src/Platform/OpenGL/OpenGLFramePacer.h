@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Renderer/FramePacer.h"
+
+#include <deque>
+
+namespace Aulys
+{
+	// GPU times come from GL_TIMESTAMP queries at the start and end of every frame, which are
+	// converted to our clock with a glGetInteger64v(GL_TIMESTAMP) taken alongside FrameClock::now()
+	// at the start. Throttling is glFenceSync/glClientWaitSync, or glFinish.
+	class OpenGLFramePacer : public FramePacer
+	{
+	public:
+		OpenGLFramePacer();
+		~OpenGLFramePacer();
+
+	protected:
+		virtual void beginGpuFrame(uint64_t frame) override;
+		virtual void endGpuFrame(uint64_t frame) override;
+		virtual FrameClock::duration throttle(uint32_t maxQueued, bool useFinish) override;
+		virtual void collectGpuFrames() override;
+
+	private:
+		struct PendingFrame
+		{
+			uint32_t beginQuery = 0;
+			uint32_t endQuery = 0;
+			int64_t gpuAtBegin = 0; // GL_TIMESTAMP, in ns...
+			FrameClock::time_point cpuAtBegin; // ...and FrameClock at the same moment.
+			uint64_t frame = 0;
+			bool pending = false;
+		}; // struct PendingFrame
+
+		void resolve(PendingFrame& f);
+
+		std::array<PendingFrame, sMaxFramesInFlight> mFrames;
+		std::deque<void*> mFences; // GLsync, oldest first.
+	}; // class OpenGLFramePacer : public FramePacer
+}; // namespace Aulys
@@ -0,0 +1,143 @@
+#include "src/pch.h"
+
+#include "Platform/OpenGL/OpenGLHeadlessContext.h"
+#include "Platform/OpenGL/OpenGLFrameBuffer.h"
+
+#include "glad/glad.h"
+
+// Last, as it brings in a platform header or two.
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+
+namespace Aulys 
+{
+	OpenGLHeadlessContext::OpenGLHeadlessContext(uint32_t width, uint32_t height)
+		: mWidth(width), mHeight(height) {
+	}
+
+	OpenGLHeadlessContext::~OpenGLHeadlessContext() {
+		if (mFramebuffer != 0) {
+			OpenGLFrameBuffer::setWindowFramebuffer(0);
+			glDeleteFramebuffers(1, &mFramebuffer);
+			glDeleteRenderbuffers(1, &mColourBuffer);
+			glDeleteRenderbuffers(1, &mDepthBuffer);
+		}
+		if (mDisplay != nullptr) {
+			eglMakeCurrent((EGLDisplay)mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			if (mContext != nullptr) {
+				eglDestroyContext((EGLDisplay)mDisplay, (EGLContext)mContext);
+			}
+			eglTerminate((EGLDisplay)mDisplay);
+		}
+	}
+
+	void OpenGLHeadlessContext::init()
+	{
+		// Mesa's surfaceless platform needs no display server at all. Failing that (another vendor's
+		// EGL), the default display does as well, as long as it can make a context current without
+		// a surface.
+		EGLDisplay display = EGL_NO_DISPLAY;
+		auto getPlatformDisplay =
+			(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if (getPlatformDisplay) {
+			display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		}
+		if (display == EGL_NO_DISPLAY) {
+			display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+		EGLint major = 0, minor = 0;
+		const bool initialized = display != EGL_NO_DISPLAY && eglInitialize(display, &major, &minor);
+		AU_CORE_ASSERT(initialized, "[OpenGLHeadlessContext::init] Couldn't get an EGL display"
+			" (eglGetError() = {0:#x}). Is Mesa's libEGL installed?", eglGetError());
+		this->mDisplay = display;
+
+		const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+		AU_CORE_ASSERT(extensions && std::strstr(extensions, "EGL_KHR_surfaceless_context"),
+			"[OpenGLHeadlessContext::init] The EGL display (EGL {0}.{1}) can't make a context current"
+			" without a surface (no EGL_KHR_surfaceless_context).", major, minor);
+
+		eglBindAPI(EGL_OPENGL_API);
+
+		// Never used for a surface, but eglChooseConfig looks for window surfaces unless told
+		// otherwise, and the surfaceless platform hasn't got any.
+		const EGLint configAttributes[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+		EGLConfig config = nullptr;
+		EGLint configCount = 0;
+		eglChooseConfig(display, configAttributes, &config, 1, &configCount);
+		AU_CORE_ASSERT(configCount > 0, "[OpenGLHeadlessContext::init] No EGL config that can do"
+			" desktop OpenGL.");
+
+		// The same version and profile LinuxWindow asks GLFW for.
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 5,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+		AU_CORE_ASSERT(context != EGL_NO_CONTEXT, "[OpenGLHeadlessContext::init] Couldn't create an"
+			" OpenGL 4.5 core context (eglGetError() = {0:#x}).", eglGetError());
+		this->mContext = context;
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+
+		int status = gladLoadGLLoader( (GLADloadproc)eglGetProcAddress );
+		AU_CORE_ASSERT(status, "Failed to initialize Glad.");
+
+		AU_LOG_INFO("OpenGL Info (headless, EGL {}.{}):"
+		            "\n   Vendor: {}"
+		            "\n   Renderer: {}"
+		            "\n   Version: {}", 
+		            major, minor, glGetString(GL_VENDOR), glGetString(GL_RENDERER), glGetString(GL_VERSION));
+
+		// The stand-in for the window's framebuffer.
+		glGenRenderbuffers(1, &mColourBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, mColourBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, mWidth, mHeight);
+		glGenRenderbuffers(1, &mDepthBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, mDepthBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, mWidth, mHeight);
+
+		glGenFramebuffers(1, &mFramebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, mColourBuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, mDepthBuffer);
+		AU_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+			"[OpenGLHeadlessContext::init] The {0}x{1} framebuffer isn't complete.", mWidth, mHeight);
+
+		glViewport(0, 0, mWidth, mHeight);
+		OpenGLFrameBuffer::setWindowFramebuffer(mFramebuffer);
+	}
+
+	void OpenGLHeadlessContext::swapBuffers() {
+		glFlush();
+	}
+
+	std::vector<uint8_t> OpenGLHeadlessContext::readPixels() const {
+		std::vector<uint8_t> pixels(3 * mWidth * mHeight);
+
+		GLint previous = 0;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffer);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, mWidth, mHeight, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, previous);
+
+		// GL's rows start at the bottom.
+		const size_t rowSize = 3 * mWidth;
+		std::vector<uint8_t> row(rowSize);
+		for (uint32_t y = 0; y < mHeight / 2; y++) {
+			uint8_t* top = pixels.data() + y * rowSize;
+			uint8_t* bottom = pixels.data() + (mHeight - 1 - y) * rowSize;
+			std::memcpy(row.data(), top, rowSize);
+			std::memcpy(top, bottom, rowSize);
+			std::memcpy(bottom, row.data(), rowSize);
+		}
+		return pixels;
+	}
+}; // namespace Aulys
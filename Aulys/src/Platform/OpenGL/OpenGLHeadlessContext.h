@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Renderer/GraphicsContext.h"
+
+#include <vector>
+
+namespace Aulys 
+{
+	// An OpenGL 4.5 core context with no window and no display server behind it, made with EGL on
+	// Mesa's surfaceless platform (so llvmpipe works, as well as a real GPU). Without a window,
+	// there's no default framebuffer to draw into, so this makes one of its own at the size it's
+	// given - OpenGLFrameBuffer::unbind goes back to it, as it would go back to the window's.
+	//
+	// The EGL handles are kept as void*, so that nothing but OpenGLHeadlessContext.cpp sees the EGL
+	// headers.
+	class OpenGLHeadlessContext : public GraphicsContext
+	{
+	public:
+		OpenGLHeadlessContext(uint32_t width, uint32_t height);
+		~OpenGLHeadlessContext();
+
+		void init() override;
+		// There's nothing to present to, so this only flushes.
+		void swapBuffers() override;
+
+		// The framebuffer's colour, tightly packed RGB, top row first.
+		std::vector<uint8_t> readPixels() const;
+
+		inline uint32_t getFramebufferID() const { return mFramebuffer; };
+
+	private:
+		uint32_t mWidth, mHeight;
+
+		void* mDisplay = nullptr;
+		void* mContext = nullptr;
+
+		uint32_t mFramebuffer = 0;
+		uint32_t mColourBuffer = 0;
+		uint32_t mDepthBuffer = 0;
+	}; // class OpenGLHeadlessContext : public GraphicsContext
+}; // namespace Aulys
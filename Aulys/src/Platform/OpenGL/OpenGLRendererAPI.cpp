@@ -74,6 +74,14 @@ namespace Aulys
 		// then you'll see that that binds the index buffer.
 	}
 
+	void OpenGLRendererAPI::dispatchCompute(uint32_t x, uint32_t y, uint32_t z) {
+		glDispatchCompute(x, y, z);
+		// Image and buffer writes from a compute shader aren't ordered with anything else until
+		// there's a barrier. We don't know who's reading them next (a texture fetch, a readback,
+		// another dispatch...), so it's all of them - dispatches are few enough that it doesn't matter.
+		glMemoryBarrier(GL_ALL_BARRIER_BITS);
+	}
+
 	void OpenGLRendererAPI::handleError(const glCallbackError& e) const noexcept {
 		switch(e.logLevel) {
 			case 0: 
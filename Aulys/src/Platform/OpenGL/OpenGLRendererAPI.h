@@ -12,6 +12,7 @@ namespace Aulys
 		virtual void clear() override;
 
 		virtual void drawIndexed(const Ref<VertexArray>& vertexArray) override;
+		virtual void dispatchCompute(uint32_t x, uint32_t y, uint32_t z) override;
 
 		struct glCallbackError
 		{
@@ -60,7 +60,14 @@ namespace Aulys
 
 	OpenGLShader::~OpenGLShader()
 	{
-		glDeleteProgram(mRendererID);
+		if (mRendererID != 0) {
+			glDeleteProgram(mRendererID);
+		}
+	}
+
+	std::unordered_map<GLenum, std::string> OpenGLShader::preprocessFile(Path sourcePath) {
+		OpenGLShader shader{ NoCompile{} };
+		return shader.preprocess(shader.readFile(*sourcePath.gets()), *sourcePath.gets());
 	}
 
 	std::string OpenGLShader::readFile(const std::string& filePath) const noexcept {
@@ -89,6 +96,9 @@ namespace Aulys
 		else if (typeName == "fragment" || typeName == "pixel") {
 			return GL_FRAGMENT_SHADER;
 		}
+		else if (typeName == "compute") {
+			return GL_COMPUTE_SHADER; // On its own in the file: a compute program has nothing else.
+		}
 
 		AU_LOG_WARN("[OpenGLShader::preprocess => shaderTysourcepeFromString]: Unrecognised typeName"
 				" \"{0}\". Make sure your type name (following the token `#type `) is correct,"
@@ -350,9 +360,45 @@ namespace Aulys
 			glDetachShader(program, shaderID);
 		}
 
-		// Success!
+		// Success! If this is a recompile (e.g. setTag), the old program has to go.
+		if (mRendererID != 0) {
+			glDeleteProgram(mRendererID);
+		}
 		mRendererID = program;
 		glUseProgram(mRendererID);
+
+		// A new program starts with every block on binding 0, and every uniform zeroed.
+		for (const auto& [name, binding] : mUniformBlockBindings) {
+			setUniformBlockBinding(name, binding);
+		}
+		for (const auto& [name, value] : mUniformValues) {
+			applyUniform(glGetUniformLocation(mRendererID, name.c_str()), value);
+		}
+	}
+
+	void OpenGLShader::rememberUniform(const std::string& name, UniformValue::Kind kind, int32_t count,
+			const void* data, size_t words) {
+		UniformValue& value = mUniformValues[name];
+		value.kind = kind;
+		value.count = count;
+		// Same size as last time, nearly always, so this doesn't allocate.
+		value.words.resize(words);
+		std::memcpy(value.words.data(), data, words * sizeof(uint32_t));
+	}
+
+	void OpenGLShader::applyUniform(int32_t location, const UniformValue& value) const {
+		const auto* f = reinterpret_cast<const GLfloat*>(value.words.data());
+		const auto* i = reinterpret_cast<const GLint*>(value.words.data());
+		switch (value.kind) {
+			case UniformValue::Kind::Mat4:   glUniformMatrix4fv(location, value.count, GL_FALSE, f); break;
+			case UniformValue::Kind::Mat3:   glUniformMatrix3fv(location, value.count, GL_FALSE, f); break;
+			case UniformValue::Kind::Float4: glUniform4fv(location, value.count, f); break;
+			case UniformValue::Kind::Float3: glUniform3fv(location, value.count, f); break;
+			case UniformValue::Kind::Float2: glUniform2fv(location, value.count, f); break;
+			case UniformValue::Kind::Float:  glUniform1fv(location, value.count, f); break;
+			case UniformValue::Kind::Int2:   glUniform2iv(location, value.count, i); break;
+			case UniformValue::Kind::Int:    glUniform1iv(location, value.count, i); break;
+		}
 	}
 
 	void OpenGLShader::bind() const
@@ -366,10 +412,12 @@ namespace Aulys
 	}
 
 	void OpenGLShader::uploadUniformMat4(const std::string& name, const glm::mat4& matrix) {
+		rememberUniform(name, UniformValue::Kind::Mat4, 1, glm::value_ptr(matrix), 16);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	};
 	void OpenGLShader::uploadUniformMat3(const std::string& name, const glm::mat3& matrix) {
+		rememberUniform(name, UniformValue::Kind::Mat3, 1, glm::value_ptr(matrix), 9);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		// f means it's floats
 		// v means it's an array
@@ -378,62 +426,115 @@ namespace Aulys
 
 	void OpenGLShader::uploadUniformMat4(const std::string& name, uint32_t count,
 			const glm::mat4* matrices) {
+		rememberUniform(name, UniformValue::Kind::Mat4, count, glm::value_ptr(*matrices), 16 * count);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniformMatrix4fv(location, count, GL_FALSE, glm::value_ptr(*matrices));
 	};
 
 	// [Material Systems]
 	void OpenGLShader::uploadUniformFloat4(const std::string& name, const glm::vec4& floats) {
+		rememberUniform(name, UniformValue::Kind::Float4, 1, glm::value_ptr(floats), 4);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform4f(location, floats.x, floats.y, floats.z, floats.w);
 	};
 
 	void OpenGLShader::uploadUniformFloat4(const std::string& name, uint32_t count,
 			const glm::vec4* floats) {
+		rememberUniform(name, UniformValue::Kind::Float4, count, glm::value_ptr(*floats), 4 * count);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform4fv(location, count, glm::value_ptr(*floats));
 	};
 
 	void OpenGLShader::uploadUniformFloat3(const std::string& name, const glm::vec3& floats) {
+		rememberUniform(name, UniformValue::Kind::Float3, 1, glm::value_ptr(floats), 3);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform3f(location, floats.x, floats.y, floats.z);
 	}
 
 	void OpenGLShader::uploadUniformFloat3(const std::string& name, uint32_t count,
 			const glm::vec3* floats) {
+		rememberUniform(name, UniformValue::Kind::Float3, count, glm::value_ptr(*floats), 3 * count);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform3fv(location, count, glm::value_ptr(*floats));
 	};
 
 
 	void OpenGLShader::uploadUniformFloat2(const std::string& name, const glm::vec2& floats) {
+		rememberUniform(name, UniformValue::Kind::Float2, 1, glm::value_ptr(floats), 2);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform2f(location, floats.x, floats.y);
 	}
 
 	void OpenGLShader::uploadUniformFloat(const std::string& name, const float value) {
+		rememberUniform(name, UniformValue::Kind::Float, 1, &value, 1);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform1f(location, value);
 	}
 
 	void OpenGLShader::uploadUniformInt(const std::string& name, const int value) {
+		rememberUniform(name, UniformValue::Kind::Int, 1, &value, 1);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform1i(location, value);
 	}
 
+	void OpenGLShader::uploadUniformInt(const std::string& name, uint32_t count, const int* values) {
+		rememberUniform(name, UniformValue::Kind::Int, count, values, count);
+		GLint location = glGetUniformLocation(mRendererID, name.c_str());
+		glUniform1iv(location, count, values);
+	}
+
 	void OpenGLShader::uploadUniformInt2(const std::string& name, const int value[2]) {
+		rememberUniform(name, UniformValue::Kind::Int2, 1, value, 2);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform2i(location, value[0], value[1]);
 	}
 
 	void OpenGLShader::uploadUniformBool(const std::string& name, const bool value) {
+		const int asInt = (int)value;
+		rememberUniform(name, UniformValue::Kind::Int, 1, &asInt, 1);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
 		glUniform1i(location, (int)value);
 	}
 
 	void OpenGLShader::uploadUniform2Bool(const std::string& name, const bool value[2]) {
+		// A bool is a byte, and GL wants ints.
+		const int asInts[2] = { (int)value[0], (int)value[1] };
+		rememberUniform(name, UniformValue::Kind::Int, 2, asInts, 2);
 		GLint location = glGetUniformLocation(mRendererID, name.c_str());
-		glUniform1iv(location, 2, (const int*)value);
+		glUniform1iv(location, 2, asInts);
+	}
+
+	void OpenGLShader::setUniformBlockBinding(const std::string& name, uint32_t binding) {
+		mUniformBlockBindings[name] = binding;
+		GLuint index = glGetUniformBlockIndex(mRendererID, name.c_str());
+		if (index == GL_INVALID_INDEX) {
+			AU_LOG_WARN("[OpenGLShader::setUniformBlockBinding]: There's no uniform block called"
+					" \"{0}\" in program {1} (or it isn't used, and got optimised out).", name, mRendererID);
+			return;
+		}
+		glUniformBlockBinding(mRendererID, index, binding);
+	}
+
+	void OpenGLShader::copyUniformsFrom(const Shader& source) {
+		const auto& other = static_cast<const OpenGLShader&>(source);
+		glUseProgram(mRendererID);
+
+		for (const auto& [name, binding] : other.mUniformBlockBindings) {
+			auto it = mUniformBlockBindings.find(name);
+			if (it == mUniformBlockBindings.end() || it->second != binding) {
+				setUniformBlockBinding(name, binding);
+			}
+		}
+		// Most of them don't change from one frame to the next, so comparing first saves nearly all
+		// the uploads. Uniforms this program hasn't got just get location -1, which GL ignores.
+		for (const auto& [name, value] : other.mUniformValues) {
+			auto it = mUniformValues.find(name);
+			if (it != mUniformValues.end() && it->second == value) {
+				continue;
+			}
+			mUniformValues[name] = value;
+			applyUniform(glGetUniformLocation(mRendererID, name.c_str()), value);
+		}
 	}
 
 }; // namespace Aulys
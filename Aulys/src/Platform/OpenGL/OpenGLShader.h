@@ -20,6 +20,11 @@ namespace Aulys
 
 		virtual ~OpenGLShader() override;
 
+		// Everything creating a shader from sourcePath does short of compiling it - the #tag, #include
+		// and #type passes, with every tag at its default. Doesn't touch GL, so it runs without a
+		// context (AulysBench times it like this).
+		static std::unordered_map<GLenum, std::string> preprocessFile(Path sourcePath);
+
 		virtual void bind() const override;
 		virtual void unbind() const override;
 	
@@ -78,10 +83,18 @@ namespace Aulys
 		virtual void uploadUniformFloat2(const std::string& name, const glm::vec2& floats) override;
 		virtual void uploadUniformFloat(const std::string& name, const float value) override;
 		virtual void uploadUniformInt(const std::string& name, const int value) override;
+		virtual void uploadUniformInt(const std::string& name, uint32_t count, const int* values) override;
 		virtual void uploadUniformInt2(const std::string& name, const int value[2]) override;
 		virtual void uploadUniformBool(const std::string& name, const bool value) override;
 		virtual void uploadUniform2Bool(const std::string& name, const bool value[2]) override;
+
+		virtual void setUniformBlockBinding(const std::string& name, uint32_t binding) override;
+		virtual void copyUniformsFrom(const Shader& source) override;
 	private:
+		// For preprocessFile: a shader that never gets compiled, so has no program to delete.
+		struct NoCompile {};
+		explicit OpenGLShader(NoCompile) {};
+
 		void createFromPath(Path sourcePath);
 		void createFromPaths(Path vertexSourcePath, Path fragmentSourcePath);
 		bool singlePath = true; // Was I constructed from one path or two?
@@ -95,7 +108,25 @@ namespace Aulys
 				const std::string& debug_path = {"path-not-specified"}) noexcept;
 		std::string readFile(const std::string& filePath) const noexcept;
 		std::unordered_map<std::string, Tag> tags{};
+		std::unordered_map<std::string, uint32_t> mUniformBlockBindings{}; // Reapplied by compile.
+
+		// The last thing each uniform was given, as 4 byte words, also reapplied by compile - so a
+		// recompile (e.g. setTag) doesn't leave whoever uploaded them to do it all again.
+		struct UniformValue {
+			enum class Kind { Mat4, Mat3, Float4, Float3, Float2, Float, Int2, Int };
+			Kind kind = Kind::Int;
+			int32_t count = 1;
+			std::vector<uint32_t> words;
+
+			bool operator==(const UniformValue& other) const {
+				return kind == other.kind && count == other.count && words == other.words;
+			}
+		};
+		void rememberUniform(const std::string& name, UniformValue::Kind kind, int32_t count,
+				const void* data, size_t words);
+		void applyUniform(int32_t location, const UniformValue& value) const;
+		std::unordered_map<std::string, UniformValue> mUniformValues{};
 
-		uint32_t mRendererID;
+		uint32_t mRendererID = 0;
 	}; // class OpenGLShader : public Shader
 }; // namespace Aulys
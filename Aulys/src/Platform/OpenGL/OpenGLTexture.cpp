@@ -47,6 +47,7 @@ namespace Aulys
 		}
 
 
+		mInternalFormat = internalStorageFormat;
 		glCreateTextures(GL_TEXTURE_2D, 1, &mRendererID);
 
 		glTextureStorage2D(mRendererID, 1, internalStorageFormat, mWidth, mHeight);
@@ -63,13 +64,22 @@ namespace Aulys
 		stbi_image_free(data);
 	}
 
-	OpenGLTexture2D::OpenGLTexture2D(int width, int height) : mPath("0"), mWidth(width), mHeight(height) {
+	OpenGLTexture2D::OpenGLTexture2D(int width, int height, TextureFormat format)
+		: mPath("0"), mWidth(width), mHeight(height) {
+		bool isInteger = false;
+		switch (format) {
+			case TextureFormat::RGB8:     mInternalFormat = GL_RGB8; break;
+			case TextureFormat::RGBA8:    mInternalFormat = GL_RGBA8; break;
+			case TextureFormat::RGBA32UI: mInternalFormat = GL_RGBA32UI; isInteger = true; break;
+			case TextureFormat::R32F:     mInternalFormat = GL_R32F; break;
+		}
+
 		glCreateTextures(GL_TEXTURE_2D, 1, &mRendererID);
-		glBindTexture(GL_TEXTURE_2D, mRendererID);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, mWidth, mHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-		glTextureParameteri(mRendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		// Immutable storage, so it can be bound as an image as well as rendered to and sampled.
+		glTextureStorage2D(mRendererID, 1, mInternalFormat, mWidth, mHeight);
+		// Integer textures with linear filtering are incomplete, and sample as zero.
+		glTextureParameteri(mRendererID, GL_TEXTURE_MIN_FILTER, isInteger ? GL_NEAREST : GL_LINEAR);
 		glTextureParameteri(mRendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glBindTexture(GL_TEXTURE_2D, 0);
 	};
 
 	OpenGLTexture2D::~OpenGLTexture2D() {
@@ -80,5 +90,80 @@ namespace Aulys
 		glActiveTexture(GL_TEXTURE0 + slot);
 		glBindTextureUnit(slot, mRendererID);
 	}
-}; // namespace Aulysthe
 
+	void OpenGLTexture2D::bindImage(uint32_t unit, Access access) const {
+		GLenum glAccess = GL_READ_WRITE;
+		switch (access) {
+			case Access::ReadOnly:  glAccess = GL_READ_ONLY; break;
+			case Access::WriteOnly: glAccess = GL_WRITE_ONLY; break;
+			case Access::ReadWrite: glAccess = GL_READ_WRITE; break;
+		}
+		glBindImageTexture(unit, mRendererID, 0, GL_FALSE, 0, glAccess, mInternalFormat);
+	}
+
+	namespace
+	{
+		// The internal format, and the format and type setData's texels come in, for each TextureFormat.
+		struct GLFormat
+		{
+			GLenum internalFormat, dataFormat, dataType;
+			uint32_t texelSize;
+			bool isInteger;
+		}; // struct GLFormat
+
+		GLFormat getGLFormat(TextureFormat format) {
+			switch (format) {
+				case TextureFormat::RGB8:     return { GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, 3, false };
+				case TextureFormat::RGBA8:    return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4, false };
+				case TextureFormat::RGBA32UI: return { GL_RGBA32UI, GL_RGBA_INTEGER, GL_UNSIGNED_INT, 16, true };
+				case TextureFormat::R32F:     return { GL_R32F, GL_RED, GL_FLOAT, 4, false };
+			}
+			return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4, false };
+		}
+	}; // namespace
+
+	OpenGLTexture3D::OpenGLTexture3D(int width, int height, int depth, TextureFormat format)
+		: mWidth(width), mHeight(height), mDepth(depth), mFormat(format) {
+		const GLFormat glFormat = getGLFormat(format);
+		mInternalFormat = glFormat.internalFormat;
+
+		glCreateTextures(GL_TEXTURE_3D, 1, &mRendererID);
+		glTextureStorage3D(mRendererID, 1, mInternalFormat, mWidth, mHeight, mDepth);
+		glTextureParameteri(mRendererID, GL_TEXTURE_MIN_FILTER, glFormat.isInteger ? GL_NEAREST : GL_LINEAR);
+		glTextureParameteri(mRendererID, GL_TEXTURE_MAG_FILTER, glFormat.isInteger ? GL_NEAREST : GL_LINEAR);
+		// Samples past the edge get the edge's texels, not a wrapped-around far side.
+		glTextureParameteri(mRendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(mRendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(mRendererID, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	}
+
+	OpenGLTexture3D::~OpenGLTexture3D() {
+		glDeleteTextures(1, &mRendererID);
+	}
+
+	void OpenGLTexture3D::setData(const void* data, uint32_t size) {
+		const GLFormat glFormat = getGLFormat(mFormat);
+		AU_CORE_ASSERT(size == mWidth * mHeight * mDepth * glFormat.texelSize,
+			"[OpenGLTexture3D::setData] Got {0} bytes, the whole volume is {1}.", size,
+			mWidth * mHeight * mDepth * glFormat.texelSize);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage3D(mRendererID, 0, 0, 0, 0, mWidth, mHeight, mDepth, glFormat.dataFormat,
+				glFormat.dataType, data);
+	}
+
+	void OpenGLTexture3D::bind(uint32_t slot) const {
+		glActiveTexture(GL_TEXTURE0 + slot);
+		glBindTextureUnit(slot, mRendererID);
+	}
+
+	void OpenGLTexture3D::bindImage(uint32_t unit, Access access) const {
+		GLenum glAccess = GL_READ_WRITE;
+		switch (access) {
+			case Access::ReadOnly:  glAccess = GL_READ_ONLY; break;
+			case Access::WriteOnly: glAccess = GL_WRITE_ONLY; break;
+			case Access::ReadWrite: glAccess = GL_READ_WRITE; break;
+		}
+		// Layered, so the whole volume's there to imageLoad and imageStore.
+		glBindImageTexture(unit, mRendererID, 0, GL_TRUE, 0, glAccess, mInternalFormat);
+	}
+}; // namespace Aulys
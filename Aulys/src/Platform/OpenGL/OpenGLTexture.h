@@ -8,7 +8,7 @@ namespace Aulys
 	{
 	public:
 		OpenGLTexture2D(const Path& path);
-		OpenGLTexture2D(int width, int height);
+		OpenGLTexture2D(int width, int height, TextureFormat format = TextureFormat::RGB8);
 		virtual ~OpenGLTexture2D();
 
 		virtual explicit operator int() const override { return mRendererID; };
@@ -16,11 +16,35 @@ namespace Aulys
 		virtual uint32_t getHeight() const override { return mHeight; };
 
 		virtual void bind(uint32_t slot = 0) const override;
+		virtual void bindImage(uint32_t unit, Access access) const override;
 	private:
 		Path mPath;  // Might be useful for debugging, and hot reloading textures
 		             // Though it might later move into a resource manager, is iffy here.
 		uint32_t mWidth, mHeight;
+		uint32_t mInternalFormat = 0; // e.g. GL_RGBA8, which bindImage has to repeat back to GL.
 		uint32_t mRendererID = 0;
 	}; // class OpenGLTexture2D : public Texture2D
 
+	class OpenGLTexture3D : public Texture3D
+	{
+	public:
+		OpenGLTexture3D(int width, int height, int depth, TextureFormat format = TextureFormat::R32F);
+		virtual ~OpenGLTexture3D();
+
+		virtual explicit operator int() const override { return mRendererID; };
+		virtual uint32_t getWidth() const override { return mWidth; };
+		virtual uint32_t getHeight() const override { return mHeight; };
+		virtual uint32_t getDepth() const override { return mDepth; };
+
+		virtual void setData(const void* data, uint32_t size) override;
+
+		virtual void bind(uint32_t slot = 0) const override;
+		virtual void bindImage(uint32_t unit, Access access) const override;
+	private:
+		uint32_t mWidth, mHeight, mDepth;
+		TextureFormat mFormat;
+		uint32_t mInternalFormat = 0;
+		uint32_t mRendererID = 0;
+	}; // class OpenGLTexture3D : public Texture3D
+
 }; // namespace Aulys
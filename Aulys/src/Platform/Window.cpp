@@ -13,9 +13,14 @@ namespace Aulys {
 
 #elif AU_PLATFORM_LINUX
 #include "Platform/Linux/LinuxWindow.h"
+#include "Platform/Headless/HeadlessWindow.h"
 
 namespace Aulys {
 	Uni<Window> Window::Create(const WindowProps& props) {
+		const HeadlessProps headless = HeadlessWindow::fromEnvironment(props.headless);
+		if (headless.enabled) {
+			return std::make_unique<HeadlessWindow>(props, headless);
+		}
 		return std::unique_ptr<Window>( (Window*)(new LinuxWindow(props)) );
 	}
 } // namespace Aulys
@@ -8,10 +8,22 @@
 namespace Aulys
 {
 
+	// For rendering without a display, see HeadlessWindow.h. Every field can also be set from the
+	// environment, which wins over what's here: AULYS_HEADLESS=1, AULYS_HEADLESS_FRAMES,
+	// AULYS_HEADLESS_OUT and AULYS_HEADLESS_DUMP_EVERY.
+	struct HeadlessProps
+	{
+		bool enabled = false;
+		uint32_t frames = 0; // Closes the window after this many frames. 0 runs until something else does.
+		std::string outputDir = "headless"; // Where the frames and timing.json go.
+		uint32_t dumpEvery = 0; // Dump every n-th frame as well as the last. 0 only dumps the last.
+	}; // struct HeadlessProps
+
 	struct WindowProps
 	{
 		std::string title;
 		unsigned int width, height;
+		HeadlessProps headless{};
 
 		WindowProps(const std::string& Title = "Aulys Engine! Eat your veggies.",
 					unsigned int Width = 1920, unsigned int Height = 1080) // Changed to 1920x1080
@@ -27,7 +39,11 @@ namespace Aulys
 	public:
 		virtual ~Window() = default;
 
+		// Swaps the buffers, then polls for events. The two halves are below, for main loops that
+		// want to poll at some other point of the frame (see FramePacer).
 		virtual void onUpdate() = 0;
+		virtual void swapBuffers() = 0;
+		virtual void pollEvents() = 0;
 
 		virtual unsigned int getWidth() const = 0;
 		virtual unsigned int getHeight() const = 0;
@@ -37,7 +53,9 @@ namespace Aulys
 		virtual void setEventCallback(const std::function<void(Event&)> callback) = 0;
 		virtual void setVSync(bool enabled) = 0;
 		virtual bool isVSync() const = 0;
-		virtual Timestep calculateDeltaTime(float& lastFrameTime) const = 0;
+		// Of the monitor the window is on, in Hz. 0 if it couldn't be found out.
+		virtual float getRefreshRate() const = 0;
+		virtual Timestep calculateDeltaTime(FrameClock::time_point& lastFrameTime) const = 0;
 
 		static Uni<Window> Create(const WindowProps& props = WindowProps());
 
@@ -20,6 +20,8 @@ namespace Aulys
 		virtual ~WindowsWindow() = default;
 
 		void onUpdate() override;
+		void swapBuffers() override;
+		void pollEvents() override;
 
 		inline unsigned int getWidth() const override { return mData.width; };
 		inline unsigned int getHeight() const override { return mData.height; };
@@ -32,7 +34,8 @@ namespace Aulys
 
 		void setVSync(bool enabled) override;
 		bool isVSync() const override;
-		Timestep calculateDeltaTime(float& lastFrameTime) const override;
+		float getRefreshRate() const override;
+		Timestep calculateDeltaTime(FrameClock::time_point& lastFrameTime) const override;
 
         void* getNativeWindow() const override { return this->mWindow; };
 
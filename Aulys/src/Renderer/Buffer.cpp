@@ -45,4 +45,40 @@ namespace Aulys
 		}
 	};
 
+	Ref<UniformBuffer> UniformBuffer::create(uint32_t size, uint32_t binding){
+		switch (Renderer::getAPI()){
+			case RendererAPI::API::None:
+			{
+				AU_CORE_ASSERT(false, "Error from UniformBuffer::create: RenderAPI::None is not supported!");
+				return nullptr;
+			}
+			case RendererAPI::API::OpenGL:
+			{
+				return std::make_shared<OpenGLUniformBuffer>(size, binding);
+			}
+			default:
+				AU_CORE_ASSERT(false, "sAPI, instantiated in RendererAPI.cpp (retrieved by "
+						"Renderer::getAPI()) is set to an unknown value.");
+				return nullptr;
+		}
+	};
+
+	Ref<ShaderStorageBuffer> ShaderStorageBuffer::create(uint32_t size, uint32_t binding){
+		switch (Renderer::getAPI()){
+			case RendererAPI::API::None:
+			{
+				AU_CORE_ASSERT(false, "Error from ShaderStorageBuffer::create: RenderAPI::None is not supported!");
+				return nullptr;
+			}
+			case RendererAPI::API::OpenGL:
+			{
+				return std::make_shared<OpenGLShaderStorageBuffer>(size, binding);
+			}
+			default:
+				AU_CORE_ASSERT(false, "sAPI, instantiated in RendererAPI.cpp (retrieved by "
+						"Renderer::getAPI()) is set to an unknown value.");
+				return nullptr;
+		}
+	};
+
 }; // namespace Aulys
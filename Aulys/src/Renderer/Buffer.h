@@ -178,4 +178,59 @@ namespace Aulys
 	private:
 	
 	}; // class IndexBuffer
+
+	// A block of memory the shaders read as a uniform block, so that a whole set of uniforms can be
+	// written at once instead of one upload each. The layout is up to whoever fills it, and has to
+	// match the block's declaration in the shader (std140, normally).
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() {};
+
+		// Writes size bytes from data at offset into the buffer.
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		virtual uint32_t getSize() const = 0;
+		// The binding point it's attached to - see Shader::setUniformBlockBinding.
+		virtual uint32_t getBinding() const = 0;
+
+		/* Creates a zeroed buffer of size bytes, and attaches it to binding for good. */
+		static Ref<UniformBuffer> create(uint32_t size, uint32_t binding);
+	private:
+
+	}; // class UniformBuffer
+
+	// Like a UniformBuffer, but shaders can write to it too (a `buffer` block, std430 normally), and
+	// it can be much bigger - so it's how a shader hands results back to us.
+	class ShaderStorageBuffer
+	{
+	public:
+		virtual ~ShaderStorageBuffer() {};
+
+		// Writes size bytes from data at offset into the buffer.
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		// Reads size bytes at offset back into data. If the GPU is still writing to it, this waits
+		// for it to finish, so read what it wrote a frame or more ago if you can.
+		virtual void getData(void* data, uint32_t size, uint32_t offset = 0) const = 0;
+		// Zeroes the whole buffer, without sending any zeroes over.
+		virtual void clear() = 0;
+
+		// Attaches it to its binding again - for when a few buffers take turns at one binding.
+		virtual void bind() const = 0;
+		// Marks everything sent to the GPU so far, so isReady can say when it's all done. Call it
+		// once whatever writes to the buffer has been drawn or dispatched.
+		virtual void fence() = 0;
+		// Has the GPU finished everything up to the last fence? If so, getData won't wait. Never
+		// waits itself, and is true if there's no fence.
+		virtual bool isReady() const = 0;
+
+		virtual uint32_t getSize() const = 0;
+		// The binding point it's attached to (layout(binding = n) in the shader).
+		virtual uint32_t getBinding() const = 0;
+
+		/* Creates a zeroed buffer of size bytes, and attaches it to binding. */
+		static Ref<ShaderStorageBuffer> create(uint32_t size, uint32_t binding);
+	private:
+
+	}; // class ShaderStorageBuffer
 }; // namespace Aulys
@@ -8,7 +8,10 @@ namespace Aulys
 	{
 	public:
 		static Ref<FrameBuffer> create();
-		virtual void attachTexture(Ref<Texture2D> texture) = 0;
+		// Renders colour output `slot` (layout(location = slot) in the fragment shader) into texture.
+		// Everything attached is drawn to, in slot order.
+		virtual void attachTexture(Ref<Texture2D> texture, uint32_t slot = 0) = 0;
+		virtual void detachTexture(uint32_t slot) = 0;
 		virtual void bind() noexcept = 0;
 		virtual void unbind() noexcept = 0;
 
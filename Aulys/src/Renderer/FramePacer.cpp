@@ -0,0 +1,151 @@
+#include "src/pch.h"
+
+#include "Renderer/FramePacer.h"
+
+#include "Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLFramePacer.h"
+
+#include <thread>
+
+namespace Aulys
+{
+	namespace {
+		// A wait shorter than this didn't really block, so it tells us nothing about the vsync.
+		constexpr FrameClock::duration sBlockedThreshold = std::chrono::microseconds(250);
+
+		// Exponential moving average, roughly over the last 20 frames.
+		void smooth(float& averageMs, FrameClock::duration d) {
+			const float ms = std::chrono::duration<float, std::milli>(d).count();
+			averageMs += (ms - averageMs) * 0.05f;
+		}
+	};
+
+	Uni<FramePacer> FramePacer::create() {
+		switch(Renderer::getAPI()){
+			case RendererAPI::API::None:
+			{
+				AU_CORE_ASSERT(false, "[FramePacer::create]: RenderAPI::None is not supported!"
+						" (retrieved from Renderer::getAPI())");
+				return nullptr;
+			}
+			case RendererAPI::API::OpenGL:
+			{
+				return std::make_unique<OpenGLFramePacer>();
+			}
+			default:
+				AU_CORE_ASSERT(false, "[FramePacer::create]: sRenderAPI"
+					" (retrieved from Renderer::getAPI()) is set to an unknown value"
+					" (RendererAPI::API enum cast to int) ({0}).",
+					(int) Renderer::getAPI());
+				return nullptr;
+		}
+	};
+
+	void FramePacer::beginFrame() {
+		const FrameClock::time_point now = FrameClock::now();
+
+		// Only with vsync is there a deadline to aim for, and only once we've seen one flip.
+		if (mSettings.lowLatency && mVsync && mVsyncPeriod > FrameClock::duration::zero()
+			&& mVsyncPhase != FrameClock::time_point{}) {
+			// CPU and GPU overlap, so adding them up overestimates the frame - which is the safe
+			// side to be wrong on, missing the vsync costs a whole refresh.
+			const FrameClock::duration work = *std::max_element(mCpuHistory.begin(), mCpuHistory.end())
+			                                + *std::max_element(mGpuHistory.begin(), mGpuHistory.end());
+			const auto margin = std::chrono::duration_cast<FrameClock::duration>(
+				std::chrono::duration<float, std::milli>(mSettings.marginMs));
+
+			const FrameClock::time_point wake = nextVsyncAfter(now + work + margin) - work - margin;
+			if (wake > now) {
+				sleepUntil(wake);
+			}
+		}
+
+		mFrameStart = FrameClock::now();
+		smooth(mStats.sleepMs, mFrameStart - now);
+		if (mLastFrameStart != FrameClock::time_point{}) {
+			smooth(mStats.frameMs, mFrameStart - mLastFrameStart);
+		}
+		mLastFrameStart = mFrameStart;
+		// The caller polls input right after this.
+		mInputTimes[mFrame % sMaxFramesInFlight] = mFrameStart;
+
+		beginGpuFrame(mFrame);
+	};
+
+	void FramePacer::present(Window& window) {
+		const FrameClock::duration cpuTime = FrameClock::now() - mFrameStart;
+		mCpuHistory[mFrame % sWorkHistory] = cpuTime;
+		smooth(mStats.cpuMs, cpuTime);
+
+		endGpuFrame(mFrame);
+
+		const FrameClock::time_point swapStart = FrameClock::now();
+		window.swapBuffers();
+		const FrameClock::time_point swapEnd = FrameClock::now();
+
+		mVsync = window.isVSync();
+		mStats.refreshRate = window.getRefreshRate();
+		mVsyncPeriod = mStats.refreshRate > 0.0f ? std::chrono::duration_cast<FrameClock::duration>(
+			std::chrono::duration<float>(1.0f / mStats.refreshRate)) : FrameClock::duration::zero();
+		// A swap that blocked was waiting for a flip to free up a buffer.
+		if (mVsync && swapEnd - swapStart > sBlockedThreshold) {
+			mVsyncPhase = swapEnd;
+		}
+
+		if (mSettings.lowLatency) {
+			const FrameClock::duration waited = throttle(mSettings.maxQueuedFrames, mSettings.useFinish);
+			smooth(mStats.throttleMs, waited);
+			if (mVsync && waited > sBlockedThreshold) {
+				mVsyncPhase = FrameClock::now();
+			}
+		}
+		else {
+			smooth(mStats.throttleMs, FrameClock::duration::zero());
+		}
+
+		collectGpuFrames();
+		mStats.frame = mFrame;
+		mFrame++;
+	};
+
+	void FramePacer::onGpuFrameDone(uint64_t frame, FrameClock::duration gpuTime, FrameClock::time_point gpuDone) {
+		mGpuHistory[frame % sWorkHistory] = gpuTime;
+		smooth(mStats.gpuMs, gpuTime);
+
+		// The CPU time is still in the history, as long as the API part isn't very late.
+		if (mFrameListener && frame + sWorkHistory > mFrame) {
+			mFrameListener({ frame, std::chrono::duration<float, std::milli>(mCpuHistory[frame % sWorkHistory]).count(),
+			                 std::chrono::duration<float, std::milli>(gpuTime).count() });
+		}
+
+		// The input time of this frame has been overwritten already - the API part was too late.
+		if (frame + sMaxFramesInFlight <= mFrame) {
+			return;
+		}
+		const bool knowVsync = mVsync && mVsyncPeriod > FrameClock::duration::zero()
+		                       && mVsyncPhase != FrameClock::time_point{};
+		const FrameClock::time_point onScreen = knowVsync ? nextVsyncAfter(gpuDone) : gpuDone;
+		smooth(mStats.latencyMs, onScreen - mInputTimes[frame % sMaxFramesInFlight]);
+	};
+
+	FrameClock::time_point FramePacer::nextVsyncAfter(FrameClock::time_point t) const {
+		// Division truncates towards zero, which for t before the phase is already the vsync after.
+		auto n = (t - mVsyncPhase) / mVsyncPeriod;
+		if (mVsyncPhase + n * mVsyncPeriod < t) {
+			n++;
+		}
+		return mVsyncPhase + n * mVsyncPeriod;
+	};
+
+	// sleep_until overshoots by anything up to a scheduler tick, so the last millisecond is spent
+	// yielding instead.
+	void FramePacer::sleepUntil(FrameClock::time_point t) const {
+		const FrameClock::time_point coarse = t - std::chrono::milliseconds(1);
+		if (coarse > FrameClock::now()) {
+			std::this_thread::sleep_until(coarse);
+		}
+		while (FrameClock::now() < t) {
+			std::this_thread::yield();
+		}
+	};
+}; // namespace Aulys
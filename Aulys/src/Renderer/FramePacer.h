@@ -0,0 +1,126 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Core/Timestep.h"
+#include "Platform/Window.h"
+
+#include <array>
+
+namespace Aulys
+{
+	// What FramePacer measured. The *Ms members are smoothed over the last few dozen frames, so they
+	// can be shown in the UI as they are.
+	struct FrameStats
+	{
+		float frameMs = 0.0f; // From one beginFrame to the next.
+		float cpuMs = 0.0f; // From beginFrame to present, without the time spent sleeping.
+		float gpuMs = 0.0f; // From the first to the last command of the frame executing on the GPU.
+		float sleepMs = 0.0f; // How long beginFrame waited for the deadline.
+		float throttleMs = 0.0f; // How long present waited for the GPU to catch up.
+		// From polling input to the frame being on the screen (the vsync after the GPU finished it).
+		// This is an estimate: we know when the GPU is done, but not exactly when the display flips.
+		float latencyMs = 0.0f;
+		float refreshRate = 0.0f;
+		uint64_t frame = 0;
+	}; // struct FrameStats
+
+	// One frame's times as they were, not smoothed - for recording every frame rather than showing
+	// them (see FramePacer::setFrameListener).
+	struct FrameTimes
+	{
+		uint64_t frame = 0;
+		float cpuMs = 0.0f;
+		float gpuMs = 0.0f;
+	}; // struct FrameTimes
+
+	/* Paces the main loop for low input latency. A frame goes:
+	 *
+	 *     framePacer->beginFrame();      // Sleeps until the last moment the frame can start at.
+	 *     window->pollEvents();          // Input is as fresh as it can be...
+	 *     ... update, render, ImGui ...
+	 *     framePacer->present(*window);  // ...and gets onto the screen at the very next vsync.
+	 *
+	 * With lowLatency off (the default), neither of them waits - they just measure, which gives the
+	 * same frames as Window::onUpdate did, and the stats.
+	 *
+	 * With it on, the CPU isn't allowed to run more than maxQueuedFrames frames ahead of the GPU
+	 * (each queued frame is a refresh of latency), and with vsync on, beginFrame predicts the next
+	 * vsync and sleeps until (vsync - the recent worst frame time - margin), instead of starting
+	 * right after the last swap and then waiting for a vsync with input that's a frame old.
+	 *
+	 * The GPU side (timer queries, fences) is up to the renderer API, see OpenGLFramePacer. */
+	class FramePacer
+	{
+	public:
+		struct Settings
+		{
+			bool lowLatency = false;
+			// Frames the CPU may submit before the GPU has finished the oldest. 0 waits for every
+			// frame to finish before starting the next, the lowest latency but no CPU/GPU overlap.
+			uint32_t maxQueuedFrames = 1;
+			// Throttle with glFinish (or the API's equivalent) instead of fences. Some drivers only
+			// really let go of a frame on a finish.
+			bool useFinish = false;
+			// How much earlier than strictly predicted a frame starts, to absorb the frame time
+			// varying and the sleep overshooting.
+			float marginMs = 1.5f;
+		}; // struct Settings
+
+		static Uni<FramePacer> create();
+		virtual ~FramePacer() = default;
+
+		void beginFrame();
+		void present(Window& window);
+
+		inline Settings& getSettings() { return mSettings; };
+		inline const FrameStats& getStats() const { return mStats; };
+		// The frame between beginFrame and present, numbered as FrameTimes are.
+		inline uint64_t getFrame() const { return mFrame; };
+		// Called with each frame's FrameTimes once the GPU has finished it, which is a few frames
+		// after its present. Frames the API part couldn't time on the GPU don't get reported.
+		inline void setFrameListener(std::function<void(const FrameTimes&)> listener) {
+			mFrameListener = std::move(listener);
+		};
+
+	protected:
+		// Everything the API specific part has to do. Frames are numbered from 0, one per
+		// beginFrame/present pair.
+		virtual void beginGpuFrame(uint64_t frame) = 0;
+		virtual void endGpuFrame(uint64_t frame) = 0; // Right before the swap.
+		// Right after the swap: wait until at most `maxQueued` frames are still being worked on.
+		// Returns how long that took.
+		virtual FrameClock::duration throttle(uint32_t maxQueued, bool useFinish) = 0;
+		// Report finished frames through onGpuFrameDone, without waiting for unfinished ones.
+		virtual void collectGpuFrames() = 0;
+
+		// `gpuDone` is when the GPU finished the frame, converted to our clock.
+		void onGpuFrameDone(uint64_t frame, FrameClock::duration gpuTime, FrameClock::time_point gpuDone);
+
+		// How many frames the API part may have in flight before it must have reported the oldest.
+		static constexpr uint32_t sMaxFramesInFlight = 8;
+	private:
+		FrameClock::time_point nextVsyncAfter(FrameClock::time_point t) const;
+		void sleepUntil(FrameClock::time_point t) const;
+
+		Settings mSettings;
+		FrameStats mStats;
+		std::function<void(const FrameTimes&)> mFrameListener;
+
+		uint64_t mFrame = 0;
+		FrameClock::time_point mFrameStart;
+		FrameClock::time_point mLastFrameStart;
+		std::array<FrameClock::time_point, sMaxFramesInFlight> mInputTimes;
+
+		// The vsync grid: mVsyncPeriod apart, one of them at mVsyncPhase. Found from the refresh
+		// rate and from when the swap or the throttling blocks, which then return right at a flip.
+		FrameClock::duration mVsyncPeriod = FrameClock::duration::zero();
+		FrameClock::time_point mVsyncPhase;
+		bool mVsync = false;
+
+		// The worst CPU and GPU times of the last sWorkHistory frames - how long we plan a frame to take.
+		static constexpr uint32_t sWorkHistory = 16;
+		std::array<FrameClock::duration, sWorkHistory> mCpuHistory{};
+		std::array<FrameClock::duration, sWorkHistory> mGpuHistory{};
+	}; // class FramePacer
+}; // namespace Aulys
@@ -20,6 +20,9 @@ namespace Aulys
 		inline static void drawIndexed(const Ref<VertexArray>& vertexArray) {
 			sRendererAPI->drawIndexed(vertexArray);
 		}
+		inline static void dispatchCompute(uint32_t x, uint32_t y = 1, uint32_t z = 1) {
+			sRendererAPI->dispatchCompute(x, y, z);
+		}
 	private:
 		static RendererAPI* sRendererAPI;
 	}; // class RenderCommand
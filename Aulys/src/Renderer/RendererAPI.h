@@ -21,6 +21,9 @@ namespace Aulys
 		virtual void clear() = 0;
 
 		virtual void drawIndexed(const std::shared_ptr<VertexArray>& vertexArray) = 0;
+		// Runs the bound compute shader over x * y * z work groups. Anything drawn or dispatched
+		// afterwards sees what it wrote.
+		virtual void dispatchCompute(uint32_t x, uint32_t y, uint32_t z) = 0;
 
 		static inline API getAPI() { return sAPI; };
 	private:
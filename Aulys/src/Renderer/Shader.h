@@ -64,10 +64,21 @@ namespace Aulys
 		}
 		virtual void uploadUniformFloat(const std::string& name, const float value) = 0;
 		virtual void uploadUniformInt(const std::string& name, const int value) = 0;
+		virtual void uploadUniformInt(const std::string& name, uint32_t count, const int* values) = 0;
 		virtual void uploadUniformInt2(const std::string& name, const int value[2]) = 0;
 		
 		virtual void uploadUniformBool(const std::string& name, const bool value) = 0;
 		virtual void uploadUniform2Bool(const std::string& name, const bool value[2]) = 0;
+
+		// Reads the uniform block called name from the UniformBuffer attached to binding. This
+		// sticks across recompiles (e.g. setTag), unlike the uploads above.
+		virtual void setUniformBlockBinding(const std::string& name, uint32_t binding) = 0;
+
+		// Gives this shader every uniform value and block binding source has been given, for two
+		// programs declaring the same uniforms (e.g. a fragment and a compute version of the same
+		// thing), so only one of them has to be kept up to date. Only what's changed since the last
+		// copy gets uploaded. Binds this shader; source has to be the same kind of shader.
+		virtual void copyUniformsFrom(const Shader& source) = 0;
 	private:
 
 	}; // class Shader
@@ -35,7 +35,7 @@ namespace Aulys
 		return nullptr;
 	};
 
-	Ref<Texture2D> Texture2D::create(int width, int height) {
+	Ref<Texture2D> Texture2D::create(int width, int height, TextureFormat format) {
 		switch (Renderer::getAPI()) {
 			case RendererAPI::API::None:
 			{
@@ -45,7 +45,7 @@ namespace Aulys
 			case RendererAPI::API::OpenGL:
 			{
 				try {
-					return std::make_shared<OpenGLTexture2D>(width, height);
+					return std::make_shared<OpenGLTexture2D>(width, height, format);
 				}
 				catch(std::exception& e) {
 					AU_LOG_ERROR("Failed to create OpenGL Texture2D (width={0}, height={1}. Caught exception:\n{2}", width, height, e.what());
@@ -56,5 +56,22 @@ namespace Aulys
 		AU_CORE_ASSERT(false, "[Texture2D::create] RendererAPI not found.");
 		return nullptr;
 	};
+
+	Ref<Texture3D> Texture3D::create(int width, int height, int depth, TextureFormat format) {
+		switch (Renderer::getAPI()) {
+			case RendererAPI::API::None:
+			{
+				 AU_CORE_ASSERT(false, "[Texture3D::create] RendererAPI::None isn't supported.");
+				 return nullptr;
+			}
+			case RendererAPI::API::OpenGL:
+			{
+				// No error texture to fall back on for a volume, so a failure's left to the caller.
+				return std::make_shared<OpenGLTexture3D>(width, height, depth, format);
+			}
+		}
+		AU_CORE_ASSERT(false, "[Texture3D::create] RendererAPI not found.");
+		return nullptr;
+	};
 }; // namespace Aulys
 
@@ -4,9 +4,23 @@
 
 namespace Aulys 
 {
+	// What each texel of a texture made with Texture2D::create(width, height, format) (or
+	// Texture3D::create) holds. The integer ones can't be filtered, so they're only any good as
+	// render targets and images.
+	enum class TextureFormat
+	{
+		RGB8, RGBA8, RGBA32UI, R32F
+	}; // enum class TextureFormat
+
 	class Texture 
 	{
 	public:
+		// How a shader may use a texture bound with bindImage.
+		enum class Access
+		{
+			ReadOnly, WriteOnly, ReadWrite
+		}; // enum class Access
+
 		virtual ~Texture() = default;
 
 		virtual explicit operator int() const = 0;
@@ -16,6 +30,9 @@ namespace Aulys
 		virtual uint32_t getHeight() const = 0;
 
 		virtual void bind(uint32_t slot = 0) const = 0;
+		// Binds it for image loads and stores (imageLoad, imageStore) instead of sampling, which is
+		// how a compute shader writes to a texture.
+		virtual void bindImage(uint32_t unit, Access access) const = 0;
 	private:
 	
 	}; // class Texture
@@ -24,12 +41,27 @@ namespace Aulys
 	{
 	public:
 		static Ref<Texture2D> create(const Path& path);
-		static Ref<Texture2D> create(int width, int height);
-		static Ref<Texture2D> create(glm::vec2 size) {
-			return Texture2D::create(size.x, size.y);
+		static Ref<Texture2D> create(int width, int height, TextureFormat format = TextureFormat::RGB8);
+		static Ref<Texture2D> create(glm::vec2 size, TextureFormat format = TextureFormat::RGB8) {
+			return Texture2D::create(size.x, size.y, format);
 		};
 	private:
 	
 	}; // class Texture2D : public Texture
 
+	// A volume, sampled with a sampler3D - filtered across all three axes, and clamped at the edges.
+	class Texture3D : public Texture
+	{
+	public:
+		static Ref<Texture3D> create(int width, int height, int depth, TextureFormat format = TextureFormat::R32F);
+
+		virtual uint32_t getDepth() const = 0;
+
+		// Replaces every texel: x fastest, then y, then z, in the format's own layout (floats for
+		// R32F). size is in bytes, and has to be the whole volume.
+		virtual void setData(const void* data, uint32_t size) = 0;
+	private:
+
+	}; // class Texture3D : public Texture
+
 }; // namespace Aulys
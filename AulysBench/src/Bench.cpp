@@ -0,0 +1,394 @@
+/* AulysBench - micro-benchmarks for the engine's and the Sandbox's hot paths on the CPU. Needs no
+ * window and no GL context.
+ *
+ * Usage: AulysBench [--filter=<substring>] [--min-time=<seconds>] [--repetitions=<n>]
+ *                   [--out=<file.json>] [--label=<text>] [--list]
+ *
+ *   --filter       Only run the benchmarks whose name (e.g. "BM_GramSchmidt/2") contains this.
+ *   --min-time     How long each run should take at least, 0.05s by default. The iteration count is
+ *                  worked out from this, like Google Benchmark does.
+ *   --repetitions  How many runs to do of each, 5 by default.
+ *   --out          Where the JSON goes. stdout by default - the progress table goes to stderr.
+ *   --label        Goes into the JSON's "context", e.g. `--label=$(git rev-parse --short HEAD)`.
+ *   --list         Print the names and quit.
+ *
+ * Run it from the project root (like Sandbox), so the shader benchmarks can find
+ * Sandbox/assets/shaders. To compare two commits, keep the JSON of both and diff them with Google
+ * Benchmark's tools/compare.py: `compare.py benchmarks old.json new.json`. */
+
+#include "Bench.h"
+
+#include "../../AulysConf.h"
+#include "Log/Log.h"
+
+#include <spdlog/sinks/null_sink.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef AU_PLATFORM_LINUX
+	#include <unistd.h>
+#endif
+
+namespace Bench
+{
+	namespace
+	{
+		double realNow() {
+			return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		double cpuNow() {
+			return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+		}
+
+		struct Options
+		{
+			std::string filter{};
+			double minTime = 0.05;
+			int repetitions = 5;
+			std::string out{};
+			std::string label{};
+			bool list = false;
+		}; // struct Options
+
+		struct Run
+		{
+			uint64_t iterations;
+			double realNs; // Per iteration.
+			double cpuNs;
+			double itemsPerSecond;
+			std::string label;
+		}; // struct Run
+
+		struct Result
+		{
+			std::string name;
+			std::vector<Run> runs;
+			std::string error;
+		}; // struct Result
+
+		std::string escape(const std::string& s) {
+			std::string out;
+			for (char c : s) {
+				switch (c) {
+					case '"':  out += "\\\""; break;
+					case '\\': out += "\\\\"; break;
+					case '\n': out += "\\n"; break;
+					case '\t': out += "\\t"; break;
+					default:
+						if (static_cast<unsigned char>(c) < 0x20) {
+							char buf[8];
+							std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+							out += buf;
+						}
+						else {
+							out += c;
+						}
+				}
+			}
+			return out;
+		}
+
+		Run runOnce(const Function& fn, uint64_t iterations, int64_t arg, std::string& error) {
+			State state(iterations, arg);
+			fn(state);
+			error = state.error();
+			const double n = static_cast<double>(iterations);
+			return { iterations, state.realSeconds() * 1e9 / n, state.cpuSeconds() * 1e9 / n,
+			         state.realSeconds() > 0 ? state.itemsProcessed() / state.realSeconds() : 0.0,
+			         state.label() };
+		}
+
+		Result runBenchmark(const std::string& name, const Function& fn, int64_t arg, const Options& options) {
+			Result result{ name, {}, {} };
+
+			// Grow the iteration count until a run takes min-time, aiming a little over so the last
+			// guess usually makes it - the run that does is the first repetition.
+			uint64_t iterations = 1;
+			Run run{};
+			while (true) {
+				run = runOnce(fn, iterations, arg, result.error);
+				if (!result.error.empty()) {
+					return result;
+				}
+				const double seconds = run.realNs * iterations * 1e-9;
+				if (seconds >= options.minTime || iterations >= 1000000000) {
+					break;
+				}
+				const double multiplier = seconds / options.minTime > 0.1 ?
+					std::min(10.0, options.minTime * 1.4 / std::max(seconds, 1e-9)) : 10.0;
+				iterations = std::max(static_cast<uint64_t>(iterations * multiplier), iterations + 1);
+			}
+
+			result.runs.push_back(run);
+			for (int i = 1; i < options.repetitions; i++) {
+				result.runs.push_back(runOnce(fn, iterations, arg, result.error));
+			}
+			return result;
+		}
+
+		void writeRun(std::ostream& os, const std::string& name, const std::string& runName,
+				const char* runType, const Run& run, int index, const char* aggregate, bool& first) {
+			os << (first ? "" : ",\n") << "    {\n"
+			   << "      \"name\": \"" << escape(name) << "\",\n"
+			   << "      \"run_name\": \"" << escape(runName) << "\",\n"
+			   << "      \"run_type\": \"" << runType << "\",\n";
+			if (aggregate) {
+				os << "      \"aggregate_name\": \"" << aggregate << "\",\n";
+			}
+			else {
+				os << "      \"repetition_index\": " << index << ",\n";
+			}
+			os << "      \"iterations\": " << run.iterations << ",\n"
+			   << "      \"real_time\": " << run.realNs << ",\n"
+			   << "      \"cpu_time\": " << run.cpuNs << ",\n"
+			   << "      \"time_unit\": \"ns\"";
+			if (run.itemsPerSecond > 0) {
+				os << ",\n      \"items_per_second\": " << run.itemsPerSecond;
+			}
+			if (!run.label.empty()) {
+				os << ",\n      \"label\": \"" << escape(run.label) << "\"";
+			}
+			os << "\n    }";
+			first = false;
+		}
+
+		void writeJson(std::ostream& os, const std::vector<Result>& results, const Options& options,
+				const char* executable) {
+			char date[64] = "";
+			const std::time_t now = std::time(nullptr);
+			std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+			char host[256] = "";
+#ifdef AU_PLATFORM_LINUX
+			gethostname(host, sizeof(host) - 1);
+#endif
+
+#ifdef AU_DEBUG
+			const char* buildType = "debug";
+#else
+			const char* buildType = "release";
+#endif
+
+			os.precision(6);
+			os << std::fixed;
+			os << "{\n  \"context\": {\n"
+			   << "    \"date\": \"" << date << "\",\n"
+			   << "    \"host_name\": \"" << escape(host) << "\",\n"
+			   << "    \"executable\": \"" << escape(executable) << "\",\n"
+			   << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+			   << "    \"library_build_type\": \"" << buildType << "\",\n"
+			   << "    \"min_time\": " << options.minTime << ",\n"
+			   << "    \"repetitions\": " << options.repetitions << ",\n"
+			   << "    \"label\": \"" << escape(options.label) << "\"\n"
+			   << "  },\n  \"benchmarks\": [\n";
+
+			bool first = true;
+			for (const auto& result : results) {
+				if (!result.error.empty()) {
+					os << (first ? "" : ",\n") << "    {\n"
+					   << "      \"name\": \"" << escape(result.name) << "\",\n"
+					   << "      \"run_name\": \"" << escape(result.name) << "\",\n"
+					   << "      \"run_type\": \"iteration\",\n"
+					   << "      \"error_occurred\": true,\n"
+					   << "      \"error_message\": \"" << escape(result.error) << "\"\n    }";
+					first = false;
+					continue;
+				}
+
+				for (size_t i = 0; i < result.runs.size(); i++) {
+					writeRun(os, result.name, result.name, "iteration", result.runs[i], static_cast<int>(i),
+							nullptr, first);
+				}
+
+				// The aggregates, over the repetitions.
+				std::vector<double> real, cpu;
+				for (const auto& run : result.runs) {
+					real.push_back(run.realNs);
+					cpu.push_back(run.cpuNs);
+				}
+				const double n = static_cast<double>(real.size());
+				auto mean = [n](const std::vector<double>& v) {
+					double sum = 0; for (double x : v) sum += x; return sum / n;
+				};
+				auto median = [](std::vector<double> v) {
+					std::sort(v.begin(), v.end());
+					return v.size() % 2 ? v[v.size() / 2] : 0.5 * (v[v.size() / 2 - 1] + v[v.size() / 2]);
+				};
+				auto stddev = [&](const std::vector<double>& v) {
+					if (v.size() < 2) return 0.0;
+					const double m = mean(v);
+					double sum = 0; for (double x : v) sum += (x - m) * (x - m);
+					return std::sqrt(sum / (n - 1));
+				};
+
+				Run aggregate = result.runs.front();
+				aggregate.itemsPerSecond = 0;
+				aggregate.realNs = mean(real); aggregate.cpuNs = mean(cpu);
+				writeRun(os, result.name + "_mean", result.name, "aggregate", aggregate, 0, "mean", first);
+				aggregate.realNs = median(real); aggregate.cpuNs = median(cpu);
+				writeRun(os, result.name + "_median", result.name, "aggregate", aggregate, 0, "median", first);
+				aggregate.realNs = *std::min_element(real.begin(), real.end());
+				aggregate.cpuNs = *std::min_element(cpu.begin(), cpu.end());
+				writeRun(os, result.name + "_min", result.name, "aggregate", aggregate, 0, "min", first);
+				aggregate.realNs = stddev(real); aggregate.cpuNs = stddev(cpu);
+				writeRun(os, result.name + "_stddev", result.name, "aggregate", aggregate, 0, "stddev", first);
+			}
+			os << "\n  ]\n}\n";
+		}
+
+		bool parseOption(const char* argument, const char* name, std::string& value) {
+			const size_t length = std::strlen(name);
+			if (std::strncmp(argument, name, length) == 0 && argument[length] == '=') {
+				value = argument + length + 1;
+				return true;
+			}
+			return false;
+		}
+
+		// The engine's loggers write to the console, which would end up in the middle of the JSON.
+		// Swap them for ones with the same levels and patterns that throw everything away - the Log
+		// benchmarks still pay for the formatting, just not for the I/O.
+		void silenceLogs() {
+			const auto level = static_cast<spdlog::level::level_enum>(AU_LOG_ACTIVE_LEVEL);
+			auto sink = std::make_shared<spdlog::sinks::null_sink_mt>();
+			auto makeLogger = [&](const char* name, const char* pattern) {
+				auto logger = std::make_shared<spdlog::logger>(name, sink);
+				logger->set_level(level);
+				logger->set_pattern(pattern);
+				return logger;
+			};
+			Aulys::Log::mCoreLogset = std::make_shared<Aulys::Logset>(
+				makeLogger(LOGGING_CORE_HEADER_NAME, LOGGING_CORE_HEADER_PATTERN),
+				makeLogger(LOGGING_CORE_LOGGER_NAME, LOGGING_CORE_LOGGER_PATTERN));
+			Aulys::Log::mClientLogset = std::make_shared<Aulys::Logset>(
+				makeLogger(LOGGING_CLIENT_HEADER_NAME, LOGGING_CLIENT_HEADER_PATTERN),
+				makeLogger(LOGGING_CLIENT_LOGGER_NAME, LOGGING_CLIENT_LOGGER_PATTERN));
+		}
+	}; // namespace
+
+	State::Iterator State::begin() {
+		if (!mError.empty()) {
+			return end();
+		}
+		mRealStart = realNow();
+		mCpuStart = cpuNow();
+		return { this, mIterations };
+	}
+
+	void State::finishTiming() {
+		if (!mError.empty()) {
+			return;
+		}
+		mRealSeconds = realNow() - mRealStart;
+		mCpuSeconds = cpuNow() - mCpuStart;
+	}
+
+	std::vector<Benchmark*>& registeredBenchmarks() {
+		// A function static, so registering from other files' static initialisers is safe.
+		static std::vector<Benchmark*> benchmarks;
+		return benchmarks;
+	}
+
+	Benchmark* registerBenchmark(const std::string& name, Function fn) {
+		registeredBenchmarks().push_back(new Benchmark(name, std::move(fn)));
+		return registeredBenchmarks().back();
+	}
+
+	void useCharPointer(const volatile char*) {}
+}; // namespace Bench
+
+int main(int argc, char** argv)
+{
+	using namespace Bench;
+
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		std::string value;
+		if (parseOption(argv[i], "--filter", value)) {
+			options.filter = value;
+		}
+		else if (parseOption(argv[i], "--min-time", value)) {
+			options.minTime = std::max(std::atof(value.c_str()), 1e-6);
+		}
+		else if (parseOption(argv[i], "--repetitions", value)) {
+			options.repetitions = std::max(std::atoi(value.c_str()), 1);
+		}
+		else if (parseOption(argv[i], "--out", value)) {
+			options.out = value;
+		}
+		else if (parseOption(argv[i], "--label", value)) {
+			options.label = value;
+		}
+		else if (std::strcmp(argv[i], "--list") == 0) {
+			options.list = true;
+		}
+		else {
+			std::cerr << "Unknown argument \"" << argv[i] << "\". Usage: AulysBench [--filter=<substring>]"
+				" [--min-time=<seconds>] [--repetitions=<n>] [--out=<file.json>] [--label=<text>] [--list]\n";
+			return 1;
+		}
+	}
+
+	silenceLogs();
+
+	std::vector<Result> results;
+	for (const Benchmark* benchmark : registeredBenchmarks()) {
+		std::vector<int64_t> args = benchmark->getArgs();
+		const bool hasArgs = !args.empty();
+		if (!hasArgs) {
+			args.push_back(0);
+		}
+
+		for (int64_t arg : args) {
+			const std::string name = hasArgs ? benchmark->getName() + "/" + std::to_string(arg)
+			                                 : benchmark->getName();
+			if (name.find(options.filter) == std::string::npos) {
+				continue;
+			}
+			if (options.list) {
+				std::cout << name << "\n";
+				continue;
+			}
+
+			Result result = runBenchmark(name, benchmark->getFunction(), arg, options);
+			if (!result.error.empty()) {
+				std::fprintf(stderr, "%-48s ERROR: %s\n", name.c_str(), result.error.c_str());
+			}
+			else {
+				std::vector<Run> sorted = result.runs;
+				std::sort(sorted.begin(), sorted.end(), [](const Run& a, const Run& b) { return a.realNs < b.realNs; });
+				const Run& median = sorted[sorted.size() / 2];
+				std::fprintf(stderr, "%-48s %14.1f ns %14.1f ns %12llu %s\n", name.c_str(), median.realNs,
+						median.cpuNs, static_cast<unsigned long long>(median.iterations), median.label.c_str());
+			}
+			results.push_back(std::move(result));
+		}
+	}
+
+	if (options.list) {
+		return 0;
+	}
+
+	if (options.out.empty()) {
+		writeJson(std::cout, results, options, argv[0]);
+	}
+	else {
+		std::ofstream file(options.out);
+		if (!file) {
+			std::cerr << "Couldn't open \"" << options.out << "\" to write the results to.\n";
+			return 1;
+		}
+		writeJson(file, results, options, argv[0]);
+	}
+	return 0;
+}
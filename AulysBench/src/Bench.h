@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/* A micro-benchmark harness in the style of Google Benchmark, small enough to not be a dependency.
+ *
+ * A benchmark is a function taking a State, which runs its body once per iteration of the loop:
+ *
+ *     static void BM_Thing(Bench::State& state) {
+ *         Setup setup(state.arg()); // Not timed.
+ *         for (auto _ : state) {
+ *             Bench::doNotOptimize(thing(setup));
+ *         }
+ *     }
+ *     AU_BENCHMARK(BM_Thing)->arg(8)->arg(64);
+ *
+ * The runner picks the number of iterations so that a run takes at least --min-time, repeats that
+ * --repetitions times, and writes every run (and the mean, median, min and stddev of them) as JSON in
+ * Google Benchmark's format - so its compare.py, or anything else that reads that, can diff two
+ * commits. See Bench.cpp for the command line. */
+
+namespace Bench
+{
+	class State
+	{
+	public:
+		// What the range-for gives you. Only there to be ignored.
+		struct Value {};
+
+		class Iterator
+		{
+		public:
+			Iterator(State* state, uint64_t remaining) : mState(state), mRemaining(remaining) {};
+
+			Value operator*() const { return {}; };
+			Iterator& operator++() { --mRemaining; return *this; };
+			// Stops the clock when the loop's done, so nothing after it gets timed.
+			bool operator!=(const Iterator&) {
+				if (mRemaining != 0) {
+					return true;
+				}
+				mState->finishTiming();
+				return false;
+			}
+
+		private:
+			State* mState;
+			uint64_t mRemaining;
+		}; // class Iterator
+
+		State(uint64_t iterations, int64_t arg) : mIterations(iterations), mArg(arg) {};
+
+		// Starts the clock.
+		Iterator begin();
+		Iterator end() { return { this, 0 }; };
+
+		uint64_t iterations() const { return mIterations; };
+		int64_t arg() const { return mArg; };
+
+		// For items_per_second in the output - e.g. the number of points a batch call converted.
+		void setItemsProcessed(uint64_t items) { mItemsProcessed = items; };
+		// Shows up next to the result, e.g. what the arg means.
+		void setLabel(const std::string& label) { mLabel = label; };
+		// Call this before the loop: it then runs no iterations, and the error goes in the output.
+		void skipWithError(const std::string& message) { mError = message; };
+
+		double realSeconds() const { return mRealSeconds; };
+		double cpuSeconds() const { return mCpuSeconds; };
+		uint64_t itemsProcessed() const { return mItemsProcessed; };
+		const std::string& label() const { return mLabel; };
+		const std::string& error() const { return mError; };
+
+	private:
+		void finishTiming();
+
+		uint64_t mIterations;
+		int64_t mArg;
+
+		uint64_t mItemsProcessed = 0;
+		std::string mLabel{};
+		std::string mError{};
+
+		double mRealStart = 0.0, mCpuStart = 0.0;
+		double mRealSeconds = 0.0, mCpuSeconds = 0.0;
+	}; // class State
+
+	using Function = std::function<void(State&)>;
+
+	class Benchmark
+	{
+	public:
+		Benchmark(const std::string& name, Function fn) : mName(name), mFunction(std::move(fn)) {};
+
+		// Runs the benchmark once more for each arg, as "name/arg". Without any, it runs once with 0.
+		Benchmark* arg(int64_t arg) { mArgs.push_back(arg); return this; };
+
+		const std::string& getName() const { return mName; };
+		const std::vector<int64_t>& getArgs() const { return mArgs; };
+		const Function& getFunction() const { return mFunction; };
+
+	private:
+		std::string mName;
+		Function mFunction;
+		std::vector<int64_t> mArgs{};
+	}; // class Benchmark
+
+	Benchmark* registerBenchmark(const std::string& name, Function fn);
+	std::vector<Benchmark*>& registeredBenchmarks();
+
+	// Out of line, so the compiler has to assume it reads the pointer.
+	void useCharPointer(const volatile char* p);
+
+	// Keeps the compiler from throwing value (or the work that went into it) away, or from hoisting
+	// it out of the loop.
+	template <class T>
+	inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		useCharPointer(&reinterpret_cast<const volatile char&>(value));
+#endif
+	}
+
+	// The same, but also makes the compiler assume value was changed.
+	template <class T>
+	inline void doNotOptimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : "+m,r"(value) : : "memory");
+#else
+		useCharPointer(&reinterpret_cast<const volatile char&>(value));
+#endif
+	}
+
+	// Makes the compiler assume all memory got read and written here.
+	inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : : "memory");
+#endif
+	}
+}; // namespace Bench
+
+#define AU_BENCH_CONCAT2__(a, b)    a##b
+#define AU_BENCH_CONCAT__(a, b)     AU_BENCH_CONCAT2__(a, b)
+
+// Registers fn under its own name, before main runs. Chain ->arg(n) onto it for arguments.
+#define AU_BENCHMARK(fn)\
+                    static ::Bench::Benchmark* AU_BENCH_CONCAT__(sBenchmark, __LINE__) =\
+                        ::Bench::registerBenchmark(#fn, fn)
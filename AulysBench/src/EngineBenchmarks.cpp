@@ -0,0 +1,174 @@
+#include "Bench.h"
+
+#include "Aulys.h"
+#include "Core/LayerStack.h"
+#include "Events/ApplicationEvent.h"
+#include "Events/KeyEvent.h"
+#include "Events/MouseEvent.h"
+#include "Platform/OpenGL/OpenGLShader.h"
+
+#include <fstream>
+
+using namespace Aulys;
+
+/**************************************************************************************************/
+/*** Events ***/
+/**************************************************************************************************/
+
+namespace
+{
+	// Tries the event against `misses` handlers for other types, then the one for its own - the shape
+	// of a layer's onEvent (SceneLayer's has some twenty dispatches in a row).
+	uint32_t dispatchChain(Event& event, int64_t misses) {
+		uint32_t calls = 0;
+		EventDispatcher dispatcher(event);
+		for (int64_t i = 0; i < misses; i++) {
+			switch (i % 4) {
+				case 0: dispatcher.dispatch<KeyPressedEvent>([&](KeyPressedEvent&) { return ++calls; }); break;
+				case 1: dispatcher.dispatch<KeyReleasedEvent>([&](KeyReleasedEvent&) { return ++calls; }); break;
+				case 2: dispatcher.dispatch<MouseScrolledEvent>([&](MouseScrolledEvent&) { return ++calls; }); break;
+				case 3: dispatcher.dispatch<WindowResizeEvent>([&](WindowResizeEvent&) { return ++calls; }); break;
+			}
+		}
+		dispatcher.dispatch<MouseMovedEvent>([&](MouseMovedEvent&) { return ++calls; });
+		return calls;
+	}
+}; // namespace
+
+// The arg is how many dispatches miss before the one that hits.
+static void BM_EventDispatchChain(Bench::State& state) {
+	MouseMovedEvent event(1.0f, 2.0f);
+	for (auto _ : state) {
+		Bench::doNotOptimize(dispatchChain(event, state.arg()));
+	}
+	state.setItemsProcessed(state.iterations() * (state.arg() + 1));
+}
+AU_BENCHMARK(BM_EventDispatchChain)->arg(0)->arg(8)->arg(24);
+
+/**************************************************************************************************/
+/*** Layers ***/
+/**************************************************************************************************/
+
+namespace
+{
+	class DispatchingLayer : public Layer
+	{
+	public:
+		DispatchingLayer() : Layer("Benchmark layer") {};
+
+		virtual void onEvent(Event& event) override {
+			mCalls += dispatchChain(event, 8);
+		}
+
+		uint32_t mCalls = 0;
+	}; // class DispatchingLayer
+}; // namespace
+
+// Application::onEvent's walk down the stack, top first, with nothing marking the event handled so
+// it reaches every layer. The arg is the number of layers.
+static void BM_LayerStackPropagation(Bench::State& state) {
+	LayerStack stack;
+	for (int64_t i = 0; i < state.arg(); i++) {
+		stack.pushLayer(new DispatchingLayer());
+	}
+	MouseMovedEvent event(1.0f, 2.0f);
+
+	for (auto _ : state) {
+		event.handled = false;
+		for (auto it = stack.end(); it != stack.begin(); ) {
+			(*(--it))->onEvent(event);
+			if (event.handled == true) {
+				break;
+			}
+		}
+		Bench::clobberMemory();
+	}
+	state.setItemsProcessed(state.iterations() * state.arg());
+}
+AU_BENCHMARK(BM_LayerStackPropagation)->arg(1)->arg(4)->arg(16);
+
+/**************************************************************************************************/
+/*** Logging ***/
+/**************************************************************************************************/
+
+namespace
+{
+	// Sets the client loggers' runtime level for the length of a benchmark. Bench.cpp has already
+	// pointed them at a null sink, so the enabled levels only cost the formatting.
+	class ClientLogLevel
+	{
+	public:
+		ClientLogLevel(spdlog::level::level_enum level)
+			: mHeaderLevel(Log::mClientLogset->header->level()), mLoggerLevel(Log::mClientLogset->logger->level()) {
+			Log::mClientLogset->header->set_level(level);
+			Log::mClientLogset->logger->set_level(level);
+		}
+		~ClientLogLevel() {
+			Log::mClientLogset->header->set_level(mHeaderLevel);
+			Log::mClientLogset->logger->set_level(mLoggerLevel);
+		}
+
+	private:
+		spdlog::level::level_enum mHeaderLevel, mLoggerLevel;
+	}; // class ClientLogLevel
+}; // namespace
+
+// A trace call with the level switched off at run time: the matrix mustn't get formatted.
+static void BM_LogTraceDisabled(Bench::State& state) {
+	ClientLogLevel level(spdlog::level::info);
+	glm::mat4 m(1.0f);
+	for (auto _ : state) {
+		LT("Boost is now {0}", m);
+		Bench::doNotOptimize(m);
+	}
+}
+AU_BENCHMARK(BM_LogTraceDisabled);
+
+static void BM_LogTraceEnabled(Bench::State& state) {
+	ClientLogLevel level(spdlog::level::trace);
+	glm::mat4 m(1.0f);
+	for (auto _ : state) {
+		LT("Boost is now {0}", m);
+		Bench::doNotOptimize(m);
+	}
+}
+AU_BENCHMARK(BM_LogTraceEnabled);
+
+// The one-liner, header only, with a plain argument.
+static void BM_LogInfoLineEnabled(Bench::State& state) {
+	ClientLogLevel level(spdlog::level::trace);
+	int frame = 0;
+	for (auto _ : state) {
+		LOG_INFO_LINE("Frame {0} done.", frame);
+		Bench::doNotOptimize(frame);
+	}
+}
+AU_BENCHMARK(BM_LogInfoLineEnabled);
+
+/**************************************************************************************************/
+/*** Shaders ***/
+/**************************************************************************************************/
+
+namespace
+{
+	const char* sSandboxShaders[] = {
+		"Sandbox/assets/shaders/vertex.glsl",
+		"Sandbox/assets/shaders/fragment.glsl",
+	};
+}; // namespace
+
+// The #tag, #include and #type passes over the Sandbox's shaders, #includes and all - with the
+// core logger at its usual level, so that includes the trace dump of the result. The arg picks the
+// file from sSandboxShaders.
+static void BM_ShaderPreprocess(Bench::State& state) {
+	const char* file = sSandboxShaders[state.arg()];
+	state.setLabel(file);
+	if (!std::ifstream(Path(file).get())) {
+		state.skipWithError(std::string("Couldn't open ") + file + ", run AulysBench from the project root.");
+	}
+	for (auto _ : state) {
+		auto sources = OpenGLShader::preprocessFile(Path(file));
+		Bench::doNotOptimize(sources);
+	}
+}
+AU_BENCHMARK(BM_ShaderPreprocess)->arg(0)->arg(1);
@@ -0,0 +1,129 @@
+#include "Bench.h"
+
+#include "Geometry/Maths.h"
+#include "Geometry/GeometryMaths.h"
+#include "Geometry/Simplex.h"
+#include "Geometry/Scene.h"
+
+using namespace App;
+
+namespace
+{
+	struct HoneycombArgs
+	{
+		uint32_t p, q, r;
+	}; // struct HoneycombArgs
+
+	// The honeycomb benchmarks' args index into this. Cubical and simplex ones, in each geometry.
+	constexpr HoneycombArgs sHoneycombs[] = {
+		{ 4, 3, 5 }, // Hyperbolic, cubical.
+		{ 5, 3, 4 }, // Hyperbolic, simplex.
+		{ 4, 3, 4 }, // Euclidean, cubical.
+		{ 4, 3, 3 }, // Spherical, cubical (the tesseract).
+		{ 3, 3, 5 }, // Spherical, simplex (the 600-cell).
+	};
+	constexpr int64_t sSimplexHoneycombs[] = { 1, 4 };
+
+	std::string honeycombLabel(int64_t i) {
+		const HoneycombArgs& h = sHoneycombs[i];
+		return "{" + std::to_string(h.p) + "," + std::to_string(h.q) + "," + std::to_string(h.r) + "}";
+	}
+
+	const char* geometryLabel(Geometry::V g) {
+		switch (g) {
+			case Geometry::Hyperbolic: return "Hyperbolic";
+			case Geometry::Euclidean:  return "Euclidean";
+			case Geometry::Spherical:  return "Spherical";
+			default:                   return "Invalid";
+		}
+	}
+
+	// Somewhere a little way into the central cell, so not at the origin where some of these have
+	// a shortcut.
+	const glm::vec3 sOffset(0.21f, -0.13f, 0.08f);
+}; // namespace
+
+/**************************************************************************************************/
+/*** Maths ***/
+/**************************************************************************************************/
+
+// The arg is the Geometry::V.
+static void BM_TranslateByVector(Bench::State& state) {
+	const auto g = static_cast<Geometry::V>(state.arg());
+	state.setLabel(geometryLabel(g));
+	glm::vec3 v = sOffset;
+	for (auto _ : state) {
+		Bench::doNotOptimize(v);
+		Bench::doNotOptimize(translateByVector(g, v));
+	}
+}
+AU_BENCHMARK(BM_TranslateByVector)->arg(Geometry::Hyperbolic)->arg(Geometry::Euclidean)->arg(Geometry::Spherical);
+
+// gramSchmidt has nothing to do in Euclidean geometry (it asserts), so only the other two.
+static void BM_GramSchmidt(Bench::State& state) {
+	const auto g = static_cast<Geometry::V>(state.arg());
+	state.setLabel(geometryLabel(g));
+	glm::mat4 m = translateByVector(g, sOffset) * glm::rotate(glm::mat4(1.0f), 0.3f, glm::vec3(0.0f, 1.0f, 0.0f));
+	m[0] *= 1.0001f; // Drifted a touch, as it would be by the time anyone calls this.
+	for (auto _ : state) {
+		Bench::doNotOptimize(m);
+		Bench::doNotOptimize(gramSchmidt(g, m));
+	}
+}
+AU_BENCHMARK(BM_GramSchmidt)->arg(Geometry::Hyperbolic)->arg(Geometry::Spherical);
+
+/**************************************************************************************************/
+/*** Honeycombs ***/
+/**************************************************************************************************/
+
+// From the generators, which is how the camera did it every step before it cached the centres.
+static void BM_FixOutsideCentralCell(Bench::State& state) {
+	const HoneycombArgs& h = sHoneycombs[state.arg()];
+	state.setLabel(honeycombLabel(state.arg()));
+	const auto g = getGeometry(h.p, h.q, h.r);
+	const auto invGens = initGenerators(h.p, h.q, h.r).invGens;
+	glm::mat4 m = translateByVector(g, sOffset);
+	for (auto _ : state) {
+		Bench::doNotOptimize(m);
+		Bench::doNotOptimize(fixOutsideCentralCell(g, m, invGens));
+	}
+}
+AU_BENCHMARK(BM_FixOutsideCentralCell)->arg(0)->arg(1)->arg(2)->arg(3)->arg(4);
+
+// From neighbourCellCentres, worked out once - what SceneLayer does now.
+static void BM_FixOutsideCentralCellCentres(Bench::State& state) {
+	const HoneycombArgs& h = sHoneycombs[state.arg()];
+	state.setLabel(honeycombLabel(state.arg()));
+	const auto g = getGeometry(h.p, h.q, h.r);
+	const auto centres = neighbourCellCentres(g, initGenerators(h.p, h.q, h.r).invGens);
+	glm::mat4 m = translateByVector(g, sOffset);
+	for (auto _ : state) {
+		Bench::doNotOptimize(m);
+		Bench::doNotOptimize(fixOutsideCentralCell(m, centres));
+	}
+}
+AU_BENCHMARK(BM_FixOutsideCentralCellCentres)->arg(0)->arg(1)->arg(2)->arg(3)->arg(4);
+
+static void BM_SimplexFacetsKlein(Bench::State& state) {
+	const HoneycombArgs& h = sHoneycombs[sSimplexHoneycombs[state.arg()]];
+	state.setLabel(honeycombLabel(sSimplexHoneycombs[state.arg()]));
+	uint32_t p = h.p, q = h.q, r = h.r;
+	for (auto _ : state) {
+		Bench::doNotOptimize(p);
+		Bench::doNotOptimize(simplexFacetsKlein(p, q, r));
+	}
+}
+AU_BENCHMARK(BM_SimplexFacetsKlein)->arg(0)->arg(1);
+
+// Everything SceneLayer works out when the honeycomb changes.
+static void BM_InitGenerators(Bench::State& state) {
+	const HoneycombArgs& h = sHoneycombs[state.arg()];
+	state.setLabel(honeycombLabel(state.arg()));
+	uint32_t p = h.p, q = h.q, r = h.r;
+	for (auto _ : state) {
+		Bench::doNotOptimize(p);
+		auto generators = initGenerators(p, q, r);
+		Bench::doNotOptimize(generators);
+	}
+}
+AU_BENCHMARK(BM_InitGenerators)->arg(0)->arg(1)->arg(2)->arg(3)->arg(4);
@@ -40,6 +40,27 @@
 
 #define LOGGING_CLIENT_SINK_CONSOLE_MT
 #define LOGGING_CLIENT_SINK_FILE_ROTATE
+	// The *_FILE_ROTATE sinks write fully formatted text into logs/log.txt. For long runs you'll want
+	// to turn them off and use the binary sink below instead.
+
+// #define LOGGING_SINK_BINARY
+	// Write every log call into compact binary segment files instead of formatting it (see
+	// Log/BinaryLog.h). Turn them back into text with aulys-logdecode (the LogDecode project):
+	// `aulys-logdecode logs/log.*.aulb`
+#define LOGGING_BINARY_PATH "logs/log" // Segments are named LOGGING_BINARY_PATH.<n>.aulb
+#define LOGGING_BINARY_SEGMENT_SIZE (1048576 * 16) // Bytes per segment file.
+#define LOGGING_BINARY_MAX_SEGMENTS 8 // How many of the newest segments are kept around.
+
+/* Compile-time log level. Any AU_LOG_ or LOG_ call below this level is compiled out entirely -
+ * the arguments aren't even evaluated, so you can leave trace calls in hot loops. Calls at or above
+ * this level still check the logger's runtime level (spdlog's should_log) before doing any
+ * formatting or indentation work. Uses spdlog's level numbers (SPDLOG_LEVEL_TRACE, ..._INFO,
+ * ..._WARN, ..._ERROR, ..._OFF). */
+#ifdef AU_DIST
+	#define AU_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_WARN
+#else
+	#define AU_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
 
 #define LOGGING_INDENT "  " // The string used to indent standard (non-header) output lines.
 #define LOGGING_EMPTY_LINE "" // The string that is used instead of LOGGING_INDENT for empty lines.
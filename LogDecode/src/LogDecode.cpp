@@ -0,0 +1,298 @@
+/* aulys-logdecode - turns the binary log segments written by Aulys::BinaryLog back into text.
+ *
+ * Usage: aulys-logdecode <segment.aulb>... > log.txt
+ *
+ * The segments can be given in any order, they're sorted by their index. Every entry is rendered
+ * the way the text file sink would've written it: the header line using LOGGING_*_HEADER_FORMAT and
+ * then the indented message, both with the same {FILE}/{BASEFILE}/{LINE}/{FUNC}/{PRETTYFUNC}/
+ * {LOGLVL}/{LOGLVLC} tokens as in Log.h. (Anything added through CUSTOM_LOG_ARGS__ isn't recorded,
+ * so those tokens can't be decoded.) */
+
+#include "../../AulysConf.h"
+#include "Log/BinaryLogFormat.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+using namespace Aulys;
+
+namespace {
+	struct Site {
+		uint8_t level = 0;
+		uint8_t flags = 0;
+		uint32_t line = 0;
+		std::string file, baseFile, func, prettyFunc, format;
+	};
+
+	struct Segment {
+		std::string path;
+		BinaryLogFormat::SegmentHeader header;
+		std::vector<uint8_t> data;
+	};
+
+	using Value = std::variant<int64_t, uint64_t, float, double, bool, char, std::string>;
+
+	// Reads from a record body, failing (instead of reading past the end) on truncated data.
+	class Reader {
+	public:
+		Reader(const uint8_t* data, size_t size) : mData(data), mSize(size) {};
+
+		template<class T>
+		T read() {
+			T v;
+			need(sizeof(T));
+			std::memcpy(&v, mData + mPos, sizeof(T));
+			mPos += sizeof(T);
+			return v;
+		}
+
+		std::string readString() {
+			const uint16_t n = read<uint16_t>();
+			need(n);
+			std::string s((const char*)mData + mPos, n);
+			mPos += n;
+			return s;
+		}
+
+	private:
+		void need(size_t n) {
+			if (mPos + n > mSize) {
+				throw std::runtime_error("truncated record");
+			}
+		}
+
+		const uint8_t* mData;
+		size_t mSize;
+		size_t mPos = 0;
+	}; // class Reader
+
+	const char* levelName(uint8_t level) { // The {LOGLVL} the macros use.
+		switch (level) {
+		case 0: return "Trace";
+		case 1: return "Debug";
+		case 2: return "Info";
+		case 3: return "Warn";
+		case 4: return "Error";
+		case 5: return "Critical";
+		default: return "Off";
+		}
+	}
+
+	const char* spdlogLevelName(uint8_t level) { // The %l of spdlog's default pattern.
+		static const char* names[] = { "trace", "debug", "info", "warning", "error", "critical", "off" };
+		return names[std::min<uint8_t>(level, 6)];
+	}
+
+	// Same as Aulys::Log::indent.
+	std::string indent(const std::string& msg) {
+		std::istringstream buf(msg);
+		std::stringstream output;
+		std::string line;
+
+		std::getline(buf, line);
+#ifdef LOGGING_PREPEND_EMPTY_LINE
+		output << '\n';
+#endif
+		output << LOGGING_INDENT << line;
+		while (std::getline(buf, line)) {
+			if (line.empty()) {
+				output << LOGGING_EMPTY_LINE;
+			}
+			else {
+				output << '\n' << LOGGING_INDENT << line;
+			}
+		}
+#ifdef LOGGING_POSTPEND_EMPTY_LINE
+		output << '\n';
+#endif
+		return output.str();
+	}
+
+	std::string render(const std::string& format, const Site& site, const std::vector<Value>& values) {
+		const std::string lvl = levelName(site.level);
+		const auto aFile = fmt::arg("FILE", site.file);
+		const auto aBaseFile = fmt::arg("BASEFILE", site.baseFile);
+		const auto aLine = fmt::arg("LINE", site.line);
+		const auto aFunc = fmt::arg("FUNC", site.func);
+		const auto aPrettyFunc = fmt::arg("PRETTYFUNC", site.prettyFunc);
+		const auto aLogLvl = fmt::arg("LOGLVL", lvl);
+		const auto aLogLvlC = fmt::arg("LOGLVLC", lvl[0]);
+
+		std::vector<fmt::format_context::format_arg> args;
+		for (const Value& value : values) {
+			std::visit([&args](const auto& v) { args.push_back(fmt::internal::make_arg<fmt::format_context>(v)); }, value);
+		}
+		args.push_back(fmt::internal::make_arg<fmt::format_context>(aFile));
+		args.push_back(fmt::internal::make_arg<fmt::format_context>(aBaseFile));
+		args.push_back(fmt::internal::make_arg<fmt::format_context>(aLine));
+		args.push_back(fmt::internal::make_arg<fmt::format_context>(aFunc));
+		args.push_back(fmt::internal::make_arg<fmt::format_context>(aPrettyFunc));
+		args.push_back(fmt::internal::make_arg<fmt::format_context>(aLogLvl));
+		args.push_back(fmt::internal::make_arg<fmt::format_context>(aLogLvlC));
+
+		try {
+			return fmt::vformat(format, fmt::format_args(args.data(), (int)args.size()));
+		}
+		catch (const fmt::format_error& e) {
+			return fmt::format("[aulys-logdecode: {0}] {1}", e.what(), format);
+		}
+	}
+
+	std::string timestamp(const BinaryLogFormat::SegmentHeader& header, uint64_t sinceStartNs) {
+		const int64_t ns = header.wallClockNs + (int64_t)sinceStartNs;
+		const std::time_t seconds = (std::time_t)(ns / 1000000000);
+		char buf[32];
+		std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+		return fmt::format("{0}.{1:03}", buf, (ns / 1000000) % 1000);
+	}
+
+	void decodeEntry(Reader& r, const Segment& segment, const std::unordered_map<uint32_t, Site>& sites,
+					 std::ostream& out) {
+		const uint32_t siteId = r.read<uint32_t>();
+		const uint64_t time = r.read<uint64_t>();
+		const uint8_t flags = r.read<uint8_t>();
+		const auto site = sites.find(siteId);
+		if (site == sites.end()) {
+			throw std::runtime_error(fmt::format("entry for unknown site #{0}", siteId));
+		}
+		const std::string format = (flags & BinaryLogFormat::EntryFlags::InlineFormat) ? r.readString() : site->second.format;
+
+		const uint8_t argc = r.read<uint8_t>();
+		std::vector<Value> values;
+		values.reserve(argc);
+		for (uint8_t i = 0; i < argc; i++) {
+			switch ((BinaryLogFormat::Arg)r.read<uint8_t>()) {
+			case BinaryLogFormat::Arg::Int: values.emplace_back(r.read<int64_t>()); break;
+			case BinaryLogFormat::Arg::UInt: values.emplace_back(r.read<uint64_t>()); break;
+			case BinaryLogFormat::Arg::Float: values.emplace_back(r.read<float>()); break;
+			case BinaryLogFormat::Arg::Double: values.emplace_back(r.read<double>()); break;
+			case BinaryLogFormat::Arg::Bool: values.emplace_back((bool)r.read<uint8_t>()); break;
+			case BinaryLogFormat::Arg::Char: values.emplace_back(r.read<char>()); break;
+			case BinaryLogFormat::Arg::String: values.emplace_back(r.readString()); break;
+			default: throw std::runtime_error("unknown argument type");
+			}
+		}
+
+		const Site& s = site->second;
+		const bool client = s.flags & BinaryLogFormat::SiteFlags::Client;
+		const std::string prefix = fmt::format("[{0}] [{{0}}] [{1}] ", timestamp(segment.header, time), spdlogLevelName(s.level));
+		const std::string headerFormat = client ? LOGGING_CLIENT_HEADER_FORMAT : LOGGING_CORE_HEADER_FORMAT;
+
+		if (s.flags & BinaryLogFormat::SiteFlags::OneLine) {
+			out << fmt::format(prefix, client ? LOGGING_CLIENT_HEADER_NAME : LOGGING_CORE_HEADER_NAME)
+				<< render(headerFormat + " " + format, s, values) << '\n';
+		}
+		else {
+			out << fmt::format(prefix, client ? LOGGING_CLIENT_HEADER_NAME : LOGGING_CORE_HEADER_NAME)
+				<< render(headerFormat + " ", s, values) << '\n';
+			out << fmt::format(prefix, client ? LOGGING_CLIENT_LOGGER_NAME : LOGGING_CORE_LOGGER_NAME)
+				<< render(indent(format), s, values) << '\n';
+		}
+	}
+
+	// Returns false if the segment ended with something we couldn't read.
+	bool decodeSegment(const Segment& segment, std::ostream& out) {
+		std::unordered_map<uint32_t, Site> sites;
+		size_t pos = sizeof(BinaryLogFormat::SegmentHeader);
+
+		while (pos + sizeof(BinaryLogFormat::RecordHeader) <= segment.data.size()) {
+			BinaryLogFormat::RecordHeader record;
+			std::memcpy(&record, segment.data.data() + pos, sizeof(record));
+			pos += sizeof(record);
+			if ((BinaryLogFormat::Record)record.kind == BinaryLogFormat::Record::End) {
+				return true;
+			}
+			if (pos + record.size > segment.data.size()) {
+				std::cerr << segment.path << ": truncated record at byte " << pos << ".\n";
+				return false;
+			}
+
+			Reader r(segment.data.data() + pos, record.size);
+			try {
+				switch ((BinaryLogFormat::Record)record.kind) {
+				case BinaryLogFormat::Record::Site:
+				{
+					const uint32_t id = r.read<uint32_t>();
+					Site& site = sites[id];
+					site.level = r.read<uint8_t>();
+					site.flags = r.read<uint8_t>();
+					site.line = r.read<uint32_t>();
+					site.file = r.readString();
+					site.baseFile = r.readString();
+					site.func = r.readString();
+					site.prettyFunc = r.readString();
+					site.format = r.readString();
+					break;
+				}
+				case BinaryLogFormat::Record::Entry:
+					decodeEntry(r, segment, sites, out);
+					break;
+				default:
+					break; // Newer record type, skip it.
+				}
+			}
+			catch (const std::exception& e) {
+				std::cerr << segment.path << ": " << e.what() << " at byte " << pos << ".\n";
+			}
+			pos += record.size;
+		}
+		return true;
+	}
+};
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <segment" << BinaryLogFormat::Extension << ">...\n"
+			<< "Decodes the binary log segments written with LOGGING_SINK_BINARY to stdout.\n";
+		return 1;
+	}
+
+	std::vector<Segment> segments;
+	for (int i = 1; i < argc; i++) {
+		std::ifstream file(argv[i], std::ios::binary);
+		if (!file) {
+			std::cerr << argv[i] << ": couldn't open the file.\n";
+			return 1;
+		}
+		Segment segment;
+		segment.path = argv[i];
+		segment.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		if (segment.data.size() < sizeof(segment.header)) {
+			std::cerr << argv[i] << ": too short to be a log segment.\n";
+			return 1;
+		}
+		std::memcpy(&segment.header, segment.data.data(), sizeof(segment.header));
+		if (std::memcmp(segment.header.magic, BinaryLogFormat::Magic, sizeof(segment.header.magic)) != 0) {
+			std::cerr << argv[i] << ": not a log segment.\n";
+			return 1;
+		}
+		if (segment.header.version != BinaryLogFormat::Version) {
+			std::cerr << argv[i] << ": unsupported version " << segment.header.version
+				<< " (this decoder reads version " << BinaryLogFormat::Version << ").\n";
+			return 1;
+		}
+		segments.push_back(std::move(segment));
+	}
+
+	std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) {
+		return a.header.segment < b.header.segment;
+	});
+
+	bool ok = true;
+	for (const Segment& segment : segments) {
+		ok &= decodeSegment(segment, std::cout);
+	}
+	return ok ? 0 : 2;
+}
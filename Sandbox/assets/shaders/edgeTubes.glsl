@@ -4,28 +4,87 @@
 // Scene (edge tubes)
 //--------------------------------------------------------------------------------------------------
 
+// The half-cube's symmetries take every sample point to the one edge the tube planes are worked
+// out for (see edgeTubePlanes, in includes.glsl): reflect into the positive octant, then swap
+// coordinates until the smallest xyz coord is z, and largest is x. swaps says which swaps it took,
+// for unfoldGradient.
+vec4 foldIntoEdge(vec4 samplePoint, out bvec3 swaps){
+  samplePoint = abs(samplePoint);
+  swaps.x = samplePoint.x < samplePoint.z;
+  if(swaps.x){
+    samplePoint = vec4(samplePoint.z,samplePoint.y,samplePoint.x,samplePoint.w);
+  }
+  swaps.y = samplePoint.y < samplePoint.z;
+  if(swaps.y){
+    samplePoint = vec4(samplePoint.x,samplePoint.z,samplePoint.y,samplePoint.w);
+  }
+  swaps.z = samplePoint.x < samplePoint.y;
+  if(swaps.z){
+    samplePoint = vec4(samplePoint.y,samplePoint.x,samplePoint.z,samplePoint.w);
+  }
+  return samplePoint;
+}
+
+// Takes a gradient worked out at the folded point back to the original one: the same swaps
+// backwards, then the original point's signs. They're all reflections, so each is its own inverse.
+vec4 unfoldGradient(vec4 gradient, vec4 samplePoint, bvec3 swaps){
+  if(swaps.z){
+    gradient = vec4(gradient.y,gradient.x,gradient.z,gradient.w);
+  }
+  if(swaps.y){
+    gradient = vec4(gradient.x,gradient.z,gradient.y,gradient.w);
+  }
+  if(swaps.x){
+    gradient = vec4(gradient.z,gradient.y,gradient.x,gradient.w);
+  }
+  gradient.xyz *= mix(vec3(-1.0), vec3(1.0), greaterThanEqual(samplePoint.xyz, vec3(0.0)));
+  return gradient;
+}
+
+// The distance from the baked volume, if samplePoint's inside it. Trilinear filtering can overshoot
+// the true distance by as much as the distance to the texel's furthest corner, and in the Klein model
+// a length l at radius r is at most l/(1 - r^2) long, so that much is taken off - whatever's left
+// is still safe to step.
+bool bakedLocalSDF(vec4 samplePoint, out float distance){
+  vec3 klein = samplePoint.xyz / samplePoint.w;
+  if( !useSimplex ) {
+    klein = abs(klein);
+  }
+  vec3 texel = (klein - bakedSDFMin) * bakedSDFScale + bakedSDFOffset;
+  float outerRadius = length(klein) + bakedSDFVoxel;
+  if(any(lessThan(texel, vec3(0.0))) || any(greaterThan(texel, vec3(1.0))) || outerRadius >= 0.999){
+    return false;
+  }
+  distance = texture(bakedSDF, texel).r - bakedSDFVoxel / (1.0 - outerRadius*outerRadius);
+  return true;
+}
+
+// The planes the tube's measured from come worked out already, in edgeTubePlanes (see
+// includes.glsl), so all that's left here is what depends on the sample point.
 float localSceneSDF(vec4 samplePoint){
+  countLocalSDF();
+  float baked;
+  if( useBakedSDF && bakedLocalSDF(samplePoint, baked) && baked >= bakedSDFExactBelow ) {
+    return baked;
+  }
+  if( !useSimplex ) {
+    bvec3 swaps;
+    samplePoint = foldIntoEdge(samplePoint, swaps);
+  }
+  return edgeTubeSDF(samplePoint, edgeTubePlanes[0], edgeTubePlanes[1]);
+}
+
+// For the normals. The gradient's the exact tube's, whichever geodesics file's edgeTubeSDF is in -
+// they only agree at the surface, but that's the only place it's asked for.
+float localSceneSDF(vec4 samplePoint, out vec4 gradient){
+  countLocalSDF();
   if( useSimplex ) {
-    vec4 s1 = simplexDualPoints[2];
-    vec4 s2 = simplexDualPoints[3];
-    vec4 dualPoint = geometryNormalize(s1 - geometryDot(s1, s2) * s2, true);
-    return geodesicCylinderHSDFplanes(samplePoint, s2, dualPoint, tubeRad);
-  }
-  else {
-    samplePoint = abs(samplePoint);
-    // //now reflect until smallest xyz coord is z, and largest is x
-    if(samplePoint.x < samplePoint.z){
-      samplePoint = vec4(samplePoint.z,samplePoint.y,samplePoint.x,samplePoint.w);
-    }
-    if(samplePoint.y < samplePoint.z){
-      samplePoint = vec4(samplePoint.x,samplePoint.z,samplePoint.y,samplePoint.w);
-    }
-    if(samplePoint.x < samplePoint.y){
-      samplePoint = vec4(samplePoint.y,samplePoint.x,samplePoint.z,samplePoint.w);
-    }
-    // should precompute these orthonomal calculations
-    vec4 dualPoint1 = geometryNormalize(halfCubeDualPoints[1] - geometryDot(halfCubeDualPoints[1], halfCubeDualPoints[0]) * halfCubeDualPoints[0], true);
-    float edgesDistance = geodesicCylinderHSDFplanes(samplePoint, halfCubeDualPoints[0], dualPoint1, tubeRad);
-    return edgesDistance;
-  }
-}
\ No newline at end of file
+    gradient = geodesicCylinderHSDFplanesGradient(samplePoint, edgeTubePlanes[0], edgeTubePlanes[1]);
+    return edgeTubeSDF(samplePoint, edgeTubePlanes[0], edgeTubePlanes[1]);
+  }
+  bvec3 swaps;
+  vec4 folded = foldIntoEdge(samplePoint, swaps);
+  gradient = unfoldGradient(geodesicCylinderHSDFplanesGradient(folded, edgeTubePlanes[0], edgeTubePlanes[1]),
+                            samplePoint, swaps);
+  return edgeTubeSDF(folded, edgeTubePlanes[0], edgeTubePlanes[1]);
+}
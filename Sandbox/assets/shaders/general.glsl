@@ -30,6 +30,7 @@ vec4 geometryDirection(vec4 u, vec4 v);
 vec4 geometryFixDirection(vec4 u, vec4 v, mat4 fixMatrix);
 float geometryDot(vec4 u, vec4 v);
 float geometryDistance(vec4 u, vec4 v);
+vec4 geometryTangent(vec4 u, vec4 v);
 float geometryNorm(vec4 v){
   return sqrt(abs(geometryDot(v,v)));
 }
@@ -43,6 +44,9 @@ bool isOutsideCell(vec4 samplePoint, out mat4 fixMatrix);
 
 float globalSceneSDF(vec4 samplePoint, mat4 globalTransMatrix, bool collideWithLights);
 float localSceneSDF(vec4 samplePoint);
+// The same, and the gradient there as well (see hyperbolic.glsl's gradients), for the normals.
+float globalSceneSDF(vec4 samplePoint, mat4 globalTransMatrix, bool collideWithLights, out vec4 gradient);
+float localSceneSDF(vec4 samplePoint, out vec4 gradient);
 
 float sphereSDF(vec4 samplePoint, vec4 center, float radius){
   return geometryDistance(samplePoint, center) - radius;
@@ -52,6 +56,22 @@ float sphereSDF(vec4 samplePoint, vec4 center, float radius){
 // Raymarch Helpers
 //--------------------------------------------------------------------
 
+// Why a ray stopped marching, as the march stats report it (see instrumentation.glsl). 0 is left
+// for pixels nothing was drawn to.
+const int MARCH_ESCAPED = 1;      // Went past maxDist.
+const int MARCH_HIT_LOCAL = 2;    // Hit the local scene (the tubes).
+const int MARCH_HIT_GLOBAL = 3;   // Hit a light or a global object.
+const int MARCH_OUT_OF_STEPS = 4; // Ran out of maxSteps first.
+
+
+// How wide a pixel is at depth along its ray. getRayPoint puts the pixels 0.2/screenResolution.x
+// apart on the image plane, imagePlaneDepth away, which is the angle between neighbouring rays - and
+// in hyperbolic space the gap between two rays grows like sinh(depth).
+float pixelFootprint(float depth){
+  float pixelAngle = 0.2 / (screenResolution.x * imagePlaneDepth);
+  return pixelAngle * sinh(depth);
+}
+
 //Series Distance
 //recorded distances per step
 void AddToSeriesRecord(inout vec3 d, float newDist){
@@ -68,4 +88,46 @@ float GetSeriesDistance(inout vec3 d){
     d.z = (d.y*d.z)/(d.y-d.z);
   }
   return d.z;
-}
\ No newline at end of file
+}
+
+void countBacktrack(); // See instrumentation.glsl.
+
+//Over-Relaxed Sphere Tracing
+//Keinert et al., "Enhanced Sphere Tracing" (2014). Each step goes overRelaxation (1 to 2) times the
+//distance, not just the distance. That's safe as long as the sphere the distance gives at the new
+//point still overlaps the last one: between them they cover the whole step, so nothing was skipped.
+//When they don't, the ray goes back to where a plain step would have put it, and carries on plainly.
+//Every loop goes through one of these, so useOverRelaxation picks between it and the series distance.
+struct MarchStepper{
+  vec3 seriesRecord;
+  float omega;      // 1 once it's had to go back.
+  float lastRadius; // The distance at the last point,
+  float lastStep;   // and how far the ray went from there.
+};
+
+MarchStepper startStepper(){
+  return MarchStepper(vec3(MIN_DIST, MIN_DIST, MIN_DIST), overRelaxation, 0.0, 0.0);
+}
+
+// Takes the distance at the ray's point, and gives the step to take from there in step. False when
+// that step's going back, and dist can't be trusted - it's nowhere the ray would have got to. For the
+// series distance, dist comes back as GetSeriesDistance has it.
+bool marchStep(inout MarchStepper stepper, inout float dist, out float step){
+  if(!useOverRelaxation){
+    AddToSeriesRecord(stepper.seriesRecord, dist);
+    dist = GetSeriesDistance(stepper.seriesRecord);
+    step = dist;
+    return true;
+  }
+  if(stepper.omega > 1.0 && stepper.lastStep > stepper.lastRadius
+     && dist + stepper.lastRadius < stepper.lastStep){
+    countBacktrack();
+    step = stepper.lastRadius - stepper.lastStep;
+    stepper.omega = 1.0;
+    return false;
+  }
+  stepper.lastRadius = dist;
+  stepper.lastStep = dist * stepper.omega;
+  step = stepper.lastStep;
+  return true;
+}
@@ -0,0 +1,42 @@
+/* geodesicsExact.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// Marching along geodesics (exact)
+//--------------------------------------------------------------------------------------------------
+// What fragment.glsl gets normally (the "geodesics" tag). A ray remembers where it started and how
+// far it's gone, and every step works the point out from scratch, with a cosh and a sinh - so
+// nothing builds up, however long the march. geodesicsIncremental.glsl is the cheaper way.
+
+struct GeodesicRay {
+  vec4 origin;
+  vec4 dir;
+  float depth;
+};
+
+GeodesicRay startRay(vec4 origin, vec4 dir){
+  return GeodesicRay(origin, dir, MIN_DIST);
+}
+
+void advanceRay(inout GeodesicRay ray, float dist){
+  ray.depth += dist;
+}
+
+vec4 rayPoint(GeodesicRay ray){
+  return pointOnGeodesic(ray.origin, ray.dir, ray.depth);
+}
+
+vec4 rayTangent(GeodesicRay ray){
+  return tangentVectorOnGeodesic(ray.origin, ray.dir, ray.depth);
+}
+
+// The ray carried on from point (where it's got to), after fixMatrix has moved it into the next
+// cell. The starting direction, moved to point, is the tangent there - see geometryDirection.
+GeodesicRay fixRay(GeodesicRay ray, vec4 point, mat4 fixMatrix){
+  vec4 origin = geometryNormalize(point*fixMatrix, false);
+  return startRay(origin, geometryFixDirection(origin, ray.dir, fixMatrix));
+}
+
+// The distance to the tube around the edge where the planes (as dual points) meet.
+float edgeTubeSDF(vec4 samplePoint, vec4 dualPoint1, vec4 dualPoint2){
+  return geodesicCylinderHSDFplanes(samplePoint, dualPoint1, dualPoint2, tubeRad);
+}
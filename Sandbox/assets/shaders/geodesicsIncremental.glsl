@@ -0,0 +1,81 @@
+/* geodesicsIncremental.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// Marching along geodesics (incremental)
+//--------------------------------------------------------------------------------------------------
+// Swapped in for geodesicsExact.glsl (the "geodesics" tag). Instead of working the point out from
+// the start of the ray every step, the ray carries its point and tangent along, and each step turns
+// the pair by a hyperbolic rotation through the step's length:
+//
+//     point'   = point*cosh(d) + tangent*sinh(d)
+//     tangent' = point*sinh(d) + tangent*cosh(d)
+//
+// The local scene's steps are never more than 0.5, and for those a few terms of the series are
+// exact to float precision, so there's no exp at all. Rounding walks the pair off the hyperboloid a
+// little every step, so they're put back - a couple of inversesqrts, which are cheap.
+//
+// The tubes' distance is a lower bound rather than the distance (see edgeTubeSDF), which is all
+// the march needs, and is exact at the surface.
+
+struct GeodesicRay {
+  vec4 point;
+  vec4 tangent;
+};
+
+GeodesicRay startRay(vec4 origin, vec4 dir){
+  return GeodesicRay(origin, dir);
+}
+
+// cosh and sinh of a step length, by their series up to d^8 and d^7 when the step's short enough
+// for that to be exact in a float. Over-relaxed marches step back sometimes, so d can be negative.
+void stepCoshSinh(float d, out float c, out float s){
+  if(abs(d) <= 0.5){
+    float d2 = d*d;
+    c = 1.0 + d2*(1.0/2.0 + d2*(1.0/24.0 + d2*(1.0/720.0 + d2*(1.0/40320.0))));
+    s = d*(1.0 + d2*(1.0/6.0 + d2*(1.0/120.0 + d2*(1.0/5040.0))));
+  }
+  else{
+    float eD = exp(d);
+    float eMinusD = 1.0/eD;
+    c = 0.5*(eD + eMinusD);
+    s = 0.5*(eD - eMinusD);
+  }
+}
+
+void advanceRay(inout GeodesicRay ray, float dist){
+  float c, s;
+  stepCoshSinh(dist, c, s);
+  vec4 point = ray.point*c + ray.tangent*s;
+  vec4 tangent = ray.point*s + ray.tangent*c;
+  // Back onto the hyperboloid, then the tangent back into the point's tangent space, at length 1.
+  point *= inversesqrt(-geometryDot(point, point));
+  tangent += geometryDot(tangent, point)*point;
+  tangent *= inversesqrt(geometryDot(tangent, tangent));
+  ray.point = point;
+  ray.tangent = tangent;
+}
+
+vec4 rayPoint(GeodesicRay ray){
+  return ray.point;
+}
+
+vec4 rayTangent(GeodesicRay ray){
+  return ray.tangent;
+}
+
+// The ray carried on from point (where it's got to), after fixMatrix has moved it into the next cell.
+GeodesicRay fixRay(GeodesicRay ray, vec4 point, mat4 fixMatrix){
+  vec4 origin = geometryNormalize(point*fixMatrix, false);
+  return startRay(origin, geometryFixDirection(origin, ray.tangent, fixMatrix));
+}
+
+// The tube's distance is asinh(y) - asinh(Y), with y the sinh of the distance to the edge and Y
+// sinh(tubeRad). asinh's slope only falls off, so its slope at y, 1/sqrt(1 + y*y), times (y - Y)
+// never overshoots - and it's the same thing at the surface, where the hits are decided. Far from
+// the tubes it steps a little shorter, but the local scene's steps are cut to 0.5 anyway.
+float edgeTubeSDF(vec4 samplePoint, vec4 dualPoint1, vec4 dualPoint2){
+  float dot1 = -geometryDot(samplePoint, dualPoint1);
+  float dot2 = -geometryDot(samplePoint, dualPoint2);
+  float y2 = dot1*dot1 + dot2*dot2;
+  return (sqrt(y2) - tubeRadSinh) * inversesqrt(1.0 + y2);
+}
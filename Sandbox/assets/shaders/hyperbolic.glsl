@@ -13,6 +13,11 @@ float geometryDot(vec4 u, vec4 v){
 vec4 geometryNormalize(vec4 u, bool toTangent){
   return u/geometryNorm(u);
 }
+// The part of v in the tangent space at the point u - what an SDF's gradient has to be turned into
+// to be a normal there.
+vec4 geometryTangent(vec4 u, vec4 v){
+  return v + geometryDot(v, u)*u;
+}
 float geometryDistance(vec4 u, vec4 v){
   float bUV = -geometryDot(u,v);
   return acosh(bUV);
@@ -96,4 +101,33 @@ float geodesicCubeHSDF(vec4 samplePoint, vec4 dualPoint0, vec4 dualPoint1, vec4
   float plane1 = max(abs(geodesicPlaneHSDF(samplePoint, dualPoint1, 0.0))-offsets.y,0.0); 
   float plane2 = max(abs(geodesicPlaneHSDF(samplePoint, dualPoint2, 0.0))-offsets.z,0.0);
   return sqrt(plane0*plane0+plane1*plane1+plane2*plane2) - 0.01; 
-} 
\ No newline at end of file
+}
+
+//---------------------------------------------------------------------
+//Raymarch Primitives' Gradients
+//---------------------------------------------------------------------
+// Each of the SDFs above is a function of the geometryDot of the sample point with one or two
+// fixed points, so its gradient is just those points, scaled by the derivative. These are in the
+// ambient space, in the sense that the SDF changes by geometryDot(gradient, dp) when the sample
+// point moves by dp - put them through geometryTangent for the normal.
+
+vec4 sphereHSDFGradient(vec4 samplePoint, vec4 center){
+  float x = geometryDot(samplePoint, center);
+  return -center * inversesqrt(max(x*x - 1.0, 1e-12));
+}
+
+vec4 horosphereHSDFGradient(vec4 samplePoint, vec4 lightPoint){
+  return lightPoint / geometryDot(samplePoint, lightPoint);
+}
+
+vec4 geodesicPlaneHSDFGradient(vec4 samplePoint, vec4 dualPoint){
+  float x = geometryDot(samplePoint, dualPoint);
+  return -dualPoint * inversesqrt(1.0 + x*x);
+}
+
+vec4 geodesicCylinderHSDFplanesGradient(vec4 samplePoint, vec4 dualPoint1, vec4 dualPoint2){
+  float dot1 = -geometryDot(samplePoint, dualPoint1);
+  float dot2 = -geometryDot(samplePoint, dualPoint2);
+  float y2 = max(dot1*dot1 + dot2*dot2, 1e-12); // Only 0 right on the edge, deep inside the tube.
+  return -(dot1*dualPoint1 + dot2*dualPoint2) * inversesqrt(y2 * (1.0 + y2));
+}
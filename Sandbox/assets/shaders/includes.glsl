@@ -18,25 +18,44 @@ vec4 sampleTangentVector = vec4(1, 1, 1, 1);
 vec4 N = ORIGIN; //normal vector
 vec4 globalLightColor = ORIGIN;
 int hitWhich = 0;
+ivec2 pixelCoord = ivec2(0); // Which pixel this is: gl_FragCoord, or the compute raymarcher's.
 //-------------------------------------------
 //Translation & Utility Variables
 //-------------------------------------------
 uniform vec2 screenResolution;
 uniform float fov;
-uniform mat4 invGenerators[6];
+uniform float imagePlaneDepth; // 0.1/tan(fov/2), from SceneLayer whenever fov changes.
 uniform mat4 currentBoost;
 uniform mat4 cellBoost;
 uniform mat4 invCellBoost;
 uniform int maxSteps;
 uniform float maxDist;
+// A hit is anything nearer than hitPixelFraction of a pixel's footprint at that depth, and never
+// nearer than hitEpsilonMin (see hitEpsilon, in raymarch.glsl). 0 for the fraction always uses the
+// minimum.
+uniform float hitPixelFraction;
+uniform float hitEpsilonMin;
+// Over-relaxed sphere tracing instead of the series distance, and how much it over-relaxes by (see
+// MarchStepper, in general.glsl).
+uniform bool useOverRelaxation;
+uniform float overRelaxation;
 //--------------------------------------------
 //Lighting Variables & Global Object Variables
 //--------------------------------------------
-uniform vec4 lightPositions[4];
-uniform vec4 lightIntensities[5]; //w component is the light's attenuation -- 5 for our controller
 uniform int attnModel;
+uniform bool useLighting; // The lights on top of the ambient (see directLighting, in lighting.glsl).
 uniform bool renderShadows[2];
 uniform float shadSoft;
+// The most steps each light's shadow march may take, its local and global loops together. What's
+// still unknown then counts as lit.
+uniform int shadowStepBudgets[4];
+// Shadows kept from the last frame, and looked up again where the same surface still is - see
+// shadowCache.glsl.
+uniform bool useShadowCache;      // Write this frame's into the history.
+uniform bool shadowHistoryValid;  // Read the last frame's out of it.
+uniform usampler2D shadowHistory;
+uniform mat4 shadowReprojection;  // From the cell's frame to the camera's, as it was last frame.
+uniform int shadowFrame;          // Counts up by one a frame, for which pixels march regardless.
 uniform float ambient = 0.8f; // Added for goodness.
 uniform sampler2D uTexture;
 uniform mat4 globalObjectBoosts[4];
@@ -45,26 +64,47 @@ uniform vec3 globalObjectRadii[4];
 //--------------------------------------------
 //Scene Dependent Variables
 //--------------------------------------------
-uniform vec4 halfCubeDualPoints[3];
-uniform float halfCubeWidthKlein;
 uniform float tubeRad;
-uniform vec4 cellPosition;
-uniform float cellSurfaceOffset;
-uniform vec4 vertexPosition;
-uniform float vertexSurfaceOffset;
+uniform float tubeRadSinh; // sinh(tubeRad), for geodesicsIncremental.glsl's tube distance.
+// The local scene baked into a volume, by LocalSDFVolume - see bakedLocalSDF in edgeTubes.glsl.
+// useBakedSDF is only on while the volume's baked from the scene as it is now.
+uniform bool useBakedSDF = false;
+uniform sampler3D bakedSDF;
+uniform vec3 bakedSDFMin;      // texel coords = (klein - bakedSDFMin) * bakedSDFScale + bakedSDFOffset
+uniform vec3 bakedSDFScale;
+uniform float bakedSDFOffset;
+uniform float bakedSDFVoxel;   // A voxel's diagonal, in the Klein model.
+uniform float bakedSDFExactBelow; // Nearer than this, the analytic SDF takes over.
 
-// These are the planar mirrors of the fundamental simplex in the Klein (or analagous) model.
-// Order is mirrors opposite: vertex, edge, face, cell.
-// The xyz components of a vector give the unit normal of the mirror. The sense will be that the normal points to the outside of the simplex.
-// The w component is the offset from the origin.
-uniform bool useSimplex;
-uniform vec4 simplexMirrorsKlein[4];
-uniform vec4 simplexDualPoints[4];
-
-// The type of cut (1=sphere, 2=horosphere, 3=plane) for the vertex opposite the fundamental simplex's 4th mirror.
-// These integers match our values for the geometry of the honeycomb vertex figure.
-// We'll need more of these later when we support more symmetry groups.
-uniform int cut1;
-uniform int cut4;
+// Everything that comes with the honeycomb, written in one go from a cached set of parameters when
+// it changes - HoneycombUniforms in Geometry/HoneycombParams.h is the C++ side of this, in the same
+// order, so change the two together.
+layout(std140) uniform Honeycomb
+{
+	mat4 invGenerators[6];
+	vec4 lightPositions[4];
+	vec4 lightIntensities[5]; //w component is the light's attenuation -- 5 for our controller
+	vec4 halfCubeDualPoints[3];
+	// These are the planar mirrors of the fundamental simplex in the Klein (or analagous) model.
+	// Order is mirrors opposite: vertex, edge, face, cell.
+	// The xyz components of a vector give the unit normal of the mirror. The sense will be that the normal points to the outside of the simplex.
+	// The w component is the offset from the origin.
+	vec4 simplexMirrorsKlein[4];
+	vec4 simplexDualPoints[4];
+	// Where the edge tubes are: the two perpendicular planes (as dual points) that meet along the
+	// edge, worked out from the dual points above by edgeTubePlanes in HoneycombParams.cpp.
+	vec4 edgeTubePlanes[2];
+	vec4 cellPosition;
+	vec4 vertexPosition;
+	float halfCubeWidthKlein;
+	float cellSurfaceOffset;
+	float vertexSurfaceOffset;
+	bool useSimplex;
+	// The type of cut (1=sphere, 2=horosphere, 3=plane) for the vertex opposite the fundamental simplex's 4th mirror.
+	// These integers match our values for the geometry of the honeycomb vertex figure.
+	// We'll need more of these later when we support more symmetry groups.
+	int cut1;
+	int cut4;
+};
 
 uniform int NUM_OBJECTS;
@@ -0,0 +1,126 @@
+/* instrumentation.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// March stats hooks (on)
+//--------------------------------------------------------------------------------------------------
+// Swapped in for instrumentationOff.glsl (the "instrumentation" tag) while SceneLayer's march stats
+// are on. Every ray writes how its march went to a second colour attachment, which marchStats.glsl
+// then turns into a heatmap and a histogram, and adds what it did to the frame's counters. This is
+// the only place any of it costs anything.
+
+// x: steps taken, local and global loops together.
+// y: cell crossings, i.e. how many times isOutsideCell sent the ray into the next cell.
+// z: how far the ray got, as floatBitsToUint - the attachment's integer, so blending leaves it alone.
+// w: how the march ended, one of the MARCH_ constants in general.glsl.
+// The compute raymarcher (raymarchCompute.glsl) hasn't got attachments, so it stores to the same
+// texture as an image instead.
+#ifdef RAYMARCH_COMPUTE
+layout(rgba32ui, binding = 2) uniform writeonly uimage2D marchImage;
+#else
+layout(location = 1) out uvec4 out_march;
+#endif
+
+// The whole frame's totals, which MarchCounters reads back a few frames later. Every pixel adding to
+// the same few uints would have them all queueing up for one atomic, so each counter's spread over
+// MARCH_COUNTER_SLOTS of them, picked by where the pixel is, and MarchCounters adds them back up.
+const uint MARCH_COUNTER_SLOTS = 64u;
+
+layout(std430, binding = 2) buffer MarchCounters
+{
+  uint counterSteps[MARCH_COUNTER_SLOTS];       // Both loops of raymarch.
+  uint counterLocalSDFs[MARCH_COUNTER_SLOTS];   // localSceneSDF calls, normals' included.
+  uint counterGlobalSDFs[MARCH_COUNTER_SLOTS];  // globalSceneSDF calls, likewise.
+  uint counterShadowSteps[MARCH_COUNTER_SLOTS]; // shadowMarch's loops.
+  uint counterOutOfSteps[MARCH_COUNTER_SLOTS];  // Pixels whose march hit maxSteps.
+  uint counterPixels[MARCH_COUNTER_SLOTS];
+  uint counterBacktracks[MARCH_COUNTER_SLOTS];  // Over-relaxed steps that had to be taken back.
+  // Each light's, one after the other: MARCH_COUNTER_SLOTS for light 0, then light 1's...
+  uint counterLightShadowSteps[4u * MARCH_COUNTER_SLOTS]; // counterShadowSteps, by light.
+  uint counterShadowMarches[4u * MARCH_COUNTER_SLOTS];    // shadowMarch calls.
+  uint counterShadowReuses[4u * MARCH_COUNTER_SLOTS];     // Shadows found without one (see shadowCache.glsl).
+};
+
+uint marchSteps = 0u;
+uint marchCellCrossings = 0u;
+uint marchLocalSDFs = 0u;
+uint marchGlobalSDFs = 0u;
+uint marchShadowSteps = 0u;
+uint marchBacktracks = 0u;
+uvec4 marchLightShadowSteps = uvec4(0u);
+uvec4 marchShadowMarches = uvec4(0u);
+uvec4 marchShadowReuses = uvec4(0u);
+int marchResult = 0;
+
+void countMarchStep(){
+  marchSteps++;
+}
+
+void countCellCrossing(){
+  marchCellCrossings++;
+}
+
+void countLocalSDF(){
+  marchLocalSDFs++;
+}
+
+void countGlobalSDF(){
+  marchGlobalSDFs++;
+}
+
+void countShadowStep(int light){
+  marchShadowSteps++;
+  marchLightShadowSteps[light]++;
+}
+
+void countShadowMarch(int light){
+  marchShadowMarches[light]++;
+}
+
+void countShadowReuse(int light){
+  marchShadowReuses[light]++;
+}
+
+void countBacktrack(){
+  marchBacktracks++;
+}
+
+void endMarch(int result, float depth){
+  marchResult = result;
+  uvec4 march = uvec4(marchSteps, marchCellCrossings, floatBitsToUint(depth), uint(result));
+#ifdef RAYMARCH_COMPUTE
+  imageStore(marchImage, pixelCoord, march);
+#else
+  out_march = march;
+#endif
+}
+
+// Once the pixel's done everything - shading's SDF calls and shadows come after endMarch.
+void flushMarchCounters(){
+  uvec2 pixel = uvec2(pixelCoord);
+  uint slot = (pixel.x + pixel.y * 7u) % MARCH_COUNTER_SLOTS;
+  atomicAdd(counterSteps[slot], marchSteps);
+  atomicAdd(counterLocalSDFs[slot], marchLocalSDFs);
+  atomicAdd(counterGlobalSDFs[slot], marchGlobalSDFs);
+  if(marchShadowSteps > 0u){
+    atomicAdd(counterShadowSteps[slot], marchShadowSteps);
+  }
+  if(marchBacktracks > 0u){
+    atomicAdd(counterBacktracks[slot], marchBacktracks);
+  }
+  for(uint light = 0u; light < 4u; light++){
+    uint lightSlot = light * MARCH_COUNTER_SLOTS + slot;
+    if(marchLightShadowSteps[light] > 0u){
+      atomicAdd(counterLightShadowSteps[lightSlot], marchLightShadowSteps[light]);
+    }
+    if(marchShadowMarches[light] > 0u){
+      atomicAdd(counterShadowMarches[lightSlot], marchShadowMarches[light]);
+    }
+    if(marchShadowReuses[light] > 0u){
+      atomicAdd(counterShadowReuses[lightSlot], marchShadowReuses[light]);
+    }
+  }
+  if(marchResult == MARCH_OUT_OF_STEPS){
+    atomicAdd(counterOutOfSteps[slot], 1u);
+  }
+  atomicAdd(counterPixels[slot], 1u);
+}
@@ -0,0 +1,18 @@
+/* instrumentationOff.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// March stats hooks (off)
+//--------------------------------------------------------------------------------------------------
+// What fragment.glsl gets normally. These are all empty, so they compile away to nothing - see
+// instrumentation.glsl for what they do when the march stats are on.
+
+void countMarchStep(){}
+void countCellCrossing(){}
+void countLocalSDF(){}
+void countGlobalSDF(){}
+void countShadowStep(int light){}
+void countShadowMarch(int light){}
+void countShadowReuse(int light){}
+void countBacktrack(){}
+void endMarch(int result, float depth){}
+void flushMarchCounters(){}
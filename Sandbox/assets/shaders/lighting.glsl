@@ -3,6 +3,10 @@
 //--------------------------------------------------------------------------------------------------
 // Lighting
 //--------------------------------------------------------------------------------------------------
+// The four lights on a surface the raymarch hit, and their shadows. Included after the scene, by
+// both raymarchers: raymarch.glsl's shading is what calls it. The shadows are the expensive part, a
+// march per light - so each light has a budget of steps, and shadowCache.glsl keeps them from one
+// frame to the next.
 
 //--------------------------------------------------------------------
 // Lighting Functions
@@ -12,79 +16,87 @@
 //If we make it to/past the light without hitting anything we return 1
 //otherwise the spot does not receive light from that light source
 //Based off of Inigo Quilez's soft shadows https://iquilezles.org/www/articles/rmshadows/rmshadows.htm
-float shadowMarch(vec4 origin, vec4 dirToLight, float distToLight, mat4 globalTransMatrix){
-    float localDepth = EPSILON * 100.0;
-    float globalDepth = localDepth;
-    vec4 localrO = origin;
-    vec4 localrD = dirToLight;
+//Every light has its own budget of steps (shadowStepBudgets), shared by the two loops: a ray that
+//runs out before it's got to the light is as lit as it's looked so far.
+float shadowMarch(int light, vec4 origin, vec4 dirToLight, float distToLight, mat4 globalTransMatrix){
+    float globalDepth = EPSILON * 100.0;
+    // Both start a little way off the surface, so they don't hit it straight away.
+    GeodesicRay localRay = startRay(origin, dirToLight);
+    advanceRay(localRay, globalDepth);
     mat4 fixMatrix = mat4(1.0);
     float k = shadSoft;
     float result = 1.0;
-    vec3 seriesRecord = vec3(MIN_DIST, MIN_DIST, MIN_DIST);
+    int budget = min(shadowStepBudgets[light], MAX_MARCHING_STEPS);
+    int steps = 0;
+    MarchStepper stepper = startStepper();
     
     //Local Trace for shadows
     if(renderShadows[0]){
       for(int i = 0; i < MAX_MARCHING_STEPS; i++){
-        vec4 localEndPoint = pointOnGeodesic(localrO, localrD, localDepth);
+        if(steps >= budget){
+          return result;
+        }
+        steps++;
+        countShadowStep(light);
+        vec4 localEndPoint = rayPoint(localRay);
 
         if(isOutsideCell(localEndPoint, fixMatrix)){
-          localrO = geometryNormalize(localEndPoint*fixMatrix, false);
-          localrD = geometryFixDirection(localrO, localrD, fixMatrix);
-          localDepth = MIN_DIST; 
+          localRay = fixRay(localRay, localEndPoint, fixMatrix);
         }
         else{
           float localDist = min(0.5,localSceneSDF(localEndPoint));
-          AddToSeriesRecord(seriesRecord, localDist);
-          localDist = GetSeriesDistance(seriesRecord);
-          if(localDist < EPSILON){
+          float localStep;
+          bool trusted = marchStep(stepper, localDist, localStep);
+          if(trusted && localDist < EPSILON){
             return 0.0;
           }
-          localDepth += localDist;
-          globalDepth += localDist;
-          result = min(result, k*localDist/globalDepth);
-          if(globalDepth > distToLight){
-            break;
+          // Whether it's got to the light goes by the distance alone, as an over-relaxed step
+          // past it might have gone over something on the way.
+          if(trusted){
+            result = min(result, k*localDist/(globalDepth + localDist));
+            if(globalDepth + localDist > distToLight){
+              break;
+            }
           }
+          advanceRay(localRay, localStep);
+          globalDepth += localStep;
         }
       }  
     }
 
     //Global Trace for shadows
     if(renderShadows[1]){
-      seriesRecord = vec3(MIN_DIST, MIN_DIST, MIN_DIST);
+      stepper = startStepper();
       globalDepth = EPSILON * 100.0;
+      GeodesicRay globalRay = startRay(origin, dirToLight);
+      advanceRay(globalRay, globalDepth);
       for(int i = 0; i< MAX_MARCHING_STEPS; i++){
-        vec4 globalEndPoint = pointOnGeodesic(origin, dirToLight, globalDepth);
+        if(steps >= budget){
+          return result;
+        }
+        steps++;
+        countShadowStep(light);
+        vec4 globalEndPoint = rayPoint(globalRay);
         float globalDist = globalSceneSDF(globalEndPoint, globalTransMatrix, false);
-        AddToSeriesRecord(seriesRecord, globalDist);
-        globalDist = GetSeriesDistance(seriesRecord);
-        if(globalDist < EPSILON){
+        float globalStep;
+        bool trusted = marchStep(stepper, globalDist, globalStep);
+        if(trusted && globalDist < EPSILON){
           return 0.0;
         }
-        globalDepth += globalDist;
-        result = min(result, k*globalDist/globalDepth);
-        if(globalDepth > distToLight){
-          return result;
+        if(trusted){
+          result = min(result, k*globalDist/(globalDepth + globalDist));
+          if(globalDepth + globalDist > distToLight){
+            return result;
+          }
         }
+        globalDepth += globalStep;
+        advanceRay(globalRay, globalStep);
       }
       return result;
     }
     return result;
 }
 
-vec4 texcube(vec4 samplePoint, mat4 toOrigin){
-    float k = 4.0;
-    vec4 newSP = samplePoint * toOrigin;
-    vec3 p = mod(newSP.xyz,1.0);
-    vec3 n = geometryNormalize(N*toOrigin, true).xyz; //Very hacky you are warned
-    vec3 m = pow(abs(n), vec3(k));
-    vec4 x = texture2D(uTexture, p.yz);
-    vec4 y = texture2D(uTexture, p.zx);
-    vec4 z = texture2D(uTexture, p.xy);
-    return (x*m.x + y*m.y + z*m.z) / (m.x+m.y+m.z);
-}
-
-
 float attenuation(float distToLight, vec4 lightIntensity){
   float att;
   if(attnModel == 1) //Inverse Linear
@@ -100,44 +112,53 @@ float attenuation(float distToLight, vec4 lightIntensity){
   return att;
 }
 
-vec3 lightingCalculations(vec4 SP, vec4 TLP, vec4 V, vec3 baseColor, vec4 lightIntensity, mat4 globalTransMatrix){
+// The light's at TLP, in the same frame as SP. Only its colour: whether anything's in the way is
+// shadowVisibility's.
+vec3 lightingCalculations(vec4 SP, vec4 TLP, vec4 V, vec3 baseColor, vec4 lightIntensity){
   float distToLight = geometryDistance(SP, TLP);
   float att = attenuation(distToLight, lightIntensity);
   //Calculations - Phong Reflection Model
   vec4 L = geometryDirection(SP, TLP);
   vec4 R = 2.0*geometryDot(L, N)*N - L;
   //Calculate Diffuse Component
-  float nDotL = max(geometryDot(N, L),0.0);
+  float nDotL = geometryDot(N, L);
+  if(nDotL <= 0.0){ // Facing away from it, so no specular either.
+    return vec3(0.0);
+  }
   vec3 diffuse = lightIntensity.rgb * nDotL;
-  //Calculate Shadows
-  float shadow = 1.0;
-  shadow = shadowMarch(SP, L, distToLight, globalTransMatrix);
   //Calculate Specular Component
   float rDotV = max(geometryDot(R, V),0.0);
   vec3 specular = lightIntensity.rgb * pow(rDotV,10.0);
   //Compute final color
-  return att*(shadow*((diffuse*baseColor) + specular));
+  return att*((diffuse*baseColor) + specular);
 }
 
-vec3 phongModel(mat4 invObjectBoost, bool isGlobal, mat4 globalTransMatrix){
-  //--------------------------------------------
-  //Setup Variables
-  //--------------------------------------------
-  float ambient = 0.1;
-  vec3 baseColor = vec3(0.0,1.0,1.0);
+// How much of each light gets to sampleEndPoint, 0 to 1 - the lights that are off, or behind the
+// surface, don't need a shadow march. globalTransMatrix takes the lights to the hit's cell.
+vec4 shadowVisibility(mat4 globalTransMatrix){
+  vec4 visibility = vec4(1.0);
+  if(!renderShadows[0] && !renderShadows[1]){
+    return visibility;
+  }
   vec4 SP = sampleEndPoint;
-  vec4 TLP;
-  vec4 V = -sampleTangentVector;
-
-  if(isGlobal){ //this may be possible to move outside function as we already have an if statement for global v. local
-    baseColor = texcube(SP, cellBoost * invObjectBoost).xyz; 
+  for(int i = 0; i < 4; i++){
+    if(lightIntensities[i].w == 0.0){ continue; }
+    vec4 TLP = lightPositions[i]*globalTransMatrix;
+    vec4 L = geometryDirection(SP, TLP);
+    if(geometryDot(N, L) <= 0.0){ continue; }
+    countShadowMarch(i);
+    visibility[i] = shadowMarch(i, SP, L, geometryDistance(SP, TLP), globalTransMatrix);
   }
-  else{
-    baseColor = texcube(SP, mat4(1.0)).xyz;
-  } // Works
-
-  //Setup up color with ambient component
+  return visibility;
+}
 
-  vec3 color = baseColor * ambient; 
-	return color;
+// All four lights at sampleEndPoint, each as much as visibility lets through.
+vec3 directLighting(vec4 V, vec3 baseColor, mat4 globalTransMatrix, vec4 visibility){
+  vec3 color = vec3(0.0);
+  for(int i = 0; i < 4; i++){
+    if(lightIntensities[i].w == 0.0 || visibility[i] == 0.0){ continue; }
+    vec4 TLP = lightPositions[i]*globalTransMatrix;
+    color += visibility[i] * lightingCalculations(sampleEndPoint, TLP, V, baseColor, lightIntensities[i]);
+  }
+  return color;
 }
@@ -0,0 +1,98 @@
+#type compute
+#version 450 core
+
+/* marchStats.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// March stats: heatmap and histogram
+//--------------------------------------------------------------------------------------------------
+// Run by MarchStats over what instrumentation.glsl wrote, a 16x16 tile of pixels per work group.
+// Each pixel gets coloured into the heatmap, and counted into the work group's own histogram in
+// shared memory - only those get added to the frame's, so the global atomics are a few hundred per
+// tile instead of one per pixel. The bin counts have to match MarchStats.h.
+
+#define STEP_BINS 256u     // Two loops of at most MAX_MARCHING_STEPS (127) each.
+#define CROSSING_BINS 128u // Can't cross more cells than it took steps in the local loop.
+#define DEPTH_BINS 64u     // Over [0, maxDist].
+#define RESULT_BINS 8u     // The MARCH_ constants in general.glsl, and 0 for nothing drawn.
+
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(rgba32ui, binding = 0) uniform readonly uimage2D marchImage;
+layout(rgba8, binding = 1) uniform writeonly image2D heatmapImage;
+
+layout(std430, binding = 1) buffer MarchHistogram
+{
+  uint stepBins[STEP_BINS];
+  uint crossingBins[CROSSING_BINS];
+  uint depthBins[DEPTH_BINS];
+  uint resultBins[RESULT_BINS];
+};
+
+uniform int view;     // MarchStats::View: steps, cell crossings, depth or result.
+uniform float range;  // What the top of the colour scale stands for, in the view's units.
+uniform float maxDist;
+
+shared uint tileSteps[STEP_BINS];
+shared uint tileCrossings[CROSSING_BINS];
+shared uint tileDepths[DEPTH_BINS];
+shared uint tileResults[RESULT_BINS];
+
+// Google's Turbo colour map, as a polynomial fit (Anton Mikhailov, 2019). Dark blue at 0, through
+// green, to dark red at 1 - easier to read steps off than a plain gradient.
+vec3 turbo(float x){
+  const vec4 kRed4 = vec4(0.13572138, 4.61539260, -42.66032258, 132.13108234);
+  const vec4 kGreen4 = vec4(0.09140261, 2.19418839, 4.84296658, -14.18503333);
+  const vec4 kBlue4 = vec4(0.10667330, 12.64194608, -60.58204836, 110.36276771);
+  const vec2 kRed2 = vec2(-152.94239396, 59.28637943);
+  const vec2 kGreen2 = vec2(4.27729857, 2.82956604);
+  const vec2 kBlue2 = vec2(-89.90310912, 27.34824973);
+  x = clamp(x, 0.0, 1.0);
+  vec4 v4 = vec4(1.0, x, x * x, x * x * x);
+  vec2 v2 = v4.zw * v4.z;
+  return vec3(dot(v4, kRed4) + dot(v2, kRed2), dot(v4, kGreen4) + dot(v2, kGreen2),
+              dot(v4, kBlue4) + dot(v2, kBlue2));
+}
+
+vec4 heat(uvec4 march, float depth){
+  if(march.w == 0u){
+    return vec4(0.0, 0.0, 0.0, 1.0);
+  }
+  if(view == 0){ return vec4(turbo(float(march.x) / range), 1.0); }
+  if(view == 1){ return vec4(turbo(float(march.y) / range), 1.0); }
+  if(view == 2){ return vec4(turbo(depth / range), 1.0); }
+  // How it ended: escaped is grey, the local scene green, the global scene blue, out of steps red.
+  const vec3 results[5] = vec3[5](vec3(0.0), vec3(0.25), vec3(0.2, 0.8, 0.3), vec3(0.2, 0.4, 1.0),
+                                  vec3(1.0, 0.15, 0.1));
+  return vec4(results[min(march.w, 4u)], 1.0);
+}
+
+void main(){
+  uint t = gl_LocalInvocationIndex;
+  tileSteps[t] = 0u;
+  if(t < CROSSING_BINS){ tileCrossings[t] = 0u; }
+  if(t < DEPTH_BINS){ tileDepths[t] = 0u; }
+  if(t < RESULT_BINS){ tileResults[t] = 0u; }
+  memoryBarrierShared();
+  barrier();
+
+  ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+  if(all(lessThan(pixel, imageSize(marchImage)))){
+    uvec4 march = imageLoad(marchImage, pixel);
+    float depth = uintBitsToFloat(march.z);
+    if(march.w != 0u){
+      atomicAdd(tileSteps[min(march.x, STEP_BINS - 1u)], 1u);
+      atomicAdd(tileCrossings[min(march.y, CROSSING_BINS - 1u)], 1u);
+      atomicAdd(tileDepths[min(uint(max(depth, 0.0) / maxDist * float(DEPTH_BINS)), DEPTH_BINS - 1u)], 1u);
+      atomicAdd(tileResults[min(march.w, RESULT_BINS - 1u)], 1u);
+    }
+    imageStore(heatmapImage, pixel, heat(march, depth));
+  }
+  memoryBarrierShared();
+  barrier();
+
+  if(tileSteps[t] != 0u){ atomicAdd(stepBins[t], tileSteps[t]); }
+  if(t < CROSSING_BINS && tileCrossings[t] != 0u){ atomicAdd(crossingBins[t], tileCrossings[t]); }
+  if(t < DEPTH_BINS && tileDepths[t] != 0u){ atomicAdd(depthBins[t], tileDepths[t]); }
+  if(t < RESULT_BINS && tileResults[t] != 0u){ atomicAdd(resultBins[t], tileResults[t]); }
+}
@@ -0,0 +1,379 @@
+/* raymarch.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// Raymarcher
+//--------------------------------------------------------------------------------------------------
+// The march and the shading, shared by both raymarchers: fragment.glsl, a pixel per fragment over a
+// full-screen quad, and raymarchCompute.glsl, a pixel per invocation in 8x8 tiles. Whatever's
+// including this has already included the scene (edgeTubes.glsl), the march stats' hooks, and the
+// lights (lighting.glsl and shadowCache.glsl).
+
+uniform bool debugInfo = false; 
+uniform vec2 debugVector2;
+
+// How near counts as a hit at depth along the ray. A pixel's rays fan out from the camera, so far
+// off a pixel covers whole cells (see pixelFootprint), and resolving the surface to EPSILON there is
+// spending steps on detail that's far smaller than the pixel.
+float hitEpsilon(float depth){
+  return max(hitEpsilonMin, hitPixelFraction * pixelFootprint(depth));
+}
+
+// epsilon is how near counts as hitting a light or object, i.e. setting hitWhich.
+float globalSceneSDF(vec4 samplePoint, mat4 globalTransMatrix, bool collideWithLights, float epsilon){
+  countGlobalSDF();
+  float distance = maxDist;
+  if(collideWithLights){
+    //Light Objects
+    for(int i=0; i<4; i++){
+      float objDist;
+      if(lightIntensities[i].w == 0.0) { objDist = maxDist; }
+      else{
+        objDist = sphereSDF(samplePoint, lightPositions[i]*globalTransMatrix, 
+										1.0/(10.0*lightIntensities[i].w));
+        distance = min(distance, objDist);
+        if(distance < epsilon){
+          hitWhich = 1;
+          globalLightColor = lightIntensities[i];
+          return distance;
+        }
+      }
+    }
+    //Global Objects
+    for(int i=0; i<NUM_OBJECTS; i++) {
+        float objDist;
+        if(length(globalObjectRadii[i]) == 0.0){ objDist = maxDist;}
+        else{
+        objDist = sphereSDF(samplePoint, globalObjectBoosts[i][3] * globalTransMatrix, globalObjectRadii[i].x);
+        distance = min(distance, objDist);
+        if(distance < epsilon){
+            hitWhich = 2;
+        }
+        }
+    }
+    return distance;
+    }
+};
+
+float globalSceneSDF(vec4 samplePoint, mat4 globalTransMatrix, bool collideWithLights){
+  return globalSceneSDF(samplePoint, globalTransMatrix, collideWithLights, EPSILON);
+}
+
+// The same distance, and the gradient of whichever sphere's nearest. Leaves hitWhich alone: it's
+// only asked once the march has decided what it hit.
+float globalSceneSDF(vec4 samplePoint, mat4 globalTransMatrix, bool collideWithLights, out vec4 gradient){
+  countGlobalSDF();
+  float distance = maxDist;
+  gradient = vec4(0.0);
+  if(collideWithLights){
+    //Light Objects
+    for(int i=0; i<4; i++){
+      if(lightIntensities[i].w == 0.0) { continue; }
+      vec4 center = lightPositions[i]*globalTransMatrix;
+      float objDist = sphereSDF(samplePoint, center, 1.0/(10.0*lightIntensities[i].w));
+      if(objDist < distance){
+        distance = objDist;
+        gradient = sphereHSDFGradient(samplePoint, center);
+      }
+    }
+    //Global Objects
+    for(int i=0; i<NUM_OBJECTS; i++) {
+      if(length(globalObjectRadii[i]) == 0.0){ continue; }
+      vec4 center = globalObjectBoosts[i][3] * globalTransMatrix;
+      float objDist = sphereSDF(samplePoint, center, globalObjectRadii[i].x);
+      if(objDist < distance){
+        distance = objDist;
+        gradient = sphereHSDFGradient(samplePoint, center);
+      }
+    }
+  }
+  return distance;
+}
+
+//NORMAL FUNCTIONS ++++++++++++++++++++++++++++++++++++++++++++++++++++
+// One evaluation that hands back the SDF's gradient as well, instead of six either side of p.
+// The gradient's in the ambient space, so it's put in p's tangent space before it's normalized.
+vec4 estimateNormal(vec4 p){ // normal vector is in tangent hyperplane to hyperboloid at p
+    vec4 gradient;
+    if(hitWhich == 1 || hitWhich == 2){ //global light scene
+      globalSceneSDF(p, invCellBoost, true, gradient);
+    }
+    else{ //local scene
+      localSceneSDF(p, gradient);
+    }
+    return geometryNormalize(geometryTangent(p, gradient), true);
+}
+
+vec4 getRayPoint(vec2 resolution, vec2 fragCoord, bool isRight){ //creates a point that our ray will go through
+    vec2 xy = 0.2*((fragCoord - 0.5*resolution)/resolution.x);
+    vec4 p =  geometryNormalize(vec4(xy,-imagePlaneDepth,1.0), false);
+    return p;
+}
+
+bool isOutsideSimplex(vec4 samplePoint, out mat4 fixMatrix){
+  vec4 kleinSamplePoint = projectToKlein(samplePoint);
+  for(int i=0; i<4; i++){
+    vec3 normal = simplexMirrorsKlein[i].xyz;
+    vec3 offsetSample = kleinSamplePoint.xyz - normal * simplexMirrorsKlein[i].w;  // Deal with any offset.
+    if( dot(offsetSample, normal) > 1e-7 ) {
+      fixMatrix = invGenerators[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+// This function is intended to be geometry-agnostic.
+bool isOutsideCell(vec4 samplePoint, out mat4 fixMatrix){
+  if( useSimplex ) {
+    return isOutsideSimplex( samplePoint, fixMatrix );
+  }
+
+  vec4 kleinSamplePoint = projectToKlein(samplePoint);
+  if(kleinSamplePoint.x > halfCubeWidthKlein){
+    fixMatrix = invGenerators[0];
+    return true;
+  }
+  if(kleinSamplePoint.x < -halfCubeWidthKlein){
+    fixMatrix = invGenerators[1];
+    return true;
+  }
+  if(kleinSamplePoint.y > halfCubeWidthKlein){
+    fixMatrix = invGenerators[2];
+    return true;
+  }
+  if(kleinSamplePoint.y < -halfCubeWidthKlein){
+    fixMatrix = invGenerators[3];
+    return true;
+  }
+  if(kleinSamplePoint.z > halfCubeWidthKlein){
+    fixMatrix = invGenerators[4];
+    return true;
+  }
+  if(kleinSamplePoint.z < -halfCubeWidthKlein){
+    fixMatrix = invGenerators[5];
+    return true;
+  }
+  return false;
+}
+
+// Marches the local scene from startDepth along the ray, instead of from its start - the compute
+// raymarcher's tile has already got that far safely (see raymarchCompute.glsl). startFixMatrix is
+// whatever cells it crossed on the way, and carries on into totalFixMatrix.
+void raymarch(vec4 rO, vec4 rD, float startDepth, mat4 startFixMatrix, out mat4 totalFixMatrix){
+  float globalDepth = MIN_DIST;
+  GeodesicRay localRay = startRay(rO, rD);
+  totalFixMatrix = startFixMatrix;
+  if(startDepth > MIN_DIST){
+    globalDepth = startDepth;
+    vec4 startPoint = geometryNormalize(pointOnGeodesic(rO, rD, startDepth)*startFixMatrix, false);
+    localRay = startRay(startPoint,
+      geometryFixDirection(startPoint, tangentVectorOnGeodesic(rO, rD, startDepth), startFixMatrix));
+  }
+  mat4 fixMatrix = mat4(1.0);
+  int fakeI = 0;
+  MarchStepper stepper = startStepper();
+  
+  // Trace the local scene, then the global scene:
+  for(int i = 0; i< MAX_MARCHING_STEPS; i++){
+    if(fakeI >= maxSteps || globalDepth >= maxDist){
+      //when we break it's as if we reached our max marching steps
+      break;
+    }
+    fakeI++; // [x]
+    countMarchStep();
+    vec4 localEndPoint = rayPoint(localRay);
+    if(isOutsideCell(localEndPoint, fixMatrix)){
+      countCellCrossing();
+      totalFixMatrix *= fixMatrix;
+      localRay = fixRay(localRay, localEndPoint, fixMatrix);
+    }
+    else{
+      float localDist = min(0.5,localSceneSDF(localEndPoint));
+      float localStep;
+      if(marchStep(stepper, localDist, localStep) && localDist < hitEpsilon(globalDepth)){
+        hitWhich = 3;
+        sampleEndPoint = localEndPoint;
+        sampleTangentVector = rayTangent(localRay);
+        break;
+      }
+      advanceRay(localRay, localStep);
+      globalDepth += localStep;
+    }
+  }
+  
+  // How the local scene's march ended, unless the global scene has something nearer.
+  int marchResult = hitWhich == 3 ? MARCH_HIT_LOCAL :
+    (globalDepth >= maxDist ? MARCH_ESCAPED : MARCH_OUT_OF_STEPS);
+
+  // Set localDepth to our new max tracing distance:
+  float localDepth = min(globalDepth, maxDist);
+  globalDepth = MIN_DIST;
+  GeodesicRay globalRay = startRay(rO, rD);
+  stepper = startStepper();
+  fakeI = 0;
+  for(int i = 0; i< MAX_MARCHING_STEPS; i++){
+    if(fakeI >= maxSteps){
+      if(marchResult == MARCH_ESCAPED){ marchResult = MARCH_OUT_OF_STEPS; }
+      break;
+    }
+    fakeI++;
+    countMarchStep();
+    vec4 globalEndPoint = rayPoint(globalRay);
+    float epsilon = hitEpsilon(globalDepth);
+    float globalDist = globalSceneSDF(globalEndPoint, invCellBoost, true, epsilon);
+    float globalStep;
+    bool trusted = marchStep(stepper, globalDist, globalStep);
+    if(trusted && globalDist < epsilon){
+      totalFixMatrix = mat4(1.0);
+      sampleEndPoint = globalEndPoint;
+      sampleTangentVector = rayTangent(globalRay);
+      endMarch(MARCH_HIT_GLOBAL, globalDepth);
+      return;
+    }
+    // Past the local scene's end by the distance alone - an over-relaxed step past it might have
+    // gone over something.
+    if(trusted && globalDepth + globalDist >= localDepth){
+      break;
+    }
+    globalDepth += globalStep;
+    advanceRay(globalRay, globalStep);
+  }
+  endMarch(marchResult, localDepth);
+}
+
+vec4 col(float r) {
+	return vec4(mod(r, 255.0)/255.0, 0.0/255.0, 0.0/255.0, 1.0);
+}
+
+vec4 col(float r, float g) {
+	return vec4(mod(r, 255.0)/255.0, mod(g, 255.0)/255.0, 0.0/255.0, 1.0);
+}
+
+vec4 col(float r, float g, float b) {
+	return vec4(mod(r, 255.0)/255.0, mod(g, 255.0)/255.0, mod(b, 255.0)/255.0, 1.0);
+}
+
+vec4 col(float r, float g, float b, float a) {
+	return vec4(mod(r, 255.0)/255.0, mod(g, 255.0)/255.0, mod(b, 255.0)/255.0, mod(a, 255.0)/255.0);
+}
+
+vec4 col(vec2 v) {
+	return col(v.x, v.y);
+}
+
+vec4 col(vec3 v) {
+	return col(v.x, v.y, v.z);
+}
+
+vec4 col(vec4 v) {
+	return col(v.x, v.y, v.z, 0.5);
+}
+
+vec4 texcube(vec4 samplePoint, mat4 toOrigin){
+    float k = 4.0;
+    vec4 newSP = samplePoint * toOrigin;
+    vec3 p = mod(newSP.xyz,1.0);
+    vec3 n = geometryNormalize(N*toOrigin, true).xyz; //Very hacky you are warned
+    vec3 m = pow(abs(n), vec3(k));
+    vec4 x = texture(uTexture, p.yz);
+    vec4 y = texture(uTexture, p.zx);
+    vec4 z = texture(uTexture, p.xy);
+    return (x*m.x + y*m.y + z*m.z) / (m.x+m.y+m.z);
+}
+
+// The ambient light, and unless useLighting's off, the lights - each let through as much as
+// visibility (shadowVisibility, in lighting.glsl) says.
+vec4 shadeSurfaceLocal(mat4 invObjectBoost, mat4 globalTransMatrix, vec4 visibility) {
+  //--------------------------------------------
+  //Setup Variables
+  //--------------------------------------------
+  vec3 baseColor = vec3(0.0,1.0,1.0);
+  vec4 SP = sampleEndPoint;
+  vec4 V = -sampleTangentVector;
+
+  baseColor = texcube(SP, mat4(1.0)).xyz;
+
+  //Setup up color with ambient component
+  vec3 color = ambient * baseColor;
+  if(useLighting){
+    color += directLighting(V, baseColor, globalTransMatrix, visibility);
+  }
+  return vec4(color, 1.0f);
+}
+
+vec4 shadeSurfaceGlobal(mat4 invObjectBoost, mat4 globalTransMatrix, vec4 visibility) {
+  //--------------------------------------------
+  //Setup Variables
+  //--------------------------------------------
+  vec3 baseColor = vec3(0.0,1.0,1.0);
+  vec4 SP = sampleEndPoint;
+  vec4 V = -sampleTangentVector;
+
+  baseColor = texcube(SP, cellBoost * invObjectBoost).xyz; 
+
+  //Setup up color with ambient component
+  vec3 color = ambient * baseColor;
+  if(useLighting){
+    color += directLighting(V, baseColor, globalTransMatrix, visibility);
+  }
+  return vec4(color, 1.0f);
+}
+
+// The ray through the point fragCoord on the screen, from the camera.
+void pixelRay(vec2 fragCoord, out vec4 rayOrigin, out vec4 rayDirVPrime){
+	rayOrigin = ORIGIN;
+
+	//stereo translations
+	bool isRight = fragCoord.x/screenResolution.x > 0.5;
+	vec4 rayDirV = getRayPoint(screenResolution, fragCoord, isRight);
+
+	rayOrigin *= currentBoost;
+	rayDirV *= currentBoost;
+	//generate direction then transform to hyperboloid ------------------------
+	rayDirVPrime = geometryDirection(rayOrigin, rayDirV); // [x]
+}
+
+// A pixel's ray, up to what it hit: sets hitWhich, sampleEndPoint and the rest, and N if it hit a
+// surface. totalFixMatrix is the cells the ray crossed on the way. startDepth and startFixMatrix are
+// raymarch's.
+void marchPixel(vec2 fragCoord, float startDepth, mat4 startFixMatrix, out mat4 totalFixMatrix){
+	vec4 rayOrigin, rayDirVPrime;
+	pixelRay(fragCoord, rayOrigin, rayDirVPrime);
+	//get our raymarched distance back ------------------------
+	totalFixMatrix = mat4(1.0);
+	raymarch(rayOrigin, rayDirVPrime, startDepth, startFixMatrix, totalFixMatrix);
+	if(hitWhich >= 2){
+		N = estimateNormal(sampleEndPoint);
+	}
+}
+
+// The colour of what marchPixel hit, with the lights' visibility.
+vec4 shadePixel(mat4 totalFixMatrix, vec4 visibility){
+	//Based on hitWhich decide whether we hit a global object, local object, or nothing
+	if(hitWhich == 0) { //Didn't hit anything ------------------------
+		return vec4(0.0, 0.0, 0.0, 1.0);
+	}
+	else if(hitWhich == 1) { // global lights
+		return vec4(1.0, 1.0, 1.0, 1.0);
+	}
+	// objects
+	mat4 globalTransMatrix = invCellBoost * totalFixMatrix;
+	if(hitWhich == 2){ // global objects
+		return shadeSurfaceGlobal(invGlobalObjectBoosts[0], globalTransMatrix, visibility);
+	}
+	// local objects
+	return shadeSurfaceLocal(mat4(1.0), globalTransMatrix, visibility);
+}
+
+// Everything one pixel takes, from its ray to its colour: what fragment.glsl's main does. The
+// shadows come from the last frame's where they can (see shadowCache.glsl).
+vec4 renderPixel(vec2 fragCoord, float startDepth, mat4 startFixMatrix){
+	mat4 totalFixMatrix;
+	marchPixel(fragCoord, startDepth, startFixMatrix, totalFixMatrix);
+	vec4 visibility = vec4(1.0);
+	if(startShadows(totalFixMatrix) && !reuseShadows(visibility)){
+		visibility = shadowVisibility(invCellBoost * totalFixMatrix);
+	}
+	storeShadows(visibility);
+	return shadePixel(totalFixMatrix, visibility);
+}
@@ -0,0 +1,189 @@
+#type compute
+#version 430 core
+
+#define RAYMARCH_COMPUTE
+
+/* raymarchCompute.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// Raymarcher (compute)
+//--------------------------------------------------------------------------------------------------
+// The same raymarch as fragment.glsl, an 8x8 tile of pixels per work group, written straight to the
+// frame's texture. Neighbouring pixels' rays start out nearly the same, so they all spend their
+// first steps getting through the same empty space. Here one invocation marches a cone around the
+// whole tile instead, as far as it safely can, and every pixel starts from there.
+//
+// The shadows can be worked out at half resolution as well (halfResShadows): a pixel in four, the
+// even ones, marches them, and the rest share theirs - unless the neighbours are at a different
+// depth or facing another way, i.e. not on the same surface, when they march their own.
+//
+// Has to have the same tags as fragment.glsl, at the top: SceneLayer swaps them in both.
+
+#tag includes "Sandbox/assets/shaders/includes.glsl"
+
+#include "Sandbox/assets/shaders/general.glsl"
+
+#tag instrumentation "Sandbox/assets/shaders/instrumentationOff.glsl"
+
+#include "Sandbox/assets/shaders/hyperbolic.glsl"
+
+#tag geodesics "Sandbox/assets/shaders/geodesicsExact.glsl"
+
+#include "Sandbox/assets/shaders/edgeTubes.glsl"
+
+#include "Sandbox/assets/shaders/lighting.glsl"
+
+#include "Sandbox/assets/shaders/shadowCache.glsl"
+
+#include "Sandbox/assets/shaders/raymarch.glsl"
+
+#define TILE_SIZE 8
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+
+layout(rgba8, binding = 0) uniform writeonly image2D outImage;
+
+uniform bool halfResShadows;
+
+// How far the whole tile got, and the cells the centre ray crossed on the way.
+shared float tileDepth;
+shared mat4 tileFixMatrix;
+
+// The half resolution shadows: what each of the tile's even pixels found, (x, y) at [x/2 + y/2*4].
+const int SHADOW_LEADERS = TILE_SIZE / 2;
+shared vec4 leaderVisibility[SHADOW_LEADERS * SHADOW_LEADERS];
+shared float leaderDepth[SHADOW_LEADERS * SHADOW_LEADERS]; // -1 for no shadows there.
+shared vec4 leaderNormal[SHADOW_LEADERS * SHADOW_LEADERS];
+
+// The largest angle between the tile's centre ray and any of its pixels' - the corner pixels' are
+// the furthest out.
+float tileConeAngle(vec2 tileOrigin, vec4 centreDir){
+  float minCos = 1.0;
+  vec4 rayOrigin, cornerDir;
+  for(int i = 0; i < 4; i++){
+    vec2 corner = vec2(i & 1, i >> 1) * float(TILE_SIZE - 1) + 0.5;
+    pixelRay(tileOrigin + corner, rayOrigin, cornerDir);
+    minCos = min(minCos, geometryDot(centreDir, cornerDir));
+  }
+  return acos(clamp(minCos, -1.0, 1.0));
+}
+
+// Marches the tile's centre ray through the local scene, keeping a cone of half-angle theta around it
+// clear - so every pixel's ray is clear up to the depth it gets to. Two rays theta apart are
+// 2 asinh(sinh(t) sin(theta/2)) apart at depth t, so a pixel's ray at depth t is that close to the
+// centre's point, and the ball the SDF clears around it covers the pixel's ray for sdf - that much
+// further. It stops once the cone's taken more than half the SDF's step, which leaves the rest to
+// the pixels: they'd be crawling along it.
+void marchTile(vec2 tileOrigin){
+  vec4 rayOrigin, rayDir;
+  pixelRay(tileOrigin + 0.5 * float(TILE_SIZE), rayOrigin, rayDir);
+  float halfAngleSin = sin(0.5 * tileConeAngle(tileOrigin, rayDir));
+
+  float depth = MIN_DIST;
+  mat4 totalFixMatrix = mat4(1.0);
+  mat4 fixMatrix = mat4(1.0);
+  GeodesicRay ray = startRay(rayOrigin, rayDir);
+  for(int i = 0; i < MAX_MARCHING_STEPS; i++){
+    if(i >= maxSteps || depth >= maxDist){
+      break;
+    }
+    countMarchStep();
+    vec4 endPoint = rayPoint(ray);
+    if(isOutsideCell(endPoint, fixMatrix)){
+      countCellCrossing();
+      totalFixMatrix *= fixMatrix;
+      ray = fixRay(ray, endPoint, fixMatrix);
+      continue;
+    }
+    float sdf = min(0.5, localSceneSDF(endPoint));
+    float coneRadius = 2.0 * asinh(sinh(depth) * halfAngleSin);
+    float safeStep = sdf - coneRadius;
+    if(safeStep < 0.5 * sdf || safeStep < EPSILON){
+      break;
+    }
+    advanceRay(ray, safeStep);
+    depth += safeStep;
+  }
+  tileDepth = min(depth, maxDist);
+  tileFixMatrix = totalFixMatrix;
+}
+
+// A pixel that isn't one of the even ones: its visibility from the two or four even ones around it,
+// weighted by how near they are, and by how alike their hits are. False if none of them is alike
+// enough to go by.
+bool upsampleShadows(ivec2 local, out vec4 visibility){
+  visibility = vec4(0.0);
+  ivec2 first = local / 2;
+  ivec2 last = min((local + 1) / 2, ivec2(SHADOW_LEADERS - 1));
+  float tolerance = shadowDepthTolerance(shadowHitDepth);
+  float total = 0.0;
+  float nearby = 0.0;
+  for(int y = first.y; y <= last.y; y++){
+    for(int x = first.x; x <= last.x; x++){
+      int leader = x + y * SHADOW_LEADERS;
+      nearby += 1.0;
+      if(leaderDepth[leader] < 0.0){
+        continue;
+      }
+      float depthDiff = (leaderDepth[leader] - shadowHitDepth) / tolerance;
+      float weight = exp(-depthDiff * depthDiff) * max(geometryDot(leaderNormal[leader], shadowHitNormal), 0.0);
+      visibility += weight * leaderVisibility[leader];
+      total += weight;
+    }
+  }
+  if(total < 0.25 * nearby){
+    return false;
+  }
+  visibility /= total;
+  countShadowReuses();
+  return true;
+}
+
+void main(){
+  ivec2 tileOrigin = ivec2(gl_WorkGroupID.xy) * TILE_SIZE;
+  if(gl_LocalInvocationIndex == 0u){
+    marchTile(vec2(tileOrigin));
+  }
+  barrier();
+
+  // The tiles along the right and top edges hang off the screen. Their spare invocations still have
+  // to get to the barriers, but there's nothing for them to draw.
+  pixelCoord = ivec2(gl_GlobalInvocationID.xy);
+  bool onScreen = all(lessThan(vec2(pixelCoord), screenResolution));
+  mat4 totalFixMatrix = mat4(1.0);
+  bool shadowed = false;
+  bool found = false;
+  vec4 visibility = vec4(1.0);
+  if(onScreen){
+    marchPixel(vec2(pixelCoord) + 0.5, tileDepth, tileFixMatrix, totalFixMatrix);
+    shadowed = startShadows(totalFixMatrix);
+    found = shadowed && reuseShadows(visibility);
+  }
+
+  // The even pixels' shadows, for the rest of the tile to share.
+  ivec2 local = ivec2(gl_LocalInvocationID.xy);
+  bool leader = (local.x & 1) == 0 && (local.y & 1) == 0;
+  if(halfResShadows && leader){
+    if(shadowed && !found){
+      visibility = shadowVisibility(invCellBoost * totalFixMatrix);
+      found = true;
+    }
+    int i = local.x / 2 + local.y / 2 * SHADOW_LEADERS;
+    leaderVisibility[i] = visibility;
+    leaderDepth[i] = shadowHitDepth;
+    leaderNormal[i] = shadowHitNormal;
+  }
+  barrier();
+
+  if(!onScreen){
+    return;
+  }
+  if(shadowed && !found){
+    if(!(halfResShadows && upsampleShadows(local, visibility))){
+      visibility = shadowVisibility(invCellBoost * totalFixMatrix);
+    }
+  }
+  storeShadows(visibility);
+  imageStore(outImage, pixelCoord, shadePixel(totalFixMatrix, visibility));
+  flushMarchCounters();
+}
@@ -0,0 +1,106 @@
+/* shadowCache.glsl */
+
+//--------------------------------------------------------------------------------------------------
+// Shadow history
+//--------------------------------------------------------------------------------------------------
+// The lights don't move, and nor does anything they light, so a point's shadows are the same from
+// one frame to the next - it's only the camera that moves. While useShadowCache is on, every pixel
+// writes the shadows it used into a history, with how far its hit was from the camera. The next
+// frame, a pixel works out where its hit was on the screen the frame before (shadowReprojection is
+// the camera as it was then), and if the history has a hit that far away there, it's the same
+// surface, and the pixel takes its shadows instead of marching them.
+//
+// SceneLayer swaps between two histories, one written while the other's read, and says the last
+// one's no good (shadowHistoryValid) whenever anything but the camera's changed - the cell the
+// camera's in included, as the history's in that cell's frame.
+//
+// One pixel in every SHADOW_REFRESH_FRAMES marches its shadows anyway, in a pattern that goes round
+// all of them, so what's kept can't drift far from what's really there.
+
+// x: the four lights' visibility, packUnorm4x8'd.
+// y: how far the hit was from the camera, as floatBitsToUint - -1 for anything without shadows.
+// The compute raymarcher (raymarchCompute.glsl) hasn't got attachments, so it stores to the same
+// texture as an image instead.
+#ifdef RAYMARCH_COMPUTE
+layout(rgba32ui, binding = 3) uniform writeonly uimage2D shadowHistoryOut;
+#else
+layout(location = 2) out uvec4 out_shadowHistory;
+#endif
+
+const int SHADOW_REFRESH_FRAMES = 8;
+
+// The hit, in the frame the camera's in - before the march crossed any cells - and its normal, and
+// how far it is from the camera. startShadows sets them.
+vec4 shadowHitPoint = ORIGIN;
+vec4 shadowHitNormal = vec4(0.0);
+float shadowHitDepth = -1.0;
+
+// Whether what the pixel hit needs shadows at all: lights and shadows on, and a surface hit.
+// totalFixMatrix is marchPixel's.
+bool startShadows(mat4 totalFixMatrix){
+  shadowHitDepth = -1.0;
+  if(!useLighting || hitWhich < 2 || (!renderShadows[0] && !renderShadows[1])){
+    return false;
+  }
+  mat4 unfix = inverse(totalFixMatrix);
+  shadowHitPoint = sampleEndPoint * unfix;
+  shadowHitNormal = N * unfix;
+  shadowHitDepth = geometryDistance(shadowHitPoint, ORIGIN * currentBoost);
+  return true;
+}
+
+// How far apart two hits' depths can be and still be the same surface. Looking a hit up in the
+// history is only to the nearest pixel, so a slanted surface is a few pixels' footprints out.
+float shadowDepthTolerance(float depth){
+  return 0.01 + 4.0 * pixelFootprint(depth);
+}
+
+void countShadowReuses(){
+  for(int i = 0; i < 4; i++){
+    if(lightIntensities[i].w != 0.0){
+      countShadowReuse(i);
+    }
+  }
+}
+
+// The last frame's shadows for the hit startShadows found, if there are any to be had.
+bool reuseShadows(out vec4 visibility){
+  visibility = vec4(1.0);
+  if(!shadowHistoryValid
+     || (pixelCoord.x + 2 * pixelCoord.y + shadowFrame) % SHADOW_REFRESH_FRAMES == 0){
+    return false;
+  }
+  // Where the camera was, the hit's in front of it at (x, y, -imagePlaneDepth) in the Klein model,
+  // scaled - getRayPoint backwards.
+  vec4 lastCamera = shadowHitPoint * shadowReprojection;
+  vec3 klein = lastCamera.xyz / lastCamera.w;
+  if(klein.z >= 0.0){
+    return false;
+  }
+  vec2 xy = klein.xy * (imagePlaneDepth / -klein.z);
+  ivec2 pixel = ivec2(floor(xy * (screenResolution.x / 0.2) + 0.5 * screenResolution));
+  if(any(lessThan(pixel, ivec2(0))) || any(greaterThanEqual(pixel, textureSize(shadowHistory, 0)))){
+    return false;
+  }
+  uvec4 history = texelFetch(shadowHistory, pixel, 0);
+  float lastDepth = uintBitsToFloat(history.y);
+  if(lastDepth < 0.0
+     || abs(acosh(max(lastCamera.w, 1.0)) - lastDepth) > shadowDepthTolerance(shadowHitDepth)){
+    return false;
+  }
+  visibility = unpackUnorm4x8(history.x);
+  countShadowReuses();
+  return true;
+}
+
+// Whatever the pixel used, for the next frame to look up.
+void storeShadows(vec4 visibility){
+  uvec4 history = uvec4(packUnorm4x8(visibility), floatBitsToUint(shadowHitDepth), 0u, 0u);
+#ifdef RAYMARCH_COMPUTE
+  if(useShadowCache){
+    imageStore(shadowHistoryOut, pixelCoord, history);
+  }
+#else
+  out_shadowHistory = history;
+#endif
+}
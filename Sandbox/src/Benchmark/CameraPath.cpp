@@ -0,0 +1,234 @@
+#include "CameraPath.h"
+
+#include "Input/KeyCodes.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace App
+{
+	namespace
+	{
+		struct NamedKey
+		{
+			const char* name;
+			int keycode;
+		}; // struct NamedKey
+
+		// Everything SceneLayer moves the camera with (and shift, which it checks for).
+		constexpr NamedKey sNamedKeys[] = {
+			{ "W", AU_KEY_W }, { "A", AU_KEY_A }, { "S", AU_KEY_S }, { "D", AU_KEY_D },
+			{ "SPACE", AU_KEY_SPACE }, { "LEFT_CONTROL", AU_KEY_LEFT_CONTROL },
+			{ "UP", AU_KEY_UP }, { "DOWN", AU_KEY_DOWN }, { "LEFT", AU_KEY_LEFT }, { "RIGHT", AU_KEY_RIGHT },
+			{ "RIGHT_SHIFT", AU_KEY_RIGHT_SHIFT }, { "RIGHT_CONTROL", AU_KEY_RIGHT_CONTROL },
+			{ "LEFT_SHIFT", AU_KEY_LEFT_SHIFT },
+		};
+
+		// Indexed by local + 2 * global.
+		constexpr const char* sShadowsNames[] = { "none", "local", "global", "both" };
+
+		bool readMat4(std::istream& in, glm::mat4& m) {
+			for (int column = 0; column < 4; column++) {
+				for (int row = 0; row < 4; row++) {
+					if (!(in >> m[column][row])) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		void writeMat4(std::ostream& out, const glm::mat4& m) {
+			for (int column = 0; column < 4; column++) {
+				for (int row = 0; row < 4; row++) {
+					out << " " << m[column][row];
+				}
+			}
+		}
+	}; // namespace
+
+	const char* keyName(int keycode) {
+		for (const NamedKey& key : sNamedKeys) {
+			if (key.keycode == keycode) {
+				return key.name;
+			}
+		}
+		return nullptr;
+	}
+
+	int keyFromName(const std::string& name) {
+		for (const NamedKey& key : sNamedKeys) {
+			if (name == key.name) {
+				return key.keycode;
+			}
+		}
+		if (!name.empty() && std::all_of(name.begin(), name.end(), [](char c) { return std::isdigit(c); })) {
+			return std::stoi(name);
+		}
+		return -1;
+	}
+
+	const char* shadowsName(const std::array<bool, 2>& shadows) {
+		return sShadowsNames[(shadows[0] ? 1 : 0) + (shadows[1] ? 2 : 0)];
+	}
+
+	double CameraPath::length() const {
+		const double last = keyframes.empty() ? 0.0 : keyframes.back().time;
+		return std::max(duration, last);
+	}
+
+	bool CameraPath::load(const std::string& filename) {
+		std::ifstream file(filename);
+		if (!file) {
+			LOG_ERROR("[CameraPath::load] Couldn't open \"{0}\".", filename);
+			return false;
+		}
+
+		*this = CameraPath();
+		std::string line;
+		for (int lineNumber = 1; std::getline(file, line); lineNumber++) {
+			line = line.substr(0, line.find('#'));
+			std::istringstream in(line);
+			std::string word;
+			if (!(in >> word)) {
+				continue; // Blank, or only a comment.
+			}
+
+			bool ok = true;
+			if (word == "honeycomb") {
+				ok = (bool)(in >> pqr[0] >> pqr[1] >> pqr[2]);
+			}
+			else if (word == "maxSteps") { ok = (bool)(in >> maxSteps); }
+			else if (word == "maxDist") { ok = (bool)(in >> maxDist); }
+			else if (word == "hitPixelFraction") { ok = (bool)(in >> hitPixelFraction); }
+			else if (word == "hitEpsilonMin") { ok = (bool)(in >> hitEpsilonMin); }
+			else if (word == "stepping") {
+				std::string stepping;
+				ok = (bool)(in >> stepping) && (stepping == "relaxed" || stepping == "series");
+				overRelax = stepping == "relaxed";
+			}
+			else if (word == "overRelaxation") { ok = (bool)(in >> overRelaxation); }
+			else if (word == "fov") { ok = (bool)(in >> fov); }
+			else if (word == "tubeRad") { ok = (bool)(in >> tubeRad); }
+			else if (word == "lighting") { ok = (bool)(in >> lighting); }
+			else if (word == "shadows") {
+				std::string name;
+				ok = (bool)(in >> name);
+				auto it = std::find(std::begin(sShadowsNames), std::end(sShadowsNames), name);
+				ok = ok && it != std::end(sShadowsNames);
+				if (ok) {
+					const auto which = it - std::begin(sShadowsNames);
+					shadows = { (which & 1) != 0, (which & 2) != 0 };
+				}
+			}
+			else if (word == "shadowSteps") {
+				for (int& budget : shadowStepBudgets) {
+					ok = ok && (bool)(in >> budget) && budget >= 0;
+				}
+			}
+			else if (word == "shadowCache") { ok = (bool)(in >> shadowCache); }
+			else if (word == "halfResShadows") { ok = (bool)(in >> halfResShadows); }
+			else if (word == "step") { ok = (bool)(in >> stepMs) && stepMs > 0.0f; }
+			else if (word == "warmup") { ok = (bool)(in >> warmup); }
+			else if (word == "duration") { ok = (bool)(in >> duration); }
+			else if (word == "instrument") { ok = (bool)(in >> instrument); }
+			else if (word == "raymarcher") {
+				std::string raymarcher;
+				ok = (bool)(in >> raymarcher) && (raymarcher == "compute" || raymarcher == "fragment");
+				computeRaymarcher = raymarcher == "compute";
+			}
+			else if (word == "tag") {
+				std::string tag, file;
+				ok = (bool)(in >> tag >> file);
+				tags.emplace_back(tag, file);
+			}
+			else if (word == "boost") {
+				CameraKeyframe keyframe;
+				keyframe.kind = CameraKeyframe::Kind::Boost;
+				ok = (in >> keyframe.time) && readMat4(in, keyframe.currentBoost) && readMat4(in, keyframe.cellBoost);
+				keyframes.push_back(keyframe);
+			}
+			else if (word == "key") {
+				CameraKeyframe keyframe;
+				std::string action, key;
+				ok = (in >> keyframe.time >> action >> key) && (action == "press" || action == "release");
+				keyframe.pressed = action == "press";
+				keyframe.keycode = keyFromName(key);
+				ok = ok && keyframe.keycode != -1;
+				keyframes.push_back(keyframe);
+			}
+			else {
+				ok = false;
+			}
+
+			if (!ok) {
+				LOG_ERROR("[CameraPath::load] \"{0}\", line {1}: couldn't make sense of \"{2}\".", filename,
+					lineNumber, line);
+				return false;
+			}
+		}
+
+		// Stable, so keyframes at the same time stay in the order they were written in.
+		std::stable_sort(keyframes.begin(), keyframes.end(),
+			[](const CameraKeyframe& a, const CameraKeyframe& b) { return a.time < b.time; });
+		return true;
+	}
+
+	bool CameraPath::save(const std::string& filename) const {
+		std::ofstream file(filename, std::ios::trunc);
+		if (!file) {
+			LOG_ERROR("[CameraPath::save] Couldn't open \"{0}\".", filename);
+			return false;
+		}
+
+		// Enough digits that the boosts read back exactly.
+		file << std::setprecision(9);
+		file << "# A camera path, see Sandbox/src/Benchmark/CameraPath.h.\n";
+		file << "honeycomb " << pqr[0] << " " << pqr[1] << " " << pqr[2] << "\n";
+		file << "maxSteps " << maxSteps << "\n";
+		file << "maxDist " << maxDist << "\n";
+		file << "hitPixelFraction " << hitPixelFraction << "\n";
+		file << "hitEpsilonMin " << hitEpsilonMin << "\n";
+		file << "stepping " << (overRelax ? "relaxed" : "series") << "\n";
+		file << "overRelaxation " << overRelaxation << "\n";
+		file << "fov " << fov << "\n";
+		file << "tubeRad " << tubeRad << "\n";
+		file << "lighting " << lighting << "\n";
+		file << "shadows " << shadowsName(shadows) << "\n";
+		file << "shadowSteps " << shadowStepBudgets[0] << " " << shadowStepBudgets[1] << " "
+		     << shadowStepBudgets[2] << " " << shadowStepBudgets[3] << "\n";
+		file << "shadowCache " << shadowCache << "\n";
+		file << "halfResShadows " << halfResShadows << "\n";
+		file << "step " << stepMs << "\n";
+		file << "warmup " << warmup << "\n";
+		if (duration > 0.0) {
+			file << "duration " << duration << "\n";
+		}
+		if (instrument) {
+			file << "instrument 1\n";
+		}
+		if (computeRaymarcher) {
+			file << "raymarcher compute\n";
+		}
+		for (const auto& [tag, tagFile] : tags) {
+			file << "tag " << tag << " " << tagFile << "\n";
+		}
+		for (const CameraKeyframe& keyframe : keyframes) {
+			if (keyframe.kind == CameraKeyframe::Kind::Boost) {
+				file << "boost " << keyframe.time;
+				writeMat4(file, keyframe.currentBoost);
+				writeMat4(file, keyframe.cellBoost);
+				file << "\n";
+			}
+			else {
+				const char* name = keyName(keyframe.keycode);
+				file << "key " << keyframe.time << (keyframe.pressed ? " press " : " release ")
+				     << (name ? std::string(name) : std::to_string(keyframe.keycode)) << "\n";
+			}
+		}
+		return (bool)file;
+	}
+}; // namespace App
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Aulys.h"
+
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* A camera path: where to start, what to press when, and the settings to render it with - so that
+ * a run through the scene can be played back the same way every time, and timed (see
+ * CameraPathLayer).
+ *
+ * Paths are text, a line per setting or keyframe, so they can be written by hand as well as
+ * recorded:
+ *
+ *     # Anything after a # is ignored.
+ *     honeycomb 4 3 6
+ *     maxSteps 29
+ *     maxDist 6.4
+ *     hitPixelFraction 0.5  # How much of a pixel counts as a hit, see hitEpsilon in raymarch.glsl.
+ *     hitEpsilonMin 0.0001
+ *     stepping relaxed    # Over-relaxed sphere tracing, or series (the default) for the series distance.
+ *     overRelaxation 1.3
+ *     fov 90
+ *     tubeRad 0.15
+ *     lighting 1          # The lights, on top of the ambient.
+ *     shadows local       # Whose shadows are marched: none (the default), local, global or both.
+ *     shadowSteps 32 32 32 32  # Each light's shadow march budget, see shadowMarch in lighting.glsl.
+ *     shadowCache 1       # Keep shadows from frame to frame, see shadowCache.glsl.
+ *     halfResShadows 0    # Shadows for a pixel in four (the compute raymarcher's only).
+ *     step 8.333          # Simulated milliseconds per frame.
+ *     warmup 30           # Frames rendered before the path starts, and not timed.
+ *     duration 12         # Seconds. Without it, the path ends at its last keyframe.
+ *     instrument 1        # Count the raymarcher's work as well (see MarchCounters). Slower.
+ *     raymarcher compute  # raymarchCompute.glsl's tiles, or fragment (the default) for fragment.glsl.
+ *     tag geodesics Sandbox/assets/shaders/geodesicsIncremental.glsl  # Swaps a shader tag's file.
+ *     boost 0 <currentBoost> <cellBoost>  # Two column-major matrices, 16 numbers each.
+ *     key 0.5 press W
+ *     key 3.25 release W
+ *
+ * Keyframes are at a time in seconds from the start of the path, and happen before the fixed step
+ * nearest to it. `boost` puts the camera somewhere, exactly, as "Reset Position" does. `key`
+ * presses or releases a key (by name, see keyName, or by its AU_KEY_ code), which moves the camera
+ * the same way the keyboard would - which is what a recorded path is made of. */
+
+namespace App
+{
+	struct CameraKeyframe
+	{
+		enum class Kind { Boost, Key };
+
+		double time = 0.0;
+		Kind kind = Kind::Key;
+
+		// Kind::Boost
+		glm::mat4 currentBoost{ 1.0f };
+		glm::mat4 cellBoost{ 1.0f };
+
+		// Kind::Key
+		int keycode = 0;
+		bool pressed = false;
+	}; // struct CameraKeyframe
+
+	struct CameraPath
+	{
+		std::array<int, 3> pqr = { 4, 3, 6 };
+		uint32_t maxSteps = 29;
+		float maxDist = 6.4f;
+		float hitPixelFraction = 0.5f;
+		float hitEpsilonMin = 0.0001f;
+		bool overRelax = false; // Over-relaxed sphere tracing instead of the series distance.
+		float overRelaxation = 1.3f;
+		float fov = 90.0f;
+		float tubeRad = 0.15f;
+		bool lighting = true;
+		std::array<bool, 2> shadows = { false, false }; // Local, global.
+		std::array<int, 4> shadowStepBudgets = { 32, 32, 32, 32 };
+		bool shadowCache = true;
+		bool halfResShadows = false;
+		float stepMs = 8.333f;
+		uint32_t warmup = 30;
+		double duration = 0.0; // 0 ends it at the last keyframe.
+		bool instrument = false; // Plays it with the march stats on, and reports their counts.
+		bool computeRaymarcher = false; // Plays it with raymarchCompute.glsl instead of fragment.glsl.
+		// Shader tags to swap before it plays: the tag, and the file it should include (no quotes).
+		std::vector<std::pair<std::string, std::string>> tags{};
+
+		// In time order.
+		std::vector<CameraKeyframe> keyframes{};
+
+		// How long it plays for, in seconds.
+		double length() const;
+
+		// Returns false (having logged what's wrong, and where) if the file couldn't be read.
+		bool load(const std::string& filename);
+		bool save(const std::string& filename) const;
+	}; // struct CameraPath
+
+	// The names paths use for the keys SceneLayer listens to - nullptr for any other key.
+	const char* keyName(int keycode);
+	// -1 if it's neither one of those names nor a number.
+	int keyFromName(const std::string& name);
+	// What `shadows` calls which shadows are on: none, local, global or both.
+	const char* shadowsName(const std::array<bool, 2>& shadows);
+}; // namespace App
@@ -0,0 +1,69 @@
+#include "MarchCounters.h"
+
+namespace App
+{
+	MarchCounters::MarchCounters() {
+		for (Pending& pending : mPending) {
+			pending.buffer = ShaderStorageBuffer::create(sCounters * sSlots * sizeof(uint32_t), sBinding);
+		}
+	}
+
+	void MarchCounters::beginFrame(uint64_t frame) {
+		// Whatever's finished, oldest first - the fences go off in order, so stop at the first that hasn't.
+		while (mPending[mOldest].inFlight && mPending[mOldest].buffer->isReady()) {
+			collect(mPending[mOldest]);
+			mOldest = (mOldest + 1) % sBuffers;
+		}
+
+		Pending& next = mPending[mNext];
+		if (next.inFlight) {
+			// The GPU's sBuffers frames behind, and this is the oldest of them, so it waits.
+			mStalls++;
+			collect(next);
+			mOldest = (mOldest + 1) % sBuffers;
+		}
+
+		next.buffer->clear();
+		next.buffer->bind();
+		next.frame = frame;
+		next.inFlight = true;
+	}
+
+	void MarchCounters::endFrame() {
+		mPending[mNext].buffer->fence();
+		mNext = (mNext + 1) % sBuffers;
+	}
+
+	void MarchCounters::collect(Pending& pending) {
+		std::array<uint32_t, sCounters * sSlots> slots;
+		pending.buffer->getData(slots.data(), sizeof(slots));
+		pending.inFlight = false;
+
+		// In the order of the block's members.
+		std::array<uint64_t, sCounters> totals{};
+		for (uint32_t counter = 0; counter < sCounters; counter++) {
+			for (uint32_t slot = 0; slot < sSlots; slot++) {
+				totals[counter] += slots[counter * sSlots + slot];
+			}
+		}
+
+		MarchCounts counts;
+		counts.frame = pending.frame;
+		counts.steps = totals[0];
+		counts.localSDFs = totals[1];
+		counts.globalSDFs = totals[2];
+		counts.shadowSteps = totals[3];
+		counts.outOfSteps = totals[4];
+		counts.pixels = totals[5];
+		counts.backtracks = totals[6];
+		for (uint32_t light = 0; light < MarchCounts::sLights; light++) {
+			counts.lightShadowSteps[light] = totals[7 + light];
+			counts.shadowMarches[light] = totals[7 + MarchCounts::sLights + light];
+			counts.shadowReuses[light] = totals[7 + 2 * MarchCounts::sLights + light];
+		}
+		mLatest = counts;
+		if (mListener) {
+			mListener(counts);
+		}
+	}
+}; // namespace App
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Aulys.h"
+using namespace Aulys;
+
+#include <array>
+#include <functional>
+
+/* How much work the raymarcher did, over a whole frame: steps, SDF calls, shadow steps (light by
+ * light as well), the pixels that ran out of steps, and the over-relaxed steps taken back - so a
+ * shader change can be judged on the work it saves as well as the time.
+ *
+ * instrumentation.glsl adds every pixel's numbers to a MarchCounters block with atomics, while the
+ * march stats are on (see MarchStats.h, which this goes alongside). Reading that back straight away
+ * would wait for the frame to finish, so each frame gets its own buffer out of a few, and a frame's
+ * counts are only read once its fence says the GPU's done with it - usually a frame or two later.
+ * They're handed to the listener then, in frame order. */
+
+namespace App
+{
+	// One frame's totals. Sums of every pixel's, so they go up with the resolution.
+	struct MarchCounts
+	{
+		uint64_t frame = 0; // Counted like the FramePacer's.
+		uint64_t steps = 0;       // raymarch's, both loops.
+		uint64_t localSDFs = 0;   // localSceneSDF calls, the normals' included.
+		uint64_t globalSDFs = 0;  // globalSceneSDF calls, likewise.
+		uint64_t shadowSteps = 0; // shadowMarch's.
+		uint64_t outOfSteps = 0;  // Pixels whose march hit maxSteps.
+		uint64_t pixels = 0;
+		uint64_t backtracks = 0;  // Over-relaxed steps that had to be taken back, shadows' included.
+
+		// Light by light (the four in includes.glsl's Honeycomb block): shadowSteps, the shadow
+		// marches they were in, and the shadows that didn't need one - kept from the last frame, or
+		// shared by a neighbour (see shadowCache.glsl).
+		static constexpr uint32_t sLights = 4;
+		std::array<uint64_t, sLights> lightShadowSteps{};
+		std::array<uint64_t, sLights> shadowMarches{};
+		std::array<uint64_t, sLights> shadowReuses{};
+
+		// Per pixel, for comparing across resolutions.
+		float perPixel(uint64_t count) const { return pixels ? (float)count / (float)pixels : 0.0f; }
+	}; // struct MarchCounts
+
+	class MarchCounters
+	{
+	public:
+		MarchCounters();
+
+		// Called with each frame's counts once they're back.
+		inline void setListener(std::function<void(const MarchCounts&)> listener) {
+			mListener = std::move(listener);
+		}
+
+		// Before the frame's drawn: reports whatever frames the GPU's finished with, and gets a
+		// buffer ready for this one. Only waits if every buffer's still in use.
+		void beginFrame(uint64_t frame);
+		// Once it's been drawn.
+		void endFrame();
+
+		// The newest counts that have come back.
+		const MarchCounts& getLatest() const { return mLatest; }
+		// How many times beginFrame had to wait for a buffer.
+		uint64_t getStalls() const { return mStalls; }
+
+	private:
+		// instrumentation.glsl's MarchCounters block: each counter, spread over sSlots uints.
+		static constexpr uint32_t sBinding = 2;
+		static constexpr uint32_t sSlots = 64;   // MARCH_COUNTER_SLOTS
+		static constexpr uint32_t sCounters = 7 + 3 * MarchCounts::sLights;
+		// Frames in flight, counting the one being drawn. Enough for the FramePacer's most queued
+		// frames, and one more.
+		static constexpr uint32_t sBuffers = 5;
+
+		struct Pending
+		{
+			Ref<ShaderStorageBuffer> buffer;
+			uint64_t frame = 0;
+			bool inFlight = false;
+		}; // struct Pending
+
+		// Reads one back (waiting if it has to) and reports it.
+		void collect(Pending& pending);
+
+		std::array<Pending, sBuffers> mPending;
+		// Where the oldest in-flight frame is. They're used in turn, so that's where to look first.
+		uint32_t mOldest = 0, mNext = 0;
+		std::function<void(const MarchCounts&)> mListener;
+		MarchCounts mLatest;
+		uint64_t mStalls = 0;
+	}; // class MarchCounters
+}; // namespace App
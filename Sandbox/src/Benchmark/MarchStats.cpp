@@ -0,0 +1,150 @@
+#include "MarchStats.h"
+
+namespace App
+{
+	static_assert(sizeof(MarchStats::Histogram) == sizeof(uint32_t) * (MarchStats::sStepBins
+		+ MarchStats::sCrossingBins + MarchStats::sDepthBins + MarchStats::sResultBins),
+		"MarchStats::Histogram has to be packed like marchStats.glsl's MarchHistogram block.");
+
+	namespace
+	{
+		// The smallest bin with at least fraction of the count at or below it.
+		template<size_t N>
+		uint32_t percentile(const std::array<uint32_t, N>& bins, uint64_t count, double fraction) {
+			const double target = fraction * (double)count;
+			uint64_t seen = 0;
+			for (uint32_t i = 0; i < N; i++) {
+				seen += bins[i];
+				if (seen > 0 && (double)seen >= target) {
+					return i;
+				}
+			}
+			return N - 1;
+		}
+
+		template<size_t N>
+		uint32_t highestBin(const std::array<uint32_t, N>& bins) {
+			for (uint32_t i = N; i > 0; i--) {
+				if (bins[i - 1]) {
+					return i - 1;
+				}
+			}
+			return 0;
+		}
+
+		template<size_t N>
+		float meanBin(const std::array<uint32_t, N>& bins, uint64_t count) {
+			double sum = 0.0;
+			for (uint32_t i = 0; i < N; i++) {
+				sum += (double)i * bins[i];
+			}
+			return count ? (float)(sum / (double)count) : 0.0f;
+		}
+
+		// For ImGui::PlotHistogram, straight from the bins.
+		float binValue(void* bins, int i) {
+			return (float)static_cast<const uint32_t*>(bins)[i];
+		}
+	}; // namespace
+
+	MarchStats::Summary MarchStats::summarise(const Histogram& histogram) {
+		Summary summary;
+		for (uint32_t i = 1; i < sResultBins; i++) {
+			summary.pixels += histogram.results[i];
+		}
+		if (summary.pixels == 0) {
+			return summary;
+		}
+
+		summary.meanSteps = meanBin(histogram.steps, summary.pixels);
+		summary.medianSteps = percentile(histogram.steps, summary.pixels, 0.5);
+		summary.p95Steps = percentile(histogram.steps, summary.pixels, 0.95);
+		summary.maxSteps = highestBin(histogram.steps);
+		summary.meanCrossings = meanBin(histogram.crossings, summary.pixels);
+		summary.maxCrossings = highestBin(histogram.crossings);
+
+		const auto fraction = [&](Result result) {
+			return (float)histogram.results[(uint32_t)result] / (float)summary.pixels;
+		};
+		summary.escaped = fraction(Result::Escaped);
+		summary.hitLocal = fraction(Result::HitLocal);
+		summary.hitGlobal = fraction(Result::HitGlobal);
+		summary.outOfSteps = fraction(Result::OutOfSteps);
+		return summary;
+	}
+
+	MarchStats::MarchStats(uint32_t width, uint32_t height)
+		: mWidth(width), mHeight(height) {
+		mShader = Shader::create(Path("Sandbox/assets/shaders/marchStats.glsl"));
+		mMarchTexture = Texture2D::create(width, height, TextureFormat::RGBA32UI);
+		mHeatmap = Texture2D::create(width, height, TextureFormat::RGBA8);
+		mHistogramBuffer = ShaderStorageBuffer::create(sizeof(Histogram), sHistogramBinding);
+	}
+
+	void MarchStats::update(uint32_t maxSteps, float maxDist) {
+		// Last frame's dispatch has had a whole frame to finish in, so this shouldn't wait.
+		if (mDispatched) {
+			mHistogramBuffer->getData(&mHistogram, sizeof(Histogram));
+			mSummary = summarise(mHistogram);
+			mFrames++;
+		}
+		mMaxSteps = maxSteps;
+		mMaxDist = maxDist;
+
+		float range = 1.0f;
+		switch (mView) {
+			case View::Steps:         range = 2.0f * maxSteps; break; // Both loops, all the way.
+			case View::CellCrossings: range = mCrossingRange; break;
+			case View::Depth:         range = maxDist; break;
+			case View::Result:        break;
+		}
+
+		mHistogramBuffer->clear();
+		mShader->bind();
+		mShader->uploadUniformInt("view", (int)mView);
+		mShader->uploadUniformFloat("range", range > 0.0f ? range : 1.0f);
+		mShader->uploadUniformFloat("maxDist", maxDist);
+		mMarchTexture->bindImage(0, Texture::Access::ReadOnly);
+		mHeatmap->bindImage(1, Texture::Access::WriteOnly);
+		RenderCommand::dispatchCompute((mWidth + sTileSize - 1) / sTileSize, (mHeight + sTileSize - 1) / sTileSize);
+		mDispatched = true;
+	}
+
+	void MarchStats::onImGuiRender() {
+		const char* views[] = { "Steps", "Cell crossings", "Depth", "How it ended" };
+		int view = (int)mView;
+		if (ImGui::Combo("Show", &view, views, IM_ARRAYSIZE(views))) {
+			mView = (View)view;
+		}
+		if (mView == View::CellCrossings) {
+			ImGui::DragFloat("Top of scale", &mCrossingRange, 0.05f, 1.0f, (float)sCrossingBins);
+		}
+
+		// Keeps the render's aspect ratio, as wide as the window.
+		const float width = ImGui::GetContentRegionAvail().x;
+		ImGui::Image((void*)(intptr_t)mHeatmap->getID(), ImVec2(width, width * mHeight / (float)mWidth),
+		             ImVec2(0, 1), ImVec2(1, 0));
+
+		if (mFrames == 0) {
+			return;
+		}
+		const Summary& s = mSummary;
+		ImGui::Text("steps: mean %.1f  median %u  p95 %u  max %u", s.meanSteps, s.medianSteps, s.p95Steps,
+		            s.maxSteps);
+		ImGui::Text("cell crossings: mean %.2f  max %u", s.meanCrossings, s.maxCrossings);
+		ImGui::Text("escaped %.1f%%  local %.1f%%  global %.1f%%  out of steps %.1f%%", 100.0f * s.escaped,
+		            100.0f * s.hitLocal, 100.0f * s.hitGlobal, 100.0f * s.outOfSteps);
+
+		// Only as far as a ray could get, so the interesting bit isn't squashed into the left.
+		const int stepBins = std::min<int>(sStepBins, 2 * mMaxSteps + 1);
+		ImGui::PlotHistogram("Steps", binValue, mHistogram.steps.data(), stepBins, 0, nullptr, 0.0f,
+		                     FLT_MAX, ImVec2(0, 80));
+		const int crossingBins = std::min<int>(sCrossingBins, s.maxCrossings + 2);
+		ImGui::PlotHistogram("Crossings", binValue, mHistogram.crossings.data(), crossingBins, 0, nullptr,
+		                     0.0f, FLT_MAX, ImVec2(0, 60));
+		char depthLabel[32];
+		std::snprintf(depthLabel, sizeof(depthLabel), "Depth (0-%.1f)", mMaxDist);
+		ImGui::PlotHistogram(depthLabel, binValue, mHistogram.depths.data(), sDepthBins, 0, nullptr, 0.0f,
+		                     FLT_MAX, ImVec2(0, 60));
+	}
+}; // namespace App
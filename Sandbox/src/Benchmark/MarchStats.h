@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Aulys.h"
+using namespace Aulys;
+
+#include <array>
+
+/* Where the raymarcher's step budget goes, pixel by pixel - so maxSteps, EPSILON and tubeRad can be
+ * tuned from what the rays actually do.
+ *
+ * While it's on, SceneLayer compiles fragment.glsl with instrumentation.glsl in (the
+ * "instrumentation" tag), which writes each ray's step count, cell crossings, depth and how it ended
+ * to a second colour attachment, getMarchTexture. update then runs marchStats.glsl over that: it
+ * colours one of them into the heatmap, and counts all of them into histograms, on the GPU. Only the
+ * histograms come back to us, a frame late, so reading them never waits on the frame just drawn. */
+
+namespace App
+{
+	class MarchStats
+	{
+	public:
+		// What the heatmap shows. Matches `view` in marchStats.glsl.
+		enum class View : int { Steps = 0, CellCrossings, Depth, Result };
+
+		// How a ray's march ended. Matches the MARCH_ constants in general.glsl.
+		enum class Result : uint32_t { None = 0, Escaped, HitLocal, HitGlobal, OutOfSteps };
+
+		// These match marchStats.glsl.
+		static constexpr uint32_t sStepBins = 256;
+		static constexpr uint32_t sCrossingBins = 128;
+		static constexpr uint32_t sDepthBins = 64;
+		static constexpr uint32_t sResultBins = 8;
+
+		// One frame's histograms, laid out as marchStats.glsl's MarchHistogram block.
+		struct Histogram
+		{
+			std::array<uint32_t, sStepBins> steps{};
+			std::array<uint32_t, sCrossingBins> crossings{};
+			std::array<uint32_t, sDepthBins> depths{};
+			std::array<uint32_t, sResultBins> results{};
+		}; // struct Histogram
+
+		// The numbers worth looking at in a Histogram.
+		struct Summary
+		{
+			uint64_t pixels = 0;
+			float meanSteps = 0.0f;
+			uint32_t medianSteps = 0, p95Steps = 0, maxSteps = 0;
+			float meanCrossings = 0.0f;
+			uint32_t maxCrossings = 0;
+			// Fractions of the pixels, by how their march ended.
+			float escaped = 0.0f, hitLocal = 0.0f, hitGlobal = 0.0f, outOfSteps = 0.0f;
+		}; // struct Summary
+
+		static Summary summarise(const Histogram& histogram);
+
+		MarchStats(uint32_t width, uint32_t height);
+
+		// Where the fragment shader's march output goes: colour attachment 1 of whatever it draws to.
+		const Ref<Texture2D>& getMarchTexture() const { return mMarchTexture; }
+		const Ref<Texture2D>& getHeatmap() const { return mHeatmap; }
+
+		// Call once the frame's been drawn. Picks up the last frame's histograms, then makes this
+		// frame's heatmap and histograms. maxSteps and maxDist are the raymarcher's, for the scales.
+		void update(uint32_t maxSteps, float maxDist);
+
+		const Histogram& getHistogram() const { return mHistogram; }
+		const Summary& getSummary() const { return mSummary; }
+		// How many frames' histograms have been read back - none for the first frame.
+		uint64_t getFrames() const { return mFrames; }
+
+		// The heatmap, histograms and the rest, inside whatever ImGui window is open.
+		void onImGuiRender();
+
+	private:
+		static constexpr uint32_t sHistogramBinding = 1; // binding = 1 in marchStats.glsl.
+		static constexpr uint32_t sTileSize = 16;        // local_size_x and _y in marchStats.glsl.
+
+		uint32_t mWidth, mHeight;
+		Ref<Shader> mShader;
+		Ref<Texture2D> mMarchTexture;
+		Ref<Texture2D> mHeatmap;
+		Ref<ShaderStorageBuffer> mHistogramBuffer;
+		bool mDispatched = false; // Is there a frame's histogram in mHistogramBuffer to read?
+
+		Histogram mHistogram;
+		Summary mSummary;
+		uint64_t mFrames = 0;
+		uint32_t mMaxSteps = 0; // What the last update was given, for the plots.
+		float mMaxDist = 0.0f;
+
+		View mView = View::Steps;
+		float mCrossingRange = 8.0f; // Crossings at the top of the heatmap's colour scale.
+	}; // class MarchStats
+}; // namespace App
@@ -3,7 +3,9 @@
 #include "Aulys.h"
 #include "Events/Event.h"
 
+#include "Benchmark/MarchCounters.h"
 #include "Geometry/Scene.h"
+#include "Geometry/HoneycombParams.h"
 
 using namespace Aulys;
 
@@ -24,19 +26,21 @@ namespace App
 
 			SizeChanged, FOVChanged,
 
-			MaxStepsChanged, MaxDistChanged,
+			MaxStepsChanged, MaxDistChanged, HitPixelFractionChanged, HitEpsilonMinChanged,
+			UseOverRelaxationChanged, OverRelaxationChanged,
 
 			ScaleChanged,
 
 			AttenuationChanged, RenderShadsChanged, ShadSoftChanged, LightPositionsChanged,
-			LightIntensitiesChanged, AmbientChanged,
+			LightIntensitiesChanged, AmbientChanged, UseLightingChanged, ShadowStepBudgetsChanged,
+			UseShadowCacheChanged, HalfResShadowsChanged,
 
 			TubeRadiusChanged, GeometryChanged, CellPositionChanged, CellSurfaceOffsetChanged,
 			CellBoostChanged, invCellBoostChanged, invGeneratorsChanged, CurrentBoostChanged,
 			GlobalObjectBoostsChanged, invGlobalObjectBoostsChanged, GlobalObjectRadiiChanged,
 			VertexPositionChanged, VertexSurfaceOffsetChanged, UseSimplexChanged,
 			SimplexMirrorsChanged, SimplexDualPointsChanged, CutChanged,
-			HalfCubeDualPointChanged, HalfCubeWidthChanged,
+			HalfCubeDualPointChanged, HalfCubeWidthChanged, HoneycombChanged,
 
 			TextureChanged,
 
@@ -44,6 +48,8 @@ namespace App
 
 			TagSwapRequested, RequestUpdateUniforms, UploadObjectsData, MovementSpeedChanged, RotSpeedChanged,
 
+			MarchStatsRequested, MarchCountsReady, ComputeRaymarcherRequested,
+
 			DebugInfoChanged, DebugVector2Changed, 
 		};
 	}; // namespace EventType
@@ -166,6 +172,70 @@ namespace App
 	
 	}; // class MaxStepsChangedEvent : public UniformChangedEvent<uint32_t>
 
+	// How much of a pixel's footprint counts as a hit (see hitEpsilon in raymarch.glsl).
+	class HitPixelFractionChangedEvent : public UniformChangedEvent<float>
+	{
+	public:
+		HitPixelFractionChangedEvent(const std::string& name, const float* val)
+			: UniformChangedEvent(name, val) {};
+
+		HitPixelFractionChangedEvent(const float* val)
+			: UniformChangedEvent("hitPixelFraction", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::HitPixelFractionChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::RaymarchSettingsChanged, UniformChangedEvent);
+	private:
+	
+	}; // class HitPixelFractionChangedEvent : public UniformChangedEvent<float>
+
+	// The smallest distance that counts as a hit, however near the surface is.
+	class HitEpsilonMinChangedEvent : public UniformChangedEvent<float>
+	{
+	public:
+		HitEpsilonMinChangedEvent(const std::string& name, const float* val)
+			: UniformChangedEvent(name, val) {};
+
+		HitEpsilonMinChangedEvent(const float* val)
+			: UniformChangedEvent("hitEpsilonMin", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::HitEpsilonMinChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::RaymarchSettingsChanged, UniformChangedEvent);
+	private:
+	
+	}; // class HitEpsilonMinChangedEvent : public UniformChangedEvent<float>
+
+	// Over-relaxed sphere tracing instead of the series distance (see MarchStepper in general.glsl).
+	class UseOverRelaxationChangedEvent : public UniformChangedEvent<bool>
+	{
+	public:
+		UseOverRelaxationChangedEvent(const std::string& name, const bool* val)
+			: UniformChangedEvent(name, val) {};
+
+		UseOverRelaxationChangedEvent(const bool* val)
+			: UniformChangedEvent("useOverRelaxation", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::UseOverRelaxationChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::RaymarchSettingsChanged, UniformChangedEvent);
+	private:
+	
+	}; // class UseOverRelaxationChangedEvent : public UniformChangedEvent<bool>
+
+	// How many times the distance an over-relaxed step goes, from 1 to 2.
+	class OverRelaxationChangedEvent : public UniformChangedEvent<float>
+	{
+	public:
+		OverRelaxationChangedEvent(const std::string& name, const float* val)
+			: UniformChangedEvent(name, val) {};
+
+		OverRelaxationChangedEvent(const float* val)
+			: UniformChangedEvent("overRelaxation", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::OverRelaxationChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::RaymarchSettingsChanged, UniformChangedEvent);
+	private:
+	
+	}; // class OverRelaxationChangedEvent : public UniformChangedEvent<float>
+
 	class AttenuationChangedEvent : public UniformChangedEvent<int> 
 	{
 	public:
@@ -249,6 +319,28 @@ namespace App
 	private:
 	}; // class GeometryChangedEvent : public Event
 
+	// Everything that goes with a {p,q,r} at once - params comes out of the UI's HoneycombCache,
+	// uniforms is what goes in the Honeycomb uniform block, in one write.
+	class HoneycombChangedEvent : public Event
+	{
+	public:
+		HoneycombChangedEvent(const HoneycombParams* params, const HoneycombUniforms* uniforms)
+			: params(params), uniforms(uniforms) {};
+
+		virtual std::string toString() const override {
+			std::stringstream ss;
+			ss << "HoneycombChangedEvent({" << params->pqr[0] << ", " << params->pqr[1] << ", "
+				<< params->pqr[2] << "})";
+			return ss.str();
+		}
+
+		EVENT_CUSTOM_TYPE(EventTypes::HoneycombChanged);
+		EVENT_CUSTOM_CATEGORY(EventCategory::SceneGeometryChanged | EventCategory::SceneChanged);
+
+		const HoneycombParams* params;
+		const HoneycombUniforms* uniforms;
+	}; // class HoneycombChangedEvent : public Event
+
 	class CellPositionChangedEvent : public UniformChangedEvent<glm::vec4> 
 	{
 	public:
@@ -666,6 +758,71 @@ namespace App
 	private:
 	}; // class AmbientChangedEvent : public UniformChangedEvent<float>
 
+	// The lights on top of the ambient, or only the ambient (see directLighting in lighting.glsl).
+	class UseLightingChangedEvent : public UniformChangedEvent<bool>
+	{
+	public:
+		UseLightingChangedEvent(const std::string& name, const bool* val)
+			: UniformChangedEvent(name, val) {};
+
+		UseLightingChangedEvent(const bool* val)
+			: UniformChangedEvent("useLighting", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::UseLightingChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::LightingSettingsChanged, UniformChangedEvent);
+	private:
+
+	}; // class UseLightingChangedEvent : public UniformChangedEvent<bool>
+
+	// The most steps each of the four lights' shadow marches may take (see shadowMarch).
+	class ShadowStepBudgetsChangedEvent : public UniformChangedEvent<std::array<int, 4>>
+	{
+	public:
+		ShadowStepBudgetsChangedEvent(const std::string& name, const std::array<int, 4>* val)
+			: UniformChangedEvent(name, val) {};
+
+		ShadowStepBudgetsChangedEvent(const std::array<int, 4>* val)
+			: UniformChangedEvent("shadowStepBudgets", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::ShadowStepBudgetsChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::LightingSettingsChanged, UniformChangedEvent);
+	private:
+
+	}; // class ShadowStepBudgetsChangedEvent : public UniformChangedEvent<std::array<int, 4>>
+
+	// Keeps the shadows from frame to frame (see shadowCache.glsl). SceneLayer makes the histories
+	// when it's turned on.
+	class UseShadowCacheChangedEvent : public UniformChangedEvent<bool>
+	{
+	public:
+		UseShadowCacheChangedEvent(const std::string& name, const bool* val)
+			: UniformChangedEvent(name, val) {};
+
+		UseShadowCacheChangedEvent(const bool* val)
+			: UniformChangedEvent("useShadowCache", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::UseShadowCacheChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::LightingSettingsChanged, UniformChangedEvent);
+	private:
+
+	}; // class UseShadowCacheChangedEvent : public UniformChangedEvent<bool>
+
+	// Shadows for a pixel in four, shared with the rest - the compute raymarcher's only.
+	class HalfResShadowsChangedEvent : public UniformChangedEvent<bool>
+	{
+	public:
+		HalfResShadowsChangedEvent(const std::string& name, const bool* val)
+			: UniformChangedEvent(name, val) {};
+
+		HalfResShadowsChangedEvent(const bool* val)
+			: UniformChangedEvent("halfResShadows", val) {};
+
+		EVENT_CUSTOM_TYPE(EventTypes::HalfResShadowsChanged);
+		EVENT_CUSTOM_EXTEND_CATEGORY(EventCategory::LightingSettingsChanged, UniformChangedEvent);
+	private:
+
+	}; // class HalfResShadowsChangedEvent : public UniformChangedEvent<bool>
+
 	class MovementSpeedChangedEvent : public Event 
 	{
 	public:
@@ -704,5 +861,44 @@ namespace App
 		EVENT_CUSTOM_CATEGORY(EventCategory::Communication);
 	private:
 	}; // class TagSwapRequestedEvent : public Event
+
+	// Turns SceneLayer's march stats (and counters) on or off, as its checkbox does.
+	class MarchStatsRequestedEvent : public Event 
+	{
+	public:
+		MarchStatsRequestedEvent(bool enabled) : enabled(enabled) {};
+
+		const bool enabled;
+		// Filled in by SceneLayer, so whoever asked can put things back how they were.
+		bool wasEnabled = false;
+
+		EVENT_CUSTOM_TYPE(EventTypes::MarchStatsRequested);
+		EVENT_CUSTOM_CATEGORY(EventCategory::Communication);
+	}; // class MarchStatsRequestedEvent : public Event
+
+	// A frame's MarchCounts, back from the GPU a frame or few after it was drawn.
+	class MarchCountsReadyEvent : public Event 
+	{
+	public:
+		MarchCountsReadyEvent(const MarchCounts& counts) : counts(counts) {};
+
+		const MarchCounts& counts;
+
+		EVENT_CUSTOM_TYPE(EventTypes::MarchCountsReady);
+		EVENT_CUSTOM_CATEGORY(EventCategory::Communication);
+	}; // class MarchCountsReadyEvent : public Event
+
+	// Swaps SceneLayer between raymarching in fragment.glsl, over the quad, and raymarchCompute.glsl,
+	// in tiles. Same uniforms, same picture - it's there to compare what they cost.
+	class ComputeRaymarcherRequestedEvent : public Event 
+	{
+	public:
+		ComputeRaymarcherRequestedEvent(bool enabled) : enabled(enabled) {};
+
+		const bool enabled;
+
+		EVENT_CUSTOM_TYPE(EventTypes::ComputeRaymarcherRequested);
+		EVENT_CUSTOM_CATEGORY(EventCategory::Communication);
+	}; // class ComputeRaymarcherRequestedEvent : public Event
 }; // namespace App
 
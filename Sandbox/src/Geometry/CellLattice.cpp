@@ -0,0 +1,334 @@
+#include "CellLattice.h"
+
+#include "GeometryMaths.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+namespace App
+{
+	namespace {
+		const glm::dvec4 origin = glm::dvec4(0.0, 0.0, 0.0, 1.0);
+
+		// Grows with the distance between a and b, and is cheaper than it: cosh d for the
+		// hyperboloid, -cos d for the sphere and d^2 for flat space.
+		template<Geometry::V G, typename T>
+		T separation(const glm::vec<4, T>& a, const glm::vec<4, T>& b) {
+			if constexpr (G == Geometry::Hyperbolic) {
+				return -lorentzDot(a, b);
+			}
+			else if constexpr (G == Geometry::Spherical) {
+				return -sphericalDot(a, b);
+			}
+			else {
+				const glm::vec<3, T> d = glm::vec<3, T>(a) / a.w - glm::vec<3, T>(b) / b.w;
+				return dotg(d, d);
+			}
+		}
+
+		template<Geometry::V G>
+		float separationToDistance(float s) {
+			if constexpr (G == Geometry::Hyperbolic) {
+				return std::acosh(std::max(s, 1.0f));
+			}
+			else if constexpr (G == Geometry::Spherical) {
+				return std::acos(std::clamp(-s, -1.0f, 1.0f));
+			}
+			else {
+				return std::sqrt(s);
+			}
+		}
+
+		template<Geometry::V G>
+		float distanceToSeparation(float d) {
+			if constexpr (G == Geometry::Hyperbolic) {
+				return std::cosh(d);
+			}
+			else if constexpr (G == Geometry::Spherical) {
+				return d >= PI ? 1.0f : -std::cos(d);
+			}
+			else {
+				return d * d;
+			}
+		}
+
+		// gramSchmidt, in double. The generators come to us in float, so they're only isometries to
+		// within float rounding, which would add up over a long word.
+		template<Geometry::V G>
+		glm::dmat4 cleanGenerator(const glm::mat4& m) {
+			using Traits = GeometryTraits<G>;
+			glm::dmat4 n = glm::transpose(glm::dmat4(m));
+			if constexpr (G != Geometry::Euclidean) {
+				for (int i = 0; i < 4; i++) {
+					n[i] *= 1.0 / Traits::length(n[i]);
+					for (int j = i + 1; j < 4; j++) {
+						n[j] -= Traits::dot(n[i], n[j]) * n[i];
+					}
+				}
+			}
+			return glm::transpose(n);
+		}
+	}; // namespace
+
+	// N values, each rounded to the nearest multiple of quantum, as the key of a hash map.
+	//
+	// Two values a drift apart can still round differently if they're either side of a rounding
+	// boundary, so find() also tries the neighbouring multiple for the entries that are close to
+	// one. Only the first few such entries, though - 2^n lookups - which is plenty in practice: the
+	// drift is a few ulps and most entries of a generator product aren't anywhere near a boundary.
+	struct CellLattice::Index
+	{
+		using Key = std::array<int32_t, 16>;
+
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const {
+				// FNV-1a
+				uint64_t h = 14695981039346656037ull;
+				for (int32_t v : key) {
+					h = (h ^ (uint32_t)v) * 1099511628211ull;
+				}
+				return (size_t)h;
+			}
+		}; // struct KeyHash
+
+		static constexpr int sMaxAmbiguous = 4;
+		// How close to a rounding boundary (in quanta) counts as close.
+		static constexpr double sTolerance = 1.0 / 16.0;
+
+		Index(double quantum, int n) : inverseQuantum(1.0 / quantum), n(n) {};
+
+		Key key(const double* v) const {
+			Key k{};
+			for (int i = 0; i < n; i++) {
+				k[i] = (int32_t)std::lround(v[i] * inverseQuantum);
+			}
+			return k;
+		}
+
+		int32_t find(const double* v) const {
+			const Key k = key(v);
+			if (auto it = map.find(k); it != map.end()) {
+				return it->second;
+			}
+
+			int ambiguous[sMaxAmbiguous];
+			int32_t step[sMaxAmbiguous];
+			int count = 0;
+			for (int i = 0; i < n && count < sMaxAmbiguous; i++) {
+				const double offset = v[i] * inverseQuantum - (double)k[i];
+				if (std::fabs(offset) > 0.5 - sTolerance) {
+					ambiguous[count] = i;
+					step[count] = offset > 0 ? 1 : -1;
+					count++;
+				}
+			}
+			for (int mask = 1; mask < (1 << count); mask++) {
+				Key other = k;
+				for (int j = 0; j < count; j++) {
+					if (mask & (1 << j)) {
+						other[ambiguous[j]] += step[j];
+					}
+				}
+				if (auto it = map.find(other); it != map.end()) {
+					return it->second;
+				}
+			}
+			return -1;
+		}
+
+		void insert(const double* v, uint32_t value) { map.emplace(key(v), value); }
+
+		double inverseQuantum;
+		int n;
+		std::unordered_map<Key, uint32_t, KeyHash> map;
+	}; // struct CellLattice::Index
+
+	CellLattice::CellLattice(Geometry::V g, const std::array<glm::mat4, 6>& generators,
+			const Settings& settings)
+		: mGeometry(g), mSettings(settings), mGenerators(generators),
+		  mElementIndex(std::make_shared<Index>(settings.quantum, 16)),
+		  mCellIndex(std::make_shared<Index>(settings.quantum, 4)) {
+		const auto start = std::chrono::steady_clock::now();
+		dispatchGeometry(g, [&](auto traits) { build<decltype(traits)::geometry>(); });
+		const std::chrono::duration<float, std::milli> took = std::chrono::steady_clock::now() - start;
+
+		LOG_INFO("CellLattice: {0} elements in {1} cells (depth <= {2}, radius <= {3}) in {4} ms.",
+				mElements.size(), mCells.size(), mSettings.maxDepth, mSettings.maxRadius, took.count());
+		if (mElements.size() >= mSettings.maxElements) {
+			LOG_WARN("CellLattice: stopped at maxElements = {0}, the outermost layer is incomplete.",
+					mSettings.maxElements);
+		}
+	}
+
+	Aulys::Uni<CellLattice> CellLattice::create(uint32_t p, uint32_t q, uint32_t r,
+			const Settings& settings) {
+		const Geometry::V g = App::getGeometry(p, q, r);
+		return std::make_unique<CellLattice>(g, initGenerators(p, q, r).invGens, settings);
+	}
+
+	template<Geometry::V G>
+	void CellLattice::build() {
+		using Traits = GeometryTraits<G>;
+
+		// The products are made in double. In float, the entries of an isometry that goes a few units
+		// out are in the hundreds (cosh d) and the rounding error on them soon passes the quantum.
+		std::vector<int> active;
+		std::array<glm::dmat4, 6> generators;
+		for (int k = 0; k < 6; k++) {
+			if (mGenerators[k] != glm::mat4(0.0f)) {
+				active.push_back(k);
+				generators[k] = cleanGenerator<G>(mGenerators[k]);
+			}
+		}
+
+		// inverseOf[k] is the generator that undoes generator k, so that the step straight back to
+		// an element's parent needn't be multiplied out and looked up.
+		std::array<int, 6> inverseOf;
+		inverseOf.fill(-1);
+		for (int k : active) {
+			for (int j : active) {
+				const glm::dmat4 product = generators[k] * generators[j];
+				double error = 0.0;
+				for (int c = 0; c < 4; c++) {
+					for (int r = 0; r < 4; r++) {
+						error = std::max(error, std::fabs(product[c][r] - (c == r ? 1.0 : 0.0)));
+					}
+				}
+				if (error < mSettings.quantum) {
+					inverseOf[k] = j;
+				}
+			}
+		}
+
+		const double maxSeparation = distanceToSeparation<G>(mSettings.maxRadius);
+		std::vector<glm::dmat4> exact;
+
+		auto addElement = [&](const glm::dmat4& m, uint32_t depth, int32_t parent, int32_t generator) {
+			const uint32_t index = (uint32_t)mElements.size();
+
+			Element e;
+			e.boost = glm::mat4(m);
+			e.inverse = Traits::inverse(e.boost);
+			e.neighbours.fill(-1);
+			e.depth = depth;
+			e.parent = parent;
+			e.generator = generator;
+
+			const glm::dvec4 centre = m * origin;
+			if (int32_t cell = mCellIndex->find(&centre[0]); cell >= 0) {
+				e.cell = (uint32_t)cell;
+			}
+			else {
+				e.cell = (uint32_t)mCells.size();
+				const float distance = separationToDistance<G>((float)separation<G>(origin, centre));
+				mCells.push_back({ glm::vec4(centre), distance, index });
+				mCellIndex->insert(&centre[0], e.cell);
+			}
+
+			mElements.push_back(e);
+			exact.push_back(m);
+			mElementIndex->insert(&m[0][0], index);
+			return (int32_t)index;
+		};
+
+		addElement(glm::dmat4(1.0), 0, -1, -1);
+
+		// mElements is its own queue: everything before i has been expanded.
+		for (size_t i = 0; i < mElements.size(); i++) {
+			for (int k : active) {
+				if (mElements[i].generator >= 0 && inverseOf[k] == mElements[i].generator) {
+					mElements[i].neighbours[k] = mElements[i].parent;
+					continue;
+				}
+
+				const glm::dmat4 m = exact[i] * generators[k];
+				int32_t j = mElementIndex->find(&m[0][0]);
+				if (j < 0 && mElements[i].depth < mSettings.maxDepth && mElements.size() < mSettings.maxElements
+						&& separation<G>(origin, m * origin) <= maxSeparation) {
+					j = addElement(m, mElements[i].depth + 1, (int32_t)i, k);
+				}
+				mElements[i].neighbours[k] = j;
+			}
+		}
+
+		// Two cells are neighbours if any of their elements are.
+		std::vector<std::vector<uint32_t>> cellNeighbours(mCells.size());
+		for (const Element& e : mElements) {
+			for (int32_t n : e.neighbours) {
+				if (n >= 0 && mElements[n].cell != e.cell) {
+					cellNeighbours[e.cell].push_back(mElements[n].cell);
+				}
+			}
+		}
+		for (size_t c = 0; c < mCells.size(); c++) {
+			auto& list = cellNeighbours[c];
+			std::sort(list.begin(), list.end());
+			list.erase(std::unique(list.begin(), list.end()), list.end());
+
+			mCells[c].firstNeighbour = (uint32_t)mCellNeighbours.size();
+			mCells[c].neighbourCount = (uint32_t)list.size();
+			mCellNeighbours.insert(mCellNeighbours.end(), list.begin(), list.end());
+		}
+	}
+
+	int32_t CellLattice::find(const glm::mat4& m) const {
+		const glm::dmat4 d = glm::dmat4(m);
+		return mElementIndex->find(&d[0][0]);
+	}
+
+	template<Geometry::V G>
+	uint32_t CellLattice::locate(const glm::vec4& point, uint32_t startCell) const {
+		// The cells are the Dirichlet domains of their centres, so if the point isn't in the current
+		// one, one of the facets separates them and the cell across it is closer. Each step gets
+		// strictly closer, so this stops.
+		uint32_t current = startCell;
+		float best = separation<G>(point, mCells[current].centre);
+		for (;;) {
+			const Cell& cell = mCells[current];
+			uint32_t next = current;
+			for (uint32_t i = cell.firstNeighbour; i < cell.firstNeighbour + cell.neighbourCount; i++) {
+				const uint32_t n = mCellNeighbours[i];
+				if (float s = separation<G>(point, mCells[n].centre); s < best) {
+					best = s;
+					next = n;
+				}
+			}
+			if (next == current) {
+				return current;
+			}
+			current = next;
+		}
+	}
+
+	uint32_t CellLattice::locate(const glm::vec4& point, uint32_t startCell) const {
+		AU_ASSERT(startCell < mCells.size(), "locate: startCell = {0}, but there are only {1} cells.",
+				startCell, mCells.size());
+		return dispatchGeometry(mGeometry, [&](auto traits) {
+			return locate<decltype(traits)::geometry>(point, startCell);
+		});
+	}
+
+	std::vector<uint32_t> CellLattice::cellsWithin(const glm::vec4& point, float radius) const {
+		return dispatchGeometry(mGeometry, [&](auto traits) {
+			constexpr Geometry::V G = decltype(traits)::geometry;
+			const float threshold = distanceToSeparation<G>(radius);
+			std::vector<uint32_t> cells;
+			for (uint32_t c = 0; c < mCells.size(); c++) {
+				if (separation<G>(point, mCells[c].centre) <= threshold) {
+					cells.push_back(c);
+				}
+			}
+			return cells;
+		});
+	}
+
+	float CellLattice::distance(const glm::vec4& a, const glm::vec4& b) const {
+		return dispatchGeometry(mGeometry, [&](auto traits) {
+			constexpr Geometry::V G = decltype(traits)::geometry;
+			return separationToDistance<G>(separation<G>(a, b));
+		});
+	}
+}; // namespace App
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Aulys.h"
+
+#include "Maths.h"
+#include "Geometry.h"
+
+#include <limits>
+#include <vector>
+
+/* The group generated by a honeycomb's generators (invGens in Scene.h), enumerated once up front so
+ * that the CPU knows about more than the central cell.
+ *
+ * Elements are found by a breadth-first search over words in the generators, so each one is stored
+ * with its shortest (reduced) word - depth is that word's length. Different words for the same
+ * isometry are caught by hashing the matrix with its entries rounded to Settings::quantum. The
+ * products are made in double, so the rounding error stays well under the quantum even where the
+ * entries get large.
+ *
+ * Every element keeps its boost, its inverse (from the metric, not glm::inverse) and, for each
+ * generator k, the index of boost * generators[k] - the cell across that generator's facet - or -1
+ * if that's outside what was enumerated.
+ *
+ * For the simplex honeycombs the generators are reflections, and the ones in mirrors through the
+ * origin fix it, so several elements take the central cell to the same place. Elements therefore
+ * also point at a Cell, one per distinct centre (image of the origin), and the cells keep a list of
+ * the cells that share a facet with them. For the cubical honeycombs elements and cells are one to
+ * one. */
+
+namespace App
+{
+	class CellLattice
+	{
+	public:
+		struct Settings
+		{
+			uint32_t maxDepth = 4;      // Longest word.
+			float maxRadius = std::numeric_limits<float>::infinity(); // Furthest cell centre.
+			uint32_t maxElements = 1 << 14;
+			float quantum = 1e-2f;      // Matrix entries closer than this are the same.
+		}; // struct Settings
+
+		struct Element
+		{
+			glm::mat4 boost{ 1.0f };
+			glm::mat4 inverse{ 1.0f };
+			std::array<int32_t, 6> neighbours; // boost * generators[k], or -1.
+			uint32_t cell = 0;
+			uint32_t depth = 0;
+			int32_t parent = -1;    // The element one generator shorter...
+			int32_t generator = -1; // ...and which generator: boost = parent.boost * generators[generator].
+		}; // struct Element
+
+		struct Cell
+		{
+			glm::vec4 centre;     // boost * origin.
+			float distance;       // From the origin.
+			uint32_t element;     // The shortest element that takes the central cell here.
+			uint32_t firstNeighbour = 0; // Into getCellNeighbours().
+			uint32_t neighbourCount = 0;
+		}; // struct Cell
+
+		// generators must be closed under inverses, which both the cubical and simplex sets are.
+		// Zero matrices (the padding of the simplex sets) are skipped.
+		CellLattice(Geometry::V g, const std::array<glm::mat4, 6>& generators, const Settings& settings);
+		CellLattice(Geometry::V g, const std::array<glm::mat4, 6>& generators)
+			: CellLattice(g, generators, Settings{}) {};
+
+		static Aulys::Uni<CellLattice> create(uint32_t p, uint32_t q, uint32_t r, const Settings& settings);
+		static Aulys::Uni<CellLattice> create(uint32_t p, uint32_t q, uint32_t r) { return create(p, q, r, Settings{}); };
+
+		inline Geometry::V getGeometry() const { return mGeometry; };
+		inline const Settings& getSettings() const { return mSettings; };
+
+		inline size_t size() const { return mElements.size(); };
+		inline const Element& operator[](size_t i) const { return mElements[i]; };
+		inline const std::vector<Element>& getElements() const { return mElements; };
+
+		inline size_t getCellCount() const { return mCells.size(); };
+		inline const Cell& getCell(size_t i) const { return mCells[i]; };
+		inline const std::vector<Cell>& getCells() const { return mCells; };
+		// The neighbours of every cell, one after the other - cell i's are
+		// [getCell(i).firstNeighbour, getCell(i).firstNeighbour + getCell(i).neighbourCount).
+		inline const std::vector<uint32_t>& getCellNeighbours() const { return mCellNeighbours; };
+
+		// Element 0 is always the identity.
+		inline int32_t neighbour(size_t element, int generator) const { return mElements[element].neighbours[generator]; };
+		inline const std::array<glm::mat4, 6>& getGenerators() const { return mGenerators; };
+
+		// The element whose boost is m (to within the quantum), or -1.
+		int32_t find(const glm::mat4& m) const;
+
+		// The cell whose centre is closest to point - the one the point is in, as long as it's in
+		// an enumerated cell. Walks the neighbours from start (which should be near the point, e.g.
+		// the last answer) towards it, so it's a handful of lookups rather than a search.
+		uint32_t locate(const glm::vec4& point, uint32_t startCell) const;
+		uint32_t locate(const glm::vec4& point) const { return locate(point, 0); };
+
+		// All cells with a centre within radius of point, by a scan over the centres.
+		std::vector<uint32_t> cellsWithin(const glm::vec4& point, float radius) const;
+
+		// The distance between two points of this geometry.
+		float distance(const glm::vec4& a, const glm::vec4& b) const;
+
+	private:
+		template<Geometry::V G> void build();
+		template<Geometry::V G> uint32_t locate(const glm::vec4& point, uint32_t startCell) const;
+
+		Geometry::V mGeometry;
+		Settings mSettings;
+		std::array<glm::mat4, 6> mGenerators;
+		std::vector<Element> mElements;
+		std::vector<Cell> mCells;
+		std::vector<uint32_t> mCellNeighbours;
+
+		// Quantised boost -> element, and quantised centre -> cell.
+		struct Index;
+		Aulys::Ref<Index> mElementIndex;
+		Aulys::Ref<Index> mCellIndex;
+	}; // class CellLattice
+}; // namespace App
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <limits>
+#include <type_traits>
+
+/* constexpr versions of the <cmath> functions the geometry code needs, so that the compiler can
+ * work out a honeycomb's constants (see HoneycombTable.h). The <cmath> ones can't be constexpr,
+ * because of errno and friends.
+ *
+ * Everything is done in double and rounded once at the end, so the float versions are correctly
+ * rounded nearly always and never more than an ulp out, and the double ones are good to a few ulps
+ * (more near the poles of atanh and friends, where the argument itself has lost them).
+ * They're plain series rather than libm's tuned polynomials, so at run time they're several times
+ * slower - use std:: there, unless a value has to agree exactly with one worked out at compile
+ * time. */
+
+namespace App
+{
+	namespace ConstMaths
+	{
+		namespace Detail
+		{
+			constexpr double Pi = 3.14159265358979323846;
+			constexpr double HalfPi = 1.57079632679489661923;
+			// HalfPi in two parts, the first with its low bits zeroed, so that q * HalfPiHi is exact
+			// for the q a reduction needs (Cody & Waite).
+			constexpr double HalfPiHi = 1.57079632673412561417;
+			constexpr double HalfPiLo = 6.07710050650619224932e-11;
+			constexpr double Ln2 = 0.69314718055994530942;
+			constexpr double Ln2Hi = 6.93147180369123816490e-01; // The same, for exp.
+			constexpr double Ln2Lo = 1.90821492927058770002e-10;
+			constexpr double Sqrt2 = 1.41421356237309504880;
+
+			constexpr double Inf = std::numeric_limits<double>::infinity();
+			constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+			constexpr bool isNaN(double x) { return x != x; }
+			constexpr double abs(double x) { return x < 0 ? -x : x; }
+			constexpr long long nearest(double x) { return (long long)(x < 0 ? x - 0.5 : x + 0.5); }
+
+			// 2^k, exactly (as long as it's representable).
+			constexpr double pow2(int k) {
+				double r = 1.0;
+				const double b = k < 0 ? 0.5 : 2.0;
+				for (int n = k < 0 ? -k : k; n > 0; n--) {
+					r *= b;
+				}
+				return r;
+			}
+
+			constexpr double sqrt(double x) {
+				if (isNaN(x) || x < 0) {
+					return NaN;
+				}
+				if (x == 0 || x == Inf) {
+					return x;
+				}
+				// Into [1/4, 1) by powers of 4, where Newton's first guess is never more than a
+				// quarter out, and then 6 steps is more than double precision.
+				int k = 0;
+				for (; x >= 1.0; k++) { x *= 0.25; }
+				for (; x < 0.25; k--) { x *= 4.0; }
+				double r = 0.5 * (x + 1.0);
+				for (int i = 0; i < 6; i++) {
+					r = 0.5 * (r + x / r);
+				}
+				return r * pow2(k);
+			}
+
+			constexpr double exp(double x) {
+				if (isNaN(x)) {
+					return x;
+				}
+				if (x > 709.8) {
+					return Inf;
+				}
+				if (x < -745.2) {
+					return 0.0;
+				}
+				// x = k ln 2 + r with |r| <= ln 2 / 2, where the series needs ~18 terms.
+				const long long k = nearest(x / Ln2);
+				const double r = (x - (double)k * Ln2Hi) - (double)k * Ln2Lo;
+				double term = 1.0, sum = 1.0;
+				for (int n = 1; n < 24; n++) {
+					term *= r / n;
+					sum += term;
+				}
+				return sum * pow2((int)k);
+			}
+
+			// log(1 + y), without losing y when it's small.
+			constexpr double log1p(double y);
+
+			constexpr double log(double x) {
+				if (isNaN(x) || x < 0) {
+					return NaN;
+				}
+				if (x == 0) {
+					return -Inf;
+				}
+				if (x == Inf) {
+					return x;
+				}
+				// x = m 2^k with m in [sqrt(1/2), sqrt(2)).
+				int k = 0;
+				for (; x >= Sqrt2; k++) { x *= 0.5; }
+				for (; x < 0.5 * Sqrt2; k--) { x *= 2.0; }
+				return log1p(x - 1.0) + k * Ln2;
+			}
+
+			constexpr double log1p(double y) {
+				if (isNaN(y) || abs(y) > 0.5) {
+					return log(1.0 + y);
+				}
+				// log(1 + y) = 2 atanh(s) with s = y / (2 + y), and |s| <= 1/3 here.
+				const double s = y / (2.0 + y), s2 = s * s;
+				double term = s, sum = s;
+				for (int n = 3; n < 64; n += 2) {
+					term *= s2;
+					sum += term / n;
+				}
+				return 2.0 * sum;
+			}
+
+			// The series, for |x| <= pi / 4.
+			constexpr double sinSeries(double x) {
+				const double x2 = x * x;
+				double term = x, sum = x;
+				for (int n = 1; n < 12; n++) {
+					term *= -x2 / ((2 * n) * (2 * n + 1));
+					sum += term;
+				}
+				return sum;
+			}
+
+			constexpr double cosSeries(double x) {
+				const double x2 = x * x;
+				double term = 1.0, sum = 1.0;
+				for (int n = 1; n < 12; n++) {
+					term *= -x2 / ((2 * n - 1) * (2 * n));
+					sum += term;
+				}
+				return sum;
+			}
+
+			// sin(x + quarter * pi / 2). The reduction is good for anything a geometry needs (a few
+			// turns); a long way out it loses bits like any other two-part one.
+			constexpr double sinQuarters(double x, long long quarter) {
+				if (isNaN(x) || abs(x) == Inf) {
+					return NaN;
+				}
+				const long long q = nearest(x / HalfPi);
+				const double r = (x - (double)q * HalfPiHi) - (double)q * HalfPiLo;
+				switch ((((q + quarter) % 4) + 4) % 4) {
+					case 0: return sinSeries(r);
+					case 1: return cosSeries(r);
+					case 2: return -sinSeries(r);
+					default: return -cosSeries(r);
+				}
+			}
+
+			constexpr double sin(double x) { return sinQuarters(x, 0); }
+			constexpr double cos(double x) { return sinQuarters(x, 1); }
+			constexpr double tan(double x) { return sin(x) / cos(x); }
+
+			constexpr double sinh(double x) {
+				if (abs(x) < 0.125) {
+					// exp(x) - exp(-x) would cancel most of x away.
+					const double x2 = x * x;
+					return x * (1.0 + x2 / 6.0 * (1.0 + x2 / 20.0 * (1.0 + x2 / 42.0 * (1.0 + x2 / 72.0))));
+				}
+				const double e = exp(x);
+				return 0.5 * (e - 1.0 / e);
+			}
+
+			constexpr double cosh(double x) {
+				const double e = exp(abs(x));
+				return 0.5 * (e + 1.0 / e);
+			}
+
+			constexpr double tanh(double x) {
+				if (abs(x) > 20.0) {
+					return x < 0 ? -1.0 : 1.0;
+				}
+				return sinh(x) / cosh(x);
+			}
+
+			constexpr double asinh(double x) {
+				const double a = abs(x);
+				const double r = a > 1e8 ? log(a) + Ln2 : log1p(a + a * a / (1.0 + sqrt(1.0 + a * a)));
+				return x < 0 ? -r : r;
+			}
+
+			constexpr double acosh(double x) {
+				if (isNaN(x) || x < 1.0) {
+					return NaN;
+				}
+				if (x > 1e8) {
+					return log(x) + Ln2;
+				}
+				const double t = x - 1.0;
+				return log1p(t + sqrt(t * (t + 2.0)));
+			}
+
+			constexpr double atanh(double x) {
+				if (isNaN(x) || abs(x) > 1.0) {
+					return NaN;
+				}
+				if (abs(x) == 1.0) {
+					return x * Inf;
+				}
+				return 0.5 * log1p(2.0 * x / (1.0 - x));
+			}
+
+			constexpr double atan(double x) {
+				if (isNaN(x)) {
+					return x;
+				}
+				const double a = abs(x);
+				if (a > 1.0) {
+					const double r = HalfPi - atan(1.0 / a);
+					return x < 0 ? -r : r;
+				}
+				// atan(x) = 2 atan(x / (1 + sqrt(1 + x^2))), twice, takes |x| under tan(pi / 16).
+				double t = a / (1.0 + sqrt(1.0 + a * a));
+				t = t / (1.0 + sqrt(1.0 + t * t));
+				const double t2 = t * t;
+				double term = t, sum = t;
+				for (int n = 3; n < 40; n += 2) {
+					term *= -t2;
+					sum += term / n;
+				}
+				return x < 0 ? -4.0 * sum : 4.0 * sum;
+			}
+
+			constexpr double asin(double x) {
+				if (isNaN(x) || abs(x) > 1.0) {
+					return NaN;
+				}
+				if (abs(x) == 1.0) {
+					return x * HalfPi;
+				}
+				return atan(x / sqrt((1.0 - x) * (1.0 + x)));
+			}
+
+			constexpr double acos(double x) {
+				if (isNaN(x) || abs(x) > 1.0) {
+					return NaN;
+				}
+				if (x == -1.0) {
+					return Pi;
+				}
+				// Not pi / 2 - asin(x), which loses everything as x goes to 1.
+				return 2.0 * atan(sqrt((1.0 - x) / (1.0 + x)));
+			}
+		}; // namespace Detail
+
+		// One per function, for float and double alike: T(f(double(x))).
+#define AU_CONSTMATHS_FUNCTION(name) \
+		template<typename T> \
+		constexpr T name(T x) { \
+			static_assert(std::is_floating_point_v<T>, "ConstMaths::" #name " takes a float or a double."); \
+			return static_cast<T>(Detail::name(static_cast<double>(x))); \
+		}
+
+		AU_CONSTMATHS_FUNCTION(sqrt)
+		AU_CONSTMATHS_FUNCTION(exp)
+		AU_CONSTMATHS_FUNCTION(log)
+		AU_CONSTMATHS_FUNCTION(sin)
+		AU_CONSTMATHS_FUNCTION(cos)
+		AU_CONSTMATHS_FUNCTION(tan)
+		AU_CONSTMATHS_FUNCTION(asin)
+		AU_CONSTMATHS_FUNCTION(acos)
+		AU_CONSTMATHS_FUNCTION(atan)
+		AU_CONSTMATHS_FUNCTION(sinh)
+		AU_CONSTMATHS_FUNCTION(cosh)
+		AU_CONSTMATHS_FUNCTION(tanh)
+		AU_CONSTMATHS_FUNCTION(asinh)
+		AU_CONSTMATHS_FUNCTION(acosh)
+		AU_CONSTMATHS_FUNCTION(atanh)
+
+#undef AU_CONSTMATHS_FUNCTION
+	}; // namespace ConstMaths
+}; // namespace App
@@ -7,6 +7,27 @@
 
 namespace App 
 {
-	Geometry::V getGeometry(int p, int q, int r);
-	Geometry::V getGeometry2D(uint32_t p, uint32_t q);
+	// constexpr (by way of ConstMaths) so that HoneycombTable.h can be worked out at compile time.
+	constexpr Geometry::V getGeometry(int p, int q, int r) {
+		auto testOne = ConstMaths::sin(piOver(p)) * ConstMaths::sin(piOver(r));
+		auto testTwo = ConstMaths::cos(piOver(q));
+
+		if ( p == 4 && q == 3 && r == 4 )
+			return Geometry::Euclidean;
+		if ( testOne > testTwo ) {
+			return Geometry::Spherical;
+		}
+		return Geometry::Hyperbolic;
+	}
+
+	constexpr Geometry::V getGeometry2D(uint32_t p, uint32_t q) {
+		auto test = 1.0f / p + 1.0f / q;
+		if ( test == 0.5f ) {
+			return Geometry::Euclidean;
+		}
+		else if ( test > 0.5f ) {
+			return Geometry::Spherical;
+		}
+		return Geometry::Hyperbolic;
+	}
 }; // namespace App
@@ -30,46 +30,21 @@ namespace App
 	}
 
 	glm::vec4 constructSpherePoint(glm::vec3 dir, float distance) {
-		auto w = cos(distance);
-		return glm::vec4(direction(dir) * (float)sqrt(1 - w * w), w);
+		return GeometryTraits<Geometry::Spherical>::exp(dir, distance);
 	}
 
 	glm::vec4 constructHyperboloidPoint(Geometry::V g, glm::vec3 dir, float distance) {
-		float w = cosh(distance);
-		float magnitudeSquared = w * w - 1;
-		glm::vec3 d = direction(dir) * (float)sqrt(magnitudeSquared);
-		return glm::vec4(d.x, d.y, d.z, w);
+		return GeometryTraits<Geometry::Hyperbolic>::exp(dir, distance);
 	}
 
 	glm::vec4 constructPointInGeometry(Geometry::V g, glm::vec3 dir, float distance) {
-		switch (g) {
-			case Geometry::Euclidean:
-				return glm::vec4(direction(dir) * distance, 1);
-			case Geometry::Hyperbolic:
-				return constructHyperboloidPoint(g, dir, distance);
-			case Geometry::Spherical:
-				return constructSpherePoint(dir, distance);
-			default:
-				AU_ASSERT(false, "The parameter Geometry::V g = \"{0}\" is not supported. "
-					"(Not one of Geometry::Euclidean, Geometry::Hyperbolic, or "
-					"Geometry::Spherical", g);
-				return glm::vec4(0.0f);
-		}
+		return dispatchGeometry(g, [&](auto traits) { return decltype(traits)::exp(dir, distance); });
 	}
 
 	float getTriangleSide(Geometry::V g, float alpha, float beta, float gamma) {
-		switch(g) {
-			case Geometry::Euclidean:
-				return 0.0f; // No such thing!
-			case Geometry::Hyperbolic:
-				return acosh((cos(alpha) + cos(beta) * cos(gamma)) / (sin(beta) * sin(gamma)));	
-			case Geometry::Spherical:
-				return acos((cos(alpha) + cos(beta) * cos(gamma)) / (sin(beta) * sin(gamma)));
-			default:
-				AU_ASSERT(false, "Geometry::V g=\"{0}\" isn't supported, check you called with the "
-						"correct value.", g);
-				return 0.0f;
-		}
+		return dispatchGeometry(g, [&](auto traits) {
+			return decltype(traits)::triangleSide(alpha, beta, gamma);
+		});
 	}
 
 	float getTrianglePSide(uint32_t p, uint32_t q) {
@@ -95,82 +70,64 @@ namespace App
 	}
 
 	glm::vec4 planeDualPoint(Geometry::V g, const glm::vec4& fKlein) {
-		if(abs(fKlein.w) < pow(10.0f, -7)) {
-			return {fKlein.x, fKlein.y, fKlein.z, 0.0f};
-		}
-		float inverseW = 1.0f / fKlein.w;
-		return normalize(g,
-				glm::vec4(fKlein.x * inverseW, fKlein.y * inverseW, fKlein.z * inverseW, 1.0f));
-   	}
+		return dispatchGeometry(g, [&](auto traits) {
+			return planeDualPoint<decltype(traits)::geometry>(fKlein);
+		});
+	}
 
 	glm::vec4 reflectInFacet(Geometry::V g, const glm::vec4& fKlein, const glm::vec4& vMinkowski) {
-		glm::vec4 plane = planeDualPoint(g, fKlein);
-		return vMinkowski - (plane * (2 * dotg(g, plane, vMinkowski) / dotg(g, plane, plane)));
+		return dispatchGeometry(g, [&](auto traits) {
+			return reflectInFacet<decltype(traits)::geometry>(fKlein, vMinkowski);
+		});
 	}
 
 	float poincareToHyperbolic(float p) {
 		return 2*atanh(p);
 	}
 
-	float hyperbolicToPoincare(float h) {
-		return tanh(0.5f * h);
-	}
-
-	float poincareToKlein(float p) {
-		return 2 * p / ( 1 + p * p );
-	}
-
-	float sphericalToStereographic(float s) {
-		return 2 * atan(0.5f * s);
-	}
-
-	float stereographicToGnomonic(float s) {
-		return 2 * s / (1 - s * s);
-	}
-
 	float geodesicPlaneHSDF(Geometry::V g, glm::vec3 vSample, glm::vec3 vDualPoint, float offset) {
 		return asinh(-dotg(g, vSample, vDualPoint));
 	}
 
-	int fixOutsideCentralCell(glm::mat4 m, const std::array<glm::mat4, 6>& invGens) {
-		auto v = m * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	int fixOutsideCentralCell(Geometry::V g, glm::mat4 m, const std::array<glm::mat4, 6>& invGens) {
+		return dispatchGeometry(g, [&](auto traits) {
+			return fixOutsideCentralCell<decltype(traits)::geometry>(m, invGens);
+		});
+	}
+
+	int fixOutsideCentralCell(const glm::mat4& m, const std::array<glm::vec4, 6>& centres) {
+		auto v = m[3];
 		float dist = dotg(v, v);
 		int bestIndex = -1;
 		for (int i = 0; i < 6; i++) {
-			v = m * inverse(invGens[i]) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			if (centres[i] == glm::vec4(0.0f)) {
+				continue;
+			}
+			v = m * centres[i];
 			if (float newDist = dotg(v, v); newDist < dist) {
 				dist = newDist;
 				bestIndex = i;
 			}
 		}
-		if (bestIndex != -1) {
-			m = m * inverse(invGens[bestIndex]); // Why do this?
-		}
 		return bestIndex;
 	}
 
-	glm::mat4 gramSchmidt(Geometry::V g, glm::mat4 m) {
-		if (g == Geometry::Euclidean) {
-			AU_ASSERT(false, "Called gramSchmidt on Euclidean geometry.");
-			return glm::mat4{0.0f};
-		}
+	std::array<glm::vec4, 6> neighbourCellCentres(Geometry::V g, const std::array<glm::mat4, 6>& invGens) {
+		return dispatchGeometry(g, [&](auto traits) {
+			return neighbourCellCentres<decltype(traits)::geometry>(invGens);
+		});
+	}
 
-		glm::mat4 n = glm::transpose(m);
-		auto temp = glm::vec4{ 0.0f };
-		auto temp2 = glm::vec4{ 0.0f };
-		for (int i = 0; i < 4; i++) {
-			float invRowNorm = 1.0f / length(g, n[i]);
-			for (int l = 0; l < 4; l++) {
-				n[i][l] = n[i][l] * invRowNorm;
-			}
-			for (int j = i + 1; j < 4; j++) {
-				float component = dotg(g, n[i], n[j]);
-				for (int k = 0; k < 4; k++) {
-					n[j][k] -= component * n[i][k];
-				}
-			}
+	glm::mat4 gramSchmidt(Geometry::V g, glm::mat4 m) {
+		switch (g) {
+			case Geometry::Hyperbolic:
+				return gramSchmidt<Geometry::Hyperbolic>(m);
+			case Geometry::Spherical:
+				return gramSchmidt<Geometry::Spherical>(m);
+			default:
+				AU_ASSERT(false, "Called gramSchmidt on Euclidean (or an unknown) geometry \"{0}\".", g);
+				return glm::mat4{0.0f};
 		}
-		return glm::transpose(n);
 	}
 
 }; // namespace App
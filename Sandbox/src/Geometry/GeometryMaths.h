@@ -36,13 +36,85 @@ namespace App
 	glm::vec4 reflectInFacet(Geometry::V g, const glm::vec4& fKlein, const glm::vec4& vMinkowski);
 
 	float poincareToHyperbolic(float p);
-	float hyperbolicToPoincare(float h);
-	float poincareToKlein(float p);
-	float sphericalToStereographic(float s);
-	float stereographicToGnomonic(float s);
+	// These four are constexpr for HoneycombTable.h.
+	constexpr float hyperbolicToPoincare(float h) {
+		return ConstMaths::tanh(0.5f * h);
+	}
+
+	constexpr float poincareToKlein(float p) {
+		return 2 * p / ( 1 + p * p );
+	}
+
+	constexpr float sphericalToStereographic(float s) {
+		return 2 * ConstMaths::atan(0.5f * s);
+	}
+
+	constexpr float stereographicToGnomonic(float s) {
+		return 2 * s / (1 - s * s);
+	}
 
 	float geodesicPlaneHSDF(Geometry::V g, glm::vec3 vSample, glm::vec3 vDualPoint, float offset);
 
-	int fixOutsideCentralCell(glm::mat4 m, const std::array<glm::mat4, 6>& gens);
+	int fixOutsideCentralCell(Geometry::V g, glm::mat4 m, const std::array<glm::mat4, 6>& gens);
+	// Which of the neighbouring cells (centres from neighbourCellCentres) m takes closest to the
+	// origin, or -1 if none beats m itself. Six matrix-vector products, whatever the geometry.
+	int fixOutsideCentralCell(const glm::mat4& m, const std::array<glm::vec4, 6>& centres);
+	std::array<glm::vec4, 6> neighbourCellCentres(Geometry::V g, const std::array<glm::mat4, 6>& invGens);
 	glm::mat4 gramSchmidt(Geometry::V g, glm::mat4 m);
+
+/**************************************************************************************************/
+/*** The same, for a geometry known at compile time - see GeometryTraits in Maths.h. ***/
+/**************************************************************************************************/
+
+	template<Geometry::V G>
+	glm::vec4 planeDualPoint(const glm::vec4& fKlein) {
+		if (std::fabs(fKlein.w) < 1e-7f) {
+			return {fKlein.x, fKlein.y, fKlein.z, 0.0f};
+		}
+		const float inverseW = 1.0f / fKlein.w;
+		return GeometryTraits<G>::normalize(
+				glm::vec4(fKlein.x * inverseW, fKlein.y * inverseW, fKlein.z * inverseW, 1.0f));
+	}
+
+	template<Geometry::V G>
+	glm::vec4 reflectInFacet(const glm::vec4& fKlein, const glm::vec4& vMinkowski) {
+		return GeometryTraits<G>::reflect(planeDualPoint<G>(fKlein), vMinkowski);
+	}
+
+	// inverse(invGens[i]) * origin, the centres of the cells across the central cell's facets - all
+	// fixOutsideCentralCell needs of the generators, so work them out when the generators change
+	// rather than on every step. The generators are isometries, so inverting one is a transpose and
+	// a few sign flips rather than a general 4x4 inverse.
+	template<Geometry::V G>
+	std::array<glm::vec4, 6> neighbourCellCentres(const std::array<glm::mat4, 6>& invGens) {
+		std::array<glm::vec4, 6> centres;
+		for (int i = 0; i < 6; i++) {
+			// The padding generators of the simplex honeycombs (see Scene.h) are zero, and have no
+			// inverse. Their centre is left zero, which fixOutsideCentralCell skips.
+			centres[i] = invGens[i] == glm::mat4(0.0f) ? glm::vec4(0.0f) : GeometryTraits<G>::inverse(invGens[i])[3];
+		}
+		return centres;
+	}
+
+	template<Geometry::V G>
+	int fixOutsideCentralCell(const glm::mat4& m, const std::array<glm::mat4, 6>& invGens) {
+		return fixOutsideCentralCell(m, neighbourCellCentres<G>(invGens));
+	}
+
+	// Re-orthonormalises the columns of m with respect to G's metric, pulling a product of
+	// isometries that drifted through float error back onto the isometry group.
+	template<Geometry::V G>
+	glm::mat4 gramSchmidt(glm::mat4 m) {
+		static_assert(G != Geometry::Euclidean, "gramSchmidt makes no sense in Euclidean geometry.");
+		using Traits = GeometryTraits<G>;
+
+		glm::mat4 n = glm::transpose(m);
+		for (int i = 0; i < 4; i++) {
+			n[i] *= 1.0f / Traits::length(n[i]);
+			for (int j = i + 1; j < 4; j++) {
+				n[j] -= Traits::dot(n[i], n[j]) * n[i];
+			}
+		}
+		return glm::transpose(n);
+	}
 }; // namespace App
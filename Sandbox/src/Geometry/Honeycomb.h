@@ -4,25 +4,32 @@
 
 #include "GeometryMaths.h"
 
-namespace App 
+namespace App
 {
-	float piHPQCalc(uint32_t p, uint32_t q) {
-		return acos(sqrt(pow(cos(PI/p), 2) + pow(cos(PI/q), 2)));
+	// All constexpr (with ConstMaths standing in for <cmath>), see HoneycombTable.h.
+	constexpr float piHPQCalc(uint32_t p, uint32_t q) {
+		const float cosP = ConstMaths::cos(PI/p);
+		const float cosQ = ConstMaths::cos(PI/q);
+		return ConstMaths::acos(ConstMaths::sqrt(cosP * cosP + cosQ * cosQ));
 	}
 
 	/* Returns:
 	 *   - 0.0f is an error value, you'll never get it otherwise.
 	 * */
-	float inRadiusCalc(uint32_t p, uint32_t q, uint32_t r, Geometry::V g) {
-		float inRadius = sin(piOver(p)) * cos(piOver(r)) / sin(piHPQCalc(p, q));
+	constexpr float inRadiusCalc(uint32_t p, uint32_t q, uint32_t r, Geometry::V g) {
+		// When the cells are Euclidean tilings ({4,4}, {3,6}, {6,3}) they're horospheres, infinitely
+		// far from their centres, and sin(piHPQCalc) is zero give or take rounding. Spelt out, as
+		// dividing by zero isn't a constant (and dividing by nearly zero is nonsense).
+		float inRadius = getGeometry2D(p, q) == Geometry::Euclidean ? std::numeric_limits<float>::infinity()
+			: ConstMaths::sin(piOver(p)) * ConstMaths::cos(piOver(r)) / ConstMaths::sin(piHPQCalc(p, q));
 
 		switch(g) {
 			case Geometry::Hyperbolic:
-				return acosh(inRadius);
+				return ConstMaths::acosh(inRadius);
 			case Geometry::Euclidean:
 				return 1.0f; // m_euclideanScale
 			case Geometry::Spherical:
-				return acos(inRadius);
+				return ConstMaths::acos(inRadius);
 			default:
 				AU_ASSERT(false, "Geometry value g=\"{0}\" (could be passed in or calculated from"
 					" p={1}, q={2}, r={3}) isn't appropriate for this function."
@@ -31,18 +38,18 @@ namespace App
 		}
 	}
 
-	float inRadiusCalc(uint32_t p, uint32_t q, uint32_t r) {
+	constexpr float inRadiusCalc(uint32_t p, uint32_t q, uint32_t r) {
 		return inRadiusCalc(p, q, r, getGeometry(p, q, r));
 	}
 
-	float midRadiusCalc(uint32_t p, uint32_t q, uint32_t r, Geometry::V g, float inRadius) {
+	constexpr float midRadiusCalc(uint32_t p, uint32_t q, uint32_t r, Geometry::V g, float inRadius) {
 		switch(g) {
 			case Geometry::Hyperbolic:
-				return asinh(sinh(inRadius) / sin(piOver(r)));
+				return ConstMaths::asinh(ConstMaths::sinh(inRadius) / ConstMaths::sin(piOver(r)));
 			case Geometry::Euclidean:
-				return sqrt(2) * 1.0f;
+				return ConstMaths::sqrt(2.0f) * 1.0f;
 			case Geometry::Spherical:
-				return asin(sin(inRadius) / sin(piOver(r)));
+				return ConstMaths::asin(ConstMaths::sin(inRadius) / ConstMaths::sin(piOver(r)));
 			default:
 				AU_ASSERT(false, "Geometry value g=\"{0}\" (could be passed in or calculated from"
 					" p={1}, q={2}, r={3}) isn't appropriate for this function."
@@ -51,12 +58,11 @@ namespace App
 		}
 	}
 
-	float midRadiusCalc(uint32_t p, uint32_t q, uint32_t r, Geometry::V g) {
+	constexpr float midRadiusCalc(uint32_t p, uint32_t q, uint32_t r, Geometry::V g) {
 		return midRadiusCalc(p, q, r, g, inRadiusCalc(p, q, r, g));
 	}
 
-	float midRadiusCalc(uint32_t p, uint32_t q, uint32_t r) {
+	constexpr float midRadiusCalc(uint32_t p, uint32_t q, uint32_t r) {
 		return midRadiusCalc(p, q, r, getGeometry(p, q, r));
 	}
 }; // namespace App
-
@@ -0,0 +1,228 @@
+#include "HoneycombParams.h"
+
+#include "GeometryMaths.h"
+#include "Simplex.h"
+#include "HoneycombTable.h"
+#include "Scene.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace App
+{
+	HoneycombParams computeHoneycombParams(int p, int q, int r) {
+		HoneycombParams h{};
+		h.pqr = { p, q, r };
+		h.isCubical = (p == 4) && (q == 3);
+
+		// Straight out of sHoneycombTable for anything prewarm would have added.
+		const HoneycombConstants constants = getHoneycombConstants(p, q, r);
+		h.g = constants.g;
+		h.inRadius = constants.inRadius;
+		h.midRadius = constants.midRadius;
+		h.hCWH = constants.hCWH;
+		h.hCWK = constants.hCWK;
+		h.cut1 = constants.cut1;
+		h.cut4 = constants.cut4;
+		const Geometry::V g = h.g;
+
+		// The cases fall through, so it's always the spherical values that stick. That's how the UI
+		// has always done it, and the shaders are tuned to it, so it stays until someone goes
+		// through the other two.
+		switch(h.cut1) {
+			case Geometry::Euclidean:
+			{
+				h.cellPosition = {0.0f, 0.0f, 1.0f, 1.0f};
+
+				auto facetsUHS = simplexFacetsUHS(p, q, r);
+				auto a = getTrianglePSide(q, p);
+				// facetsUHS[3]
+				auto c = facetsUHS.cellMirror.radius;
+				auto b = sqrt(c*c - a*a);
+				glm::vec3 vUHS(0.0f, 0.0f, b);
+				auto poincare = UHSToPoincare(vUHS);
+				h.cellSurfaceDistance = poincareToHyperbolic(-poincare.z);
+			}
+			case Geometry::Hyperbolic:
+			{
+				h.cellPosition = {0.0f, 0.0f, 1.0f, 0.0f};
+
+				float a = getTrianglePSide(q, p);
+				float c = sinh(sin(a) / cos(piOver(r)));
+				float b = acosh(cosh(c) / cosh(a));
+				glm::vec3 poincare = UHSToPoincare({0.0f, 0.0f, hyperbolicToPoincare(b)});
+				h.cellSurfaceDistance = poincareToHyperbolic(-poincare.z);
+			}
+			case Geometry::Spherical:
+			{
+				h.cellPosition = {0.0f, 0.0f, 0.0f, 1.0f};
+				h.cellSurfaceDistance = h.midRadius;
+			}
+			default:
+				AU_ASSERT(true, "Geometry value g=\"{0}\" (calculated from p={1}, q={2}, "
+					"r={3}) isn't appropriate for this function. Check your arguments.");
+		}
+
+		h.vertexPosition = glm::vec4( h.hCWK, h.hCWK, h.hCWK, 1.0f );
+		if(g != Geometry::Euclidean) {
+			h.vertexPosition = normalize(g, h.vertexPosition);
+		}
+		if(h.cut4 == Geometry::Euclidean) {
+			h.vertexPosition = IDEALCUBECORNERKLEIN;
+		}
+
+		if(h.isCubical) {
+			h.targetFPS = 27.5f;
+			h.maxSteps = 31;
+		}
+		else {
+			h.cut4 = Geometry::Invalid;
+
+			h.targetFPS = 17.0f;
+			h.maxSteps = 55;
+		}
+
+		auto gens = initGenerators(p, q, r, defhCWK);
+		h.invGens = gens.invGens;
+		h.simplexMirrors = gens.simplexMirrors;
+		h.simplexDualPoints = gens.simplexDualPoints;
+		h.halfCubeDualPoints = gens.halfCubeDualPoints;
+
+		auto lights = initLights(g);
+		h.lightPositions = *lights.first;
+		h.lightIntensities = *lights.second;
+
+		return h;
+	}
+
+	float HoneycombParams::vertexSurfaceOffset(float tubeRadius) const {
+		const float cellOffset = cellSurfaceOffset(tubeRadius);
+		auto midEdge = constructPointInGeometry(g,
+				glm::vec3(cos(PI/4.0f), cos(PI/4.0f), 1),
+				cellOffset);
+
+		switch(cut4) {
+			case Geometry::Euclidean:
+			{
+				auto distToMidEdge = horosphereHSDF(g, midEdge, IDEALCUBECORNERKLEIN, -cellOffset);
+				return -(cellOffset - distToMidEdge);
+			}
+			case Geometry::Hyperbolic:
+				return geodesicPlaneHSDF(g, midEdge, vertexPosition, 0.0f);
+			case Geometry::Spherical:
+				return length(g, vertexPosition - midEdge);
+			default:
+				// The simplex honeycombs (cut4 = Invalid) don't cut the vertices off.
+				return 0.0f;
+		}
+	}
+
+	std::array<glm::vec4, 2> edgeTubePlanes(bool useSimplex, const std::array<glm::vec4, 3>& halfCubeDualPoints,
+	                                        const std::array<glm::vec4, 4>& simplexDualPoints) {
+		// v made perpendicular to the (unit) u, then normalized - as geometryNormalize in
+		// hyperbolic.glsl, which the shader uses whatever the geometry.
+		const auto perpendicular = [](const glm::vec4& v, const glm::vec4& u) {
+			const glm::vec4 w = v - lorentzDot(v, u) * u;
+			return w / std::sqrt(std::abs(lorentzDot(w, w)));
+		};
+		if (useSimplex) {
+			return { simplexDualPoints[3], perpendicular(simplexDualPoints[2], simplexDualPoints[3]) };
+		}
+		return { halfCubeDualPoints[0], perpendicular(halfCubeDualPoints[1], halfCubeDualPoints[0]) };
+	}
+
+	HoneycombUniforms HoneycombParams::uniforms(float tubeRadius) const {
+		HoneycombUniforms u{};
+		u.invGenerators = invGens;
+		u.lightPositions = lightPositions;
+		u.lightIntensities = lightIntensities;
+		u.halfCubeDualPoints = halfCubeDualPoints;
+		u.simplexMirrorsKlein = simplexMirrors;
+		u.simplexDualPoints = simplexDualPoints;
+		u.edgeTubePlanes = edgeTubePlanes(!isCubical, halfCubeDualPoints, simplexDualPoints);
+		u.cellPosition = cellPosition;
+		u.vertexPosition = vertexPosition;
+		u.halfCubeWidthKlein = hCWK;
+		u.cellSurfaceOffset = cellSurfaceOffset(tubeRadius);
+		u.vertexSurfaceOffset = vertexSurfaceOffset(tubeRadius);
+		u.useSimplex = !isCubical;
+		u.cut1 = cut1;
+		u.cut4 = cut4;
+		return u;
+	}
+
+	const HoneycombParams& HoneycombCache::get(const Key& pqr) {
+		auto it = mEntries.find(pqr);
+		if (it == mEntries.end()) {
+			it = mEntries.emplace(pqr, computeHoneycombParams(pqr[0], pqr[1], pqr[2])).first;
+		}
+		return it->second;
+	}
+
+	size_t HoneycombCache::prewarm(int maxValue) {
+		const size_t before = mEntries.size();
+		for (int q = 3; q <= maxValue; q++) {
+			for (int p = 3; p <= maxValue; p++) {
+				if (getGeometry2D(p, q) == Geometry::Hyperbolic) {
+					continue;
+				}
+				for (int r = 3; r <= maxValue; r++) {
+					if (getGeometry2D(q, r) != Geometry::Hyperbolic) {
+						get(p, q, r);
+					}
+				}
+			}
+		}
+		return mEntries.size() - before;
+	}
+
+	bool HoneycombCache::save(const std::string& path) const {
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			LOG_WARN("HoneycombCache: couldn't open \"{0}\" to save to.", path);
+			return false;
+		}
+
+		Header header{};
+		std::memcpy(header.magic, Magic, sizeof(Magic));
+		header.version = Version;
+		header.recordSize = sizeof(HoneycombParams);
+		header.count = (uint32_t)mEntries.size();
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const auto& [pqr, params] : mEntries) {
+			file.write(reinterpret_cast<const char*>(&params), sizeof(params));
+		}
+		return (bool)file;
+	}
+
+	bool HoneycombCache::load(const std::string& path) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+
+		Header header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!file || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version
+				|| header.recordSize != sizeof(HoneycombParams)) {
+			LOG_WARN("HoneycombCache: \"{0}\" is from another version (or isn't a honeycomb cache at"
+					" all), ignoring it.", path);
+			return false;
+		}
+
+		std::vector<HoneycombParams> records(header.count);
+		file.read(reinterpret_cast<char*>(records.data()), (std::streamsize)(records.size() * sizeof(HoneycombParams)));
+		if (!file) {
+			LOG_WARN("HoneycombCache: \"{0}\" is cut short, ignoring it.", path);
+			return false;
+		}
+		for (const HoneycombParams& params : records) {
+			mEntries.insert_or_assign(params.pqr, params);
+		}
+		return true;
+	}
+}; // namespace App
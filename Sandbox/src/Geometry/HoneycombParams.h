@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Aulys.h"
+
+#include "Maths.h"
+#include "Geometry.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <type_traits>
+
+/* Everything the shaders (and SceneLayer) need to know about a honeycomb {p,q,r}, worked out once.
+ *
+ * Getting from {p,q,r} to the uniforms takes the in- and mid-radii, the simplex's mirrors and their
+ * dual points, the generators and the lights - a few hundred transcendental calls, and the
+ * simplex code allocates as it goes. None of it changes for a given {p,q,r}, so HoneycombCache
+ * keeps the results. Switching honeycomb is then a lookup and one UniformBuffer write (see
+ * HoneycombUniforms).
+ *
+ * The cache can fill itself with every honeycomb the shader can draw up front (prewarm), and be
+ * written to / read from a small binary file, so that a build that has run once starts with all of
+ * them already there. */
+
+namespace App
+{
+	// The Honeycomb uniform block in includes.glsl, laid out by std140 - the two have to be kept in
+	// step. Everything in it changes together, when the honeycomb does.
+	struct HoneycombUniforms
+	{
+		std::array<glm::mat4, 6> invGenerators;
+		std::array<glm::vec4, 4> lightPositions;
+		std::array<glm::vec4, 5> lightIntensities;
+		std::array<glm::vec4, 3> halfCubeDualPoints;
+		std::array<glm::vec4, 4> simplexMirrorsKlein;
+		std::array<glm::vec4, 4> simplexDualPoints;
+		std::array<glm::vec4, 2> edgeTubePlanes; // See edgeTubePlanes below.
+		glm::vec4 cellPosition;
+		glm::vec4 vertexPosition;
+		float halfCubeWidthKlein;
+		float cellSurfaceOffset;
+		float vertexSurfaceOffset;
+		int32_t useSimplex; // A GLSL bool is 4 bytes.
+		int32_t cut1;
+		int32_t cut4;
+		int32_t padding[2]; // std140 rounds the block up to a multiple of 16.
+	}; // struct HoneycombUniforms
+
+	static_assert(sizeof(HoneycombUniforms) == 800, "HoneycombUniforms has to match the std140 layout of"
+			" the Honeycomb block in includes.glsl.");
+	static_assert(offsetof(HoneycombUniforms, cellPosition) == 736 && offsetof(HoneycombUniforms, cut4) == 788,
+			"HoneycombUniforms has to match the std140 layout of the Honeycomb block in includes.glsl.");
+
+	struct HoneycombParams
+	{
+		std::array<int, 3> pqr;
+		Geometry::V g;
+		Geometry::V cut1; // Of {p,q}, the cells' faces...
+		Geometry::V cut4; // ...and {q,r}, the vertex figure's - Invalid for the simplex honeycombs.
+		bool isCubical;
+
+		float inRadius;
+		float midRadius;
+		float hCWH; // Half the width of the cube, in the geometry...
+		float hCWK; // ...and in the Klein (or gnomonic) model.
+
+		// The cell (and vertex) surface is at this distance from cellPosition (vertexPosition), less
+		// the tube radius - which isn't known here, so uniforms() takes it off.
+		glm::vec4 cellPosition;
+		float cellSurfaceDistance;
+		glm::vec4 vertexPosition;
+
+		float targetFPS;
+		uint32_t maxSteps;
+
+		std::array<glm::mat4, 6> invGens;
+		std::array<glm::vec4, 4> simplexMirrors;
+		std::array<glm::vec4, 4> simplexDualPoints;
+		std::array<glm::vec4, 3> halfCubeDualPoints;
+		std::array<glm::vec4, 4> lightPositions;
+		std::array<glm::vec4, 5> lightIntensities;
+
+		// The whole uniform block for a tube radius. A couple of distance functions, no more.
+		HoneycombUniforms uniforms(float tubeRadius) const;
+		float cellSurfaceOffset(float tubeRadius) const { return cellSurfaceDistance - tubeRadius; };
+		float vertexSurfaceOffset(float tubeRadius) const;
+	}; // struct HoneycombParams
+
+	// The two perpendicular planes (as dual points) that meet along the edge localSceneSDF puts a
+	// tube around: the cube's first dual point and the second made perpendicular to it, or the
+	// simplex's last dual point and the one before made perpendicular to that. The SDF used to do
+	// this Gram-Schmidt itself, on every call. Normalized with the Lorentz norm, as the shader would.
+	std::array<glm::vec4, 2> edgeTubePlanes(bool useSimplex, const std::array<glm::vec4, 3>& halfCubeDualPoints,
+	                                        const std::array<glm::vec4, 4>& simplexDualPoints);
+
+	// Written to and read from disk as is, see HoneycombCache::save.
+	static_assert(std::is_trivially_copyable_v<HoneycombParams>);
+
+	// The slow way, which the cache is there to avoid.
+	HoneycombParams computeHoneycombParams(int p, int q, int r);
+
+	class HoneycombCache
+	{
+	public:
+		using Key = std::array<int, 3>;
+
+		HoneycombCache() = default;
+
+		// Worked out on the first call for each {p,q,r}, looked up after that.
+		const HoneycombParams& get(const Key& pqr);
+		const HoneycombParams& get(int p, int q, int r) { return get(Key{ p, q, r }); };
+		inline bool contains(const Key& pqr) const { return mEntries.count(pqr) != 0; };
+
+		// Fills in every honeycomb with 3 <= p, q, r <= maxValue whose cells and vertex figures are
+		// spherical or Euclidean (i.e. {p,q} and {q,r} aren't hyperbolic), which is every one the
+		// shader knows how to draw. Returns how many that added.
+		size_t prewarm(int maxValue);
+
+		// A Header, then Header::count HoneycombParams as they are in memory. The file is only ever
+		// read back by the build that wrote it (recordSize catches most changes to the struct, and
+		// Version should be bumped for the rest), so there's no point being portable.
+		bool save(const std::string& path) const;
+		// Adds what's in the file to what's already here. Leaves everything alone and returns false
+		// if there's no file, or it's not one we'd have written.
+		bool load(const std::string& path);
+
+		inline size_t size() const { return mEntries.size(); };
+		inline const std::map<Key, HoneycombParams>& getEntries() const { return mEntries; };
+
+		static constexpr char Magic[4] = { 'A', 'U', 'H', 'C' };
+		static constexpr uint32_t Version = 2; // 2: light 0 isn't NaN any more (see GeometryTraits::exp).
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t recordSize; // sizeof(HoneycombParams)
+			uint32_t count;
+		}; // struct Header
+		static_assert(sizeof(Header) == 16);
+
+	private:
+		// Ordered, so that the UI can list them as they are.
+		std::map<Key, HoneycombParams> mEntries;
+	}; // class HoneycombCache
+}; // namespace App
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Honeycomb.h"
+
+#include <array>
+
+/* The transcendental part of every honeycomb the shader can draw, worked out by the compiler.
+ *
+ * These are the {p,q,r} with 3 <= p, q, r <= sHoneycombTableMax whose cells {p,q} and vertex
+ * figures {q,r} are spherical or Euclidean - the same set HoneycombCache::prewarm fills in. Anything
+ * else goes through the same constexpr functions at run time, so the two can't disagree. */
+
+namespace App
+{
+	struct HoneycombConstants
+	{
+		int p = 0, q = 0, r = 0;
+		Geometry::V g = Geometry::Invalid;
+		Geometry::V cut1 = Geometry::Invalid; // getGeometry2D(p, q)
+		Geometry::V cut4 = Geometry::Invalid; // getGeometry2D(q, r)
+		float inRadius = 0.0f;
+		float midRadius = 0.0f;
+		float hCWH = 0.0f; // Half the width of the cell, in the geometry...
+		float hCWK = 0.0f; // ...and in the Klein (or gnomonic) model.
+	}; // struct HoneycombConstants
+
+	constexpr HoneycombConstants computeHoneycombConstants(int p, int q, int r) {
+		HoneycombConstants c;
+		c.p = p; c.q = q; c.r = r;
+		c.g = getGeometry(p, q, r);
+		c.cut1 = getGeometry2D(p, q);
+		c.cut4 = getGeometry2D(q, r);
+		c.inRadius = inRadiusCalc(p, q, r, c.g);
+		c.midRadius = midRadiusCalc(p, q, r, c.g, c.inRadius);
+		c.hCWH = c.hCWK = c.inRadius;
+		if (c.g == Geometry::Spherical) {
+			c.hCWK = stereographicToGnomonic(sphericalToStereographic(c.inRadius));
+		}
+		if (c.g == Geometry::Hyperbolic) {
+			c.hCWK = poincareToKlein(hyperbolicToPoincare(c.inRadius));
+		}
+		return c;
+	}
+
+	constexpr int sHoneycombTableMax = 6;
+
+	constexpr bool isTabulatedHoneycomb(int p, int q, int r) {
+		return p >= 3 && q >= 3 && r >= 3
+			&& p <= sHoneycombTableMax && q <= sHoneycombTableMax && r <= sHoneycombTableMax
+			&& getGeometry2D(p, q) != Geometry::Hyperbolic && getGeometry2D(q, r) != Geometry::Hyperbolic;
+	}
+
+	constexpr size_t countTabulatedHoneycombs() {
+		size_t count = 0;
+		for (int p = 3; p <= sHoneycombTableMax; p++) {
+			for (int q = 3; q <= sHoneycombTableMax; q++) {
+				for (int r = 3; r <= sHoneycombTableMax; r++) {
+					count += isTabulatedHoneycomb(p, q, r);
+				}
+			}
+		}
+		return count;
+	}
+
+	constexpr auto makeHoneycombTable() {
+		std::array<HoneycombConstants, countTabulatedHoneycombs()> table{};
+		size_t i = 0;
+		for (int p = 3; p <= sHoneycombTableMax; p++) {
+			for (int q = 3; q <= sHoneycombTableMax; q++) {
+				for (int r = 3; r <= sHoneycombTableMax; r++) {
+					if (isTabulatedHoneycomb(p, q, r)) {
+						table[i++] = computeHoneycombConstants(p, q, r);
+					}
+				}
+			}
+		}
+		return table;
+	}
+
+	// Sorted by {p,q,r}.
+	inline constexpr auto sHoneycombTable = makeHoneycombTable();
+
+	// The table's entry for {p,q,r}, or nullptr if it isn't in there.
+	constexpr const HoneycombConstants* findHoneycombConstants(int p, int q, int r) {
+		for (const HoneycombConstants& c : sHoneycombTable) {
+			if (c.p == p && c.q == q && c.r == r) {
+				return &c;
+			}
+		}
+		return nullptr;
+	}
+
+	// From the table if it's there, worked out otherwise.
+	constexpr HoneycombConstants getHoneycombConstants(int p, int q, int r) {
+		const HoneycombConstants* c = findHoneycombConstants(p, q, r);
+		return c ? *c : computeHoneycombConstants(p, q, r);
+	}
+
+	// The defaults in Maths.h and GeometryMaths.h were pasted in by hand, these keep them honest.
+	namespace Detail
+	{
+		constexpr bool near(float a, float b) { return (a > b ? a - b : b - a) < 1e-6f; }
+	}; // namespace Detail
+	static_assert(Detail::near(findHoneycombConstants(4, 3, 6)->hCWH, defhCWH),
+			"defhCWH should be {4,3,6}'s half cube width.");
+	static_assert(Detail::near(findHoneycombConstants(4, 3, 6)->hCWK, defhCWK),
+			"defhCWK should be {4,3,6}'s half cube width in the Klein model.");
+	static_assert(Detail::near(findHoneycombConstants(4, 3, 6)->hCWK, HALFIDEALCUBEWIDTHKLEIN),
+			"{4,3,6}'s cube is the ideal one, so HALFIDEALCUBEWIDTHKLEIN should be its half width.");
+}; // namespace App
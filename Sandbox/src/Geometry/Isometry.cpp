@@ -0,0 +1,86 @@
+#include "Isometry.h"
+
+namespace App
+{
+	Isometry<Geometry::Hyperbolic> Isometry<Geometry::Hyperbolic>::fromMat4(const glm::mat4& m) {
+		const glm::vec4 p = m[3];
+		const float s = glm::length(glm::vec3(p));
+		const glm::vec3 v = s == 0 ? glm::vec3(0.0f) : glm::vec3(p) * (std::acosh(std::max(p.w, 1.0f)) / s);
+		const Isometry boost = translation(v);
+		// What's left fixes the origin, so it's a rotation in the top left.
+		const glm::mat4 rest = boost.inverse().toMat4() * m;
+		return boost * rotation(glm::normalize(glm::quat_cast(glm::mat3(rest))));
+	}
+
+	Isometry<Geometry::Spherical> Isometry<Geometry::Spherical>::fromMat4(const glm::mat4& m) {
+		const glm::vec4 p = m[3];
+		const float s = glm::length(glm::vec3(p));
+		const glm::vec3 v = s == 0 ? glm::vec3(0.0f) : glm::vec3(p) * (std::atan2(s, p.w) / s);
+		const Isometry translate = translation(v);
+		const glm::mat4 rest = translate.inverse().toMat4() * m;
+		return translate * rotation(glm::normalize(glm::quat_cast(glm::mat3(rest))));
+	}
+
+	AnyIsometry AnyIsometry::identity(Geometry::V g) {
+		return dispatchGeometry(g, [](auto traits) {
+			return AnyIsometry(Isometry<decltype(traits)::geometry>::identity());
+		});
+	}
+
+	AnyIsometry AnyIsometry::translation(Geometry::V g, glm::vec3 v) {
+		return dispatchGeometry(g, [&](auto traits) {
+			return AnyIsometry(Isometry<decltype(traits)::geometry>::translation(v));
+		});
+	}
+
+	AnyIsometry AnyIsometry::rotation(Geometry::V g, const glm::quat& q) {
+		return dispatchGeometry(g, [&](auto traits) {
+			return AnyIsometry(Isometry<decltype(traits)::geometry>::rotation(q));
+		});
+	}
+
+	AnyIsometry AnyIsometry::fromMat4(Geometry::V g, const glm::mat4& m) {
+		return dispatchGeometry(g, [&](auto traits) {
+			return AnyIsometry(Isometry<decltype(traits)::geometry>::fromMat4(m));
+		});
+	}
+
+	Geometry::V AnyIsometry::getGeometry() const {
+		constexpr Geometry::V geometries[] = { Geometry::Hyperbolic, Geometry::Euclidean, Geometry::Spherical };
+		return geometries[mIso.index()];
+	}
+
+	AnyIsometry AnyIsometry::operator*(const AnyIsometry& o) const {
+		return std::visit([&](const auto& iso) {
+			using Iso = std::decay_t<decltype(iso)>;
+			const Iso* other = std::get_if<Iso>(&o.mIso);
+			AU_ASSERT(other, "Can't compose isometries of two different geometries ({0} and {1}).",
+					getGeometry(), o.getGeometry());
+			return other ? AnyIsometry(iso * *other) : *this;
+		}, mIso);
+	}
+
+	AnyIsometry AnyIsometry::inverse() const {
+		return std::visit([](const auto& iso) { return AnyIsometry(iso.inverse()); }, mIso);
+	}
+
+	glm::vec4 AnyIsometry::apply(const glm::vec4& p) const {
+		return std::visit([&](const auto& iso) { return iso.apply(p); }, mIso);
+	}
+
+	glm::vec4 AnyIsometry::origin() const {
+		return std::visit([](const auto& iso) { return iso.origin(); }, mIso);
+	}
+
+	glm::mat4 AnyIsometry::toMat4() const {
+		return std::visit([](const auto& iso) { return iso.toMat4(); }, mIso);
+	}
+
+	float AnyIsometry::drift() const {
+		return std::visit([](const auto& iso) { return iso.drift(); }, mIso);
+	}
+
+	void AnyIsometry::renormalize() {
+		std::visit([](auto& iso) { iso.renormalize(); }, mIso);
+	}
+}; // namespace App
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "Aulys.h"
+
+#include "Maths.h"
+#include "Geometry.h"
+
+#include "glm/gtx/quaternion.hpp"
+
+#include <complex>
+#include <variant>
+
+/* Isometries of the three geometries, kept in the smallest form that composes cheaply, rather than
+ * as 4x4 matrices.
+ *
+ *   - Hyperbolic: a matrix in SL(2,C) (the spin group of SO(3,1), a "rotor"), acting on a point
+ *     (x, y, z, w) of the hyperboloid as the Hermitian matrix X = w + x sx + y sy + z sz (the s's are
+ *     the Pauli matrices) by X -> A X A^H. A rotation by the unit quaternion q is
+ *     q.w - i (q.x sx + q.y sy + q.z sz), a boost of rapidity l along n is cosh(l/2) + sinh(l/2) n.s.
+ *   - Spherical: a pair of unit quaternions, acting on the point x + y i + z j + w as p -> l p r*.
+ *   - Euclidean: a unit quaternion and a translation, p -> q p q* + t.
+ *
+ * Composing two is 8 complex (or two quaternion) products, against 64 multiply-adds for the
+ * matrices, and inverting one is a few sign flips. Better still, the only way these can drift
+ * is in scale: any matrix in SL(2,C), any pair of unit quaternions, is an isometry. So instead of
+ * a Gram-Schmidt on every step, drift() measures how far off the scale is and renormalize() puts
+ * it back, which renormalizeIfDrifted only does once that's over a threshold.
+ *
+ * Every translation(v), rotation(q) and toMat4() agrees with the matrices: toMat4(translation(v))
+ * is GeometryTraits<G>::translate(v), toMat4(rotation(q)) is glm::toMat4(q), and
+ * toMat4(a * b) is toMat4(a) * toMat4(b). */
+
+namespace App
+{
+	template<Geometry::V G> class Isometry;
+
+	template<>
+	class Isometry<Geometry::Hyperbolic>
+	{
+	public:
+		using Complex = std::complex<float>;
+
+		Isometry() = default;
+		Isometry(Complex a, Complex b, Complex c, Complex d) : a(a), b(b), c(c), d(d) {};
+
+		static Isometry identity() { return {}; };
+
+		// The same boost as GeometryTraits<Geometry::Hyperbolic>::translate(v), rapidity |v|.
+		static Isometry translation(glm::vec3 v) {
+			const float l = glm::length(v);
+			if (l == 0) {
+				return {};
+			}
+			const glm::vec3 n = v * (std::sinh(0.5f * l) / l);
+			const float ch = std::cosh(0.5f * l);
+			return { Complex(ch + n.z), Complex(n.x, -n.y), Complex(n.x, n.y), Complex(ch - n.z) };
+		}
+
+		static Isometry rotation(const glm::quat& q) {
+			return { Complex(q.w, -q.z), Complex(-q.y, -q.x), Complex(q.y, -q.x), Complex(q.w, q.z) };
+		}
+
+		// m has to be an isometry (give or take rounding): a boost to where m takes the origin, then
+		// whatever rotation is left over.
+		static Isometry fromMat4(const glm::mat4& m);
+
+		Isometry operator*(const Isometry& o) const {
+			return { a * o.a + b * o.c, a * o.b + b * o.d, c * o.a + d * o.c, c * o.b + d * o.d };
+		}
+		Isometry& operator*=(const Isometry& o) { return *this = *this * o; };
+
+		// The adjugate, which is the inverse up to a factor of det - and the factor makes no
+		// difference to the isometry once it's been renormalized.
+		Isometry inverse() const { return { d, -b, -c, a }; };
+
+		glm::vec4 apply(const glm::vec4& p) const {
+			// A X A^H, X = [[w + z, x - iy], [x + iy, w - z]], and only the lower triangle of it.
+			const Complex x00(p.w + p.z), x01(p.x, -p.y), x10(p.x, p.y), x11(p.w - p.z);
+			const Complex t00 = a * x00 + b * x10, t01 = a * x01 + b * x11;
+			const Complex t10 = c * x00 + d * x10, t11 = c * x01 + d * x11;
+			const float y00 = (t00 * std::conj(a) + t01 * std::conj(b)).real();
+			const float y11 = (t10 * std::conj(c) + t11 * std::conj(d)).real();
+			const Complex y10 = t10 * std::conj(a) + t11 * std::conj(b);
+			return { y10.real(), y10.imag(), 0.5f * (y00 - y11), 0.5f * (y00 + y11) };
+		}
+
+		// apply(origin), with X the identity.
+		glm::vec4 origin() const {
+			const float y00 = std::norm(a) + std::norm(b);
+			const float y11 = std::norm(c) + std::norm(d);
+			const Complex y10 = c * std::conj(a) + d * std::conj(b);
+			return { y10.real(), y10.imag(), 0.5f * (y00 - y11), 0.5f * (y00 + y11) };
+		}
+
+		glm::mat4 toMat4() const {
+			return { apply({ 1.0f, 0.0f, 0.0f, 0.0f }), apply({ 0.0f, 1.0f, 0.0f, 0.0f }),
+			         apply({ 0.0f, 0.0f, 1.0f, 0.0f }), origin() };
+		}
+
+		float drift() const { return std::abs(a * d - b * c - 1.0f); };
+		void renormalize() {
+			const Complex s = 1.0f / std::sqrt(a * d - b * c);
+			a *= s; b *= s; c *= s; d *= s;
+		}
+
+	private:
+		Complex a{ 1.0f }, b{ 0.0f }, c{ 0.0f }, d{ 1.0f };
+	}; // class Isometry<Geometry::Hyperbolic>
+
+	template<>
+	class Isometry<Geometry::Spherical>
+	{
+	public:
+		Isometry() = default;
+		Isometry(const glm::quat& left, const glm::quat& right) : l(left), r(right) {};
+
+		static Isometry identity() { return {}; };
+
+		// The same rotation of the 3-sphere as GeometryTraits<Geometry::Spherical>::translate(v),
+		// taking the origin |v| along v.
+		static Isometry translation(glm::vec3 v) {
+			const float l = glm::length(v);
+			if (l == 0) {
+				return {};
+			}
+			const glm::quat h(std::cos(0.5f * l), v * (std::sin(0.5f * l) / l));
+			return { h, glm::conjugate(h) };
+		}
+
+		static Isometry rotation(const glm::quat& q) { return { q, q }; };
+
+		static Isometry fromMat4(const glm::mat4& m);
+
+		Isometry operator*(const Isometry& o) const { return { l * o.l, r * o.r }; };
+		Isometry& operator*=(const Isometry& o) { return *this = *this * o; };
+
+		Isometry inverse() const { return { glm::conjugate(l), glm::conjugate(r) }; };
+
+		glm::vec4 apply(const glm::vec4& p) const {
+			const glm::quat q = l * glm::quat(p.w, p.x, p.y, p.z) * glm::conjugate(r);
+			return { q.x, q.y, q.z, q.w };
+		}
+
+		glm::vec4 origin() const {
+			const glm::quat q = l * glm::conjugate(r);
+			return { q.x, q.y, q.z, q.w };
+		}
+
+		glm::mat4 toMat4() const {
+			return { apply({ 1.0f, 0.0f, 0.0f, 0.0f }), apply({ 0.0f, 1.0f, 0.0f, 0.0f }),
+			         apply({ 0.0f, 0.0f, 1.0f, 0.0f }), origin() };
+		}
+
+		float drift() const { return std::fabs(glm::dot(l, l) - 1.0f) + std::fabs(glm::dot(r, r) - 1.0f); };
+		void renormalize() { l = glm::normalize(l); r = glm::normalize(r); };
+
+	private:
+		glm::quat l{ 1.0f, 0.0f, 0.0f, 0.0f }, r{ 1.0f, 0.0f, 0.0f, 0.0f };
+	}; // class Isometry<Geometry::Spherical>
+
+	template<>
+	class Isometry<Geometry::Euclidean>
+	{
+	public:
+		Isometry() = default;
+		Isometry(const glm::quat& rotation, const glm::vec3& translation) : q(rotation), t(translation) {};
+
+		static Isometry identity() { return {}; };
+		static Isometry translation(glm::vec3 v) { return { glm::quat(1.0f, 0.0f, 0.0f, 0.0f), v }; };
+		static Isometry rotation(const glm::quat& q) { return { q, glm::vec3(0.0f) }; };
+
+		static Isometry fromMat4(const glm::mat4& m) { return { glm::quat_cast(glm::mat3(m)), glm::vec3(m[3]) }; };
+
+		Isometry operator*(const Isometry& o) const { return { q * o.q, q * o.t + t }; };
+		Isometry& operator*=(const Isometry& o) { return *this = *this * o; };
+
+		Isometry inverse() const {
+			const glm::quat c = glm::conjugate(q);
+			return { c, -(c * t) };
+		}
+
+		glm::vec4 apply(const glm::vec4& p) const { return { q * glm::vec3(p) + t * p.w, p.w }; };
+		glm::vec4 origin() const { return { t, 1.0f }; };
+
+		glm::mat4 toMat4() const {
+			glm::mat4 m = glm::toMat4(q);
+			m[3] = origin();
+			return m;
+		}
+
+		float drift() const { return std::fabs(glm::dot(q, q) - 1.0f); };
+		void renormalize() { q = glm::normalize(q); };
+
+	private:
+		glm::quat q{ 1.0f, 0.0f, 0.0f, 0.0f };
+		glm::vec3 t{ 0.0f };
+	}; // class Isometry<Geometry::Euclidean>
+
+	// How often an isometry that's being built up step by step had to be pulled back.
+	struct IsometryDriftStats
+	{
+		uint64_t checks = 0;
+		uint64_t renormalizations = 0;
+		float lastDrift = 0.0f; // What drift() was at the last check, before renormalizing...
+		float maxDrift = 0.0f;  // ...and the most it's been.
+	}; // struct IsometryDriftStats
+
+	// Each composition adds an ulp or so to the drift, so at this threshold a camera renormalizes every
+	// fifty to a few hundred steps - and until it does, its points are within a hundred thousandth of
+	// the surface.
+	constexpr float sIsometryDriftThreshold = 1e-5f;
+
+	// Renormalizes iso if it's drifted more than threshold. Returns whether it did.
+	template<class Iso>
+	bool renormalizeIfDrifted(Iso& iso, IsometryDriftStats& stats, float threshold = sIsometryDriftThreshold) {
+		const float drift = iso.drift();
+		stats.checks++;
+		stats.lastDrift = drift;
+		stats.maxDrift = std::max(stats.maxDrift, drift);
+		if (drift > threshold) {
+			iso.renormalize();
+			stats.renormalizations++;
+			return true;
+		}
+		return false;
+	}
+
+	// One of the three, for code that only knows its geometry at run time (SceneLayer's camera).
+	// Anything in a loop should use Isometry<G> directly.
+	class AnyIsometry
+	{
+	public:
+		AnyIsometry() = default;
+		template<Geometry::V G>
+		AnyIsometry(const Isometry<G>& iso) : mIso(iso) {};
+
+		static AnyIsometry identity(Geometry::V g);
+		static AnyIsometry translation(Geometry::V g, glm::vec3 v);
+		static AnyIsometry rotation(Geometry::V g, const glm::quat& q);
+		static AnyIsometry fromMat4(Geometry::V g, const glm::mat4& m);
+
+		Geometry::V getGeometry() const;
+
+		// Both have to be in the same geometry.
+		AnyIsometry operator*(const AnyIsometry& o) const;
+		AnyIsometry& operator*=(const AnyIsometry& o) { return *this = *this * o; };
+		AnyIsometry inverse() const;
+
+		glm::vec4 apply(const glm::vec4& p) const;
+		glm::vec4 origin() const;
+		glm::mat4 toMat4() const;
+
+		float drift() const;
+		void renormalize();
+
+	private:
+		std::variant<Isometry<Geometry::Hyperbolic>, Isometry<Geometry::Euclidean>,
+		             Isometry<Geometry::Spherical>> mIso;
+	}; // class AnyIsometry
+}; // namespace App
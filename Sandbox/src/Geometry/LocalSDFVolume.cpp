@@ -0,0 +1,165 @@
+#include "LocalSDFVolume.h"
+
+#include "Maths.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace App
+{
+	namespace
+	{
+		// Keeps the samples off the edge of the Klein ball, where there's no point to put them at.
+		constexpr float maxKleinRadius = 0.9999f;
+
+		// The local scene at a point in the Klein model, as edgeTubes.glsl's localSceneSDF has it.
+		float localSceneSDF(const LocalSDFVolume::Input& input, glm::vec3 klein) {
+			const float r2 = glm::dot(klein, klein);
+			if (r2 > maxKleinRadius * maxKleinRadius) {
+				klein *= maxKleinRadius / std::sqrt(r2);
+			}
+			if (!input.useSimplex) {
+				// The same fold: into the positive octant, then sorted so x >= y >= z.
+				klein = glm::abs(klein);
+				if (klein.x < klein.z) { std::swap(klein.x, klein.z); }
+				if (klein.y < klein.z) { std::swap(klein.y, klein.z); }
+				if (klein.x < klein.y) { std::swap(klein.x, klein.y); }
+			}
+			const glm::vec4 point = glm::vec4(klein, 1.0f) / std::sqrt(1.0f - glm::dot(klein, klein));
+			const float dot1 = -lorentzDot(point, input.edgeTubePlanes[0]);
+			const float dot2 = -lorentzDot(point, input.edgeTubePlanes[1]);
+			return std::asinh(std::sqrt(dot1 * dot1 + dot2 * dot2)) - input.tubeRadius;
+		}
+
+		// Where the samples go. The cube's folded into its positive octant, so that's all of it
+		// there is to bake. The simplex isn't, so it's the box around its four vertices - each where
+		// three of the mirrors meet - or as much of that as is inside the ball.
+		void bakeBox(const LocalSDFVolume::Input& input, glm::vec3& boxMin, glm::vec3& boxMax) {
+			if (!input.useSimplex) {
+				boxMin = glm::vec3(0.0f);
+				boxMax = glm::vec3(std::min(input.halfCubeWidthKlein, maxKleinRadius));
+				return;
+			}
+			boxMin = glm::vec3(maxKleinRadius);
+			boxMax = glm::vec3(-maxKleinRadius);
+			const auto& mirrors = input.simplexMirrorsKlein;
+			for (int opposite = 0; opposite < 4; opposite++) {
+				// The mirror's points are the k with dot(k, normal) = offset.
+				glm::mat3 normals;
+				glm::vec3 offsets;
+				for (int i = 0, row = 0; i < 4; i++) {
+					if (i == opposite) {
+						continue;
+					}
+					normals[0][row] = mirrors[i].x; normals[1][row] = mirrors[i].y; normals[2][row] = mirrors[i].z;
+					offsets[row] = mirrors[i].w;
+					row++;
+				}
+				if (std::abs(glm::determinant(normals)) < 1e-6f) {
+					// Three mirrors that don't meet in a point: just use the whole ball.
+					boxMin = glm::vec3(-maxKleinRadius);
+					boxMax = glm::vec3(maxKleinRadius);
+					return;
+				}
+				const glm::vec3 vertex = glm::inverse(normals) * offsets;
+				boxMin = glm::min(boxMin, vertex);
+				boxMax = glm::max(boxMax, vertex);
+			}
+			boxMin = glm::clamp(boxMin, -maxKleinRadius, maxKleinRadius);
+			boxMax = glm::clamp(boxMax, -maxKleinRadius, maxKleinRadius);
+		}
+	}; // namespace
+
+	bool LocalSDFVolume::Input::operator==(const Input& other) const {
+		return useSimplex == other.useSimplex && edgeTubePlanes == other.edgeTubePlanes
+			&& simplexMirrorsKlein == other.simplexMirrorsKlein && halfCubeWidthKlein == other.halfCubeWidthKlein
+			&& tubeRadius == other.tubeRadius && resolution == other.resolution;
+	}
+
+	LocalSDFVolume::Bake LocalSDFVolume::bake(const Input& input) {
+		const auto start = std::chrono::steady_clock::now();
+
+		Bake bake;
+		bake.input = input;
+		bakeBox(input, bake.boxMin, bake.boxMax);
+
+		const uint32_t n = std::max(input.resolution, 2u);
+		bake.input.resolution = n;
+		bake.distances.resize((size_t)n * n * n);
+		const glm::vec3 step = (bake.boxMax - bake.boxMin) / (float)(n - 1);
+
+		// Every slice of z is independent, so the slices are shared out between the threads.
+		const uint32_t threads = std::clamp(std::thread::hardware_concurrency(), 1u, n);
+		const auto bakeSlices = [&](uint32_t first, uint32_t last) {
+			for (uint32_t z = first; z < last; z++) {
+				for (uint32_t y = 0; y < n; y++) {
+					float* row = &bake.distances[((size_t)z * n + y) * n];
+					for (uint32_t x = 0; x < n; x++) {
+						row[x] = localSceneSDF(input, bake.boxMin + step * glm::vec3(x, y, z));
+					}
+				}
+			}
+		};
+		std::vector<std::future<void>> slabs;
+		for (uint32_t i = 1; i < threads; i++) {
+			slabs.push_back(std::async(std::launch::async, bakeSlices, n * i / threads, n * (i + 1) / threads));
+		}
+		bakeSlices(0, n / threads);
+		for (auto& slab : slabs) {
+			slab.get();
+		}
+
+		bake.threads = threads;
+		bake.milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return bake;
+	}
+
+	void LocalSDFVolume::request(const Input& input) {
+		mRequested = input;
+		if (mRunning.valid()) {
+			mWaiting = input;
+			return;
+		}
+		mWaiting.reset();
+		mRunning = std::async(std::launch::async, &LocalSDFVolume::bake, input);
+	}
+
+	bool LocalSDFVolume::poll() {
+		if (!mRunning.valid() || mRunning.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return false;
+		}
+		Bake bake = mRunning.get();
+		if (mWaiting) {
+			request(*mWaiting);
+		}
+		if (bake.input != mRequested && mTexture) {
+			// Out of date before it got here - the waiting one will replace it soon enough.
+			return false;
+		}
+
+		const uint32_t n = bake.input.resolution;
+		if (!mTexture || mTexture->getWidth() != n) {
+			mTexture = Texture3D::create(n, n, n, TextureFormat::R32F);
+		}
+		mTexture->setData(bake.distances.data(), (uint32_t)(bake.distances.size() * sizeof(float)));
+		LOG_INFO("Baked the local SDF: {0}^3 samples in {1:.1f} ms, over {2} threads.", n, bake.milliseconds,
+		         bake.threads);
+
+		bake.distances.clear();
+		bake.distances.shrink_to_fit();
+		mLatest = std::move(bake);
+		return true;
+	}
+
+	glm::vec3 LocalSDFVolume::getScale() const {
+		const float n = (float)mLatest.input.resolution;
+		const glm::vec3 size = glm::max(mLatest.boxMax - mLatest.boxMin, glm::vec3(1e-6f));
+		// The first and last samples are at the middles of the first and last texels.
+		return (n - 1.0f) / (n * size);
+	}
+
+	float LocalSDFVolume::getVoxelDiagonal() const {
+		return glm::length(mLatest.boxMax - mLatest.boxMin) / (float)(mLatest.input.resolution - 1);
+	}
+}; // namespace App
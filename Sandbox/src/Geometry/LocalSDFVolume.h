@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Aulys.h"
+using namespace Aulys;
+
+#include <array>
+#include <future>
+#include <optional>
+#include <vector>
+
+/* The local scene (the edge tubes, see edgeTubes.glsl) baked into a 3D texture, so the raymarcher
+ * can look its distance up instead of working it out.
+ *
+ * The local scene's the same in every cell, so one volume covers all of them. It's sampled on a
+ * regular grid over the cell's bounding box in the Klein model - only the positive octant of it for
+ * the cube, since the shader folds into that anyway. The shader samples it trilinearly, and takes
+ * off enough that the result is still never more than the true distance (see bakedLocalSDF), and
+ * can hand over to the analytic SDF near the surface, where it matters.
+ *
+ * Baking doesn't touch GL, so it happens off the main thread: request starts one (split into slabs
+ * over a few more threads), and poll uploads whichever finished. A request made while one's already
+ * running waits for it, and only the newest waiting request is kept. */
+
+namespace App
+{
+	class LocalSDFVolume
+	{
+	public:
+		// Everything the local scene depends on, as the shader has it.
+		struct Input
+		{
+			bool useSimplex = false;
+			std::array<glm::vec4, 2> edgeTubePlanes{};
+			std::array<glm::vec4, 4> simplexMirrorsKlein{};
+			float halfCubeWidthKlein = 0.0f;
+			float tubeRadius = 0.0f;
+			uint32_t resolution = 64; // Samples along each side.
+
+			bool operator==(const Input& other) const;
+			bool operator!=(const Input& other) const { return !(*this == other); }
+		}; // struct Input
+
+		// One finished bake.
+		struct Bake
+		{
+			Input input;
+			// The box the samples span, in the Klein model: the first sample's at boxMin and the last
+			// at boxMax.
+			glm::vec3 boxMin{ 0.0f }, boxMax{ 0.0f };
+			std::vector<float> distances; // x fastest, then y, then z.
+			float milliseconds = 0.0f;
+			uint32_t threads = 0;
+		}; // struct Bake
+
+		// The slow part. Safe to call from any thread.
+		static Bake bake(const Input& input);
+
+		// Bakes for input, now or once the running bake's done.
+		void request(const Input& input);
+		// On the main thread, once a frame. Uploads a finished bake, and starts a waiting request.
+		// True if the texture's just changed.
+		bool poll();
+
+		// Is the texture baked from the last input requested? Until it is, it's a different scene.
+		bool isCurrent() const { return mTexture && !mRunning.valid() && !mWaiting && mLatest.input == mRequested; }
+		bool isBaking() const { return mRunning.valid(); }
+
+		const Ref<Texture3D>& getTexture() const { return mTexture; }
+		// The last bake uploaded, without its distances (they're on the GPU).
+		const Bake& getLatest() const { return mLatest; }
+
+		// What the shader needs to find a point's texel: uvw = (klein - boxMin) * scale + offset.
+		glm::vec3 getScale() const;
+		float getOffset() const { return 0.5f / (float)mLatest.input.resolution; }
+		// The length of a voxel's diagonal, in the Klein model (see bakedLocalSDF).
+		float getVoxelDiagonal() const;
+
+	private:
+		// A std::async future waits for its thread when it goes, so a bake never outlives us.
+		std::future<Bake> mRunning;
+		std::optional<Input> mWaiting;
+		Input mRequested;
+		Bake mLatest;
+		Ref<Texture3D> mTexture;
+	}; // class LocalSDFVolume
+}; // namespace App
@@ -35,39 +35,11 @@ namespace App {
 
 
 	glm::mat4 translateByVector(Geometry::V geometry, glm::vec3 v) {
-		auto dx = v.x; auto dy = v.y; auto dz = v.z;
-		auto length = sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
-
-		auto mat = glm::mat4(0.0f);
-
-		if (length == 0) {
-			return mat;
-		}
-
-		// Normalize the vector
-		dx /= length; dy /= length; dz /= length;
-
-		// Start building the matrix
-		auto m03 = dx; auto m13 = dy; auto m23 = dz;
-		float c1 = sinh(length); float c2 = cosh(length) - 1;
-
-		if (geometry == Geometry::Euclidean) {
-			m03 = m13 = m23 = c2 = 0;
-			c1 = length;
-		}
-		else { // Currently hyperbolic only!
-			mat[0] = glm::vec4(glm::vec3(0.0f), dx);
-			mat[1] = glm::vec4(glm::vec3(0.0f), dy);
-			mat[2] = glm::vec4(glm::vec3(0.0f), dz);
-			mat[3] = glm::vec4(m03, m13, m23, 0.0f);
-			auto matSquared = mat * mat;
-			mat = c1 * mat;
-			matSquared = c2 * matSquared;
-			auto result = glm::mat4(1.0f) + mat + matSquared;
-			return result;
+		// A zero vector has always given a zero matrix rather than the identity, and Scene.h pads
+		// the simplex generators with those - keep it that way.
+		if (v == glm::vec3(0.0f)) {
+			return glm::mat4(0.0f);
 		}
-		AU_ASSERT(false, "We got asked to translate a vector using an unsupported geometry \"{}\"",
-				(int)geometry);
-		return mat;
+		return dispatchGeometry(geometry, [&](auto traits) { return decltype(traits)::translate(v); });
 	}
 } // namespace App
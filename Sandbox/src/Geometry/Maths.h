@@ -5,8 +5,10 @@
 #include <cmath>
 
 #include "GeometryEnum.h"
+#include "ConstMaths.h"
 
 #define PI 3.14159265358979f
+// {4,3,6}'s half cube width, in H^3 and in the Klein model - HoneycombTable.h checks them.
 #define defhCWH 0.6584789485f
 #define defhCWK 0.5773502692f
 
@@ -62,32 +64,168 @@ namespace App
 		return v.x * w.x + v.y * w.y + v.z * w.z + v.w * w.w;
 	};
 
-	template<typename T>
-	constexpr auto dotg(Geometry::V g, const T& v, const T& w) {
-		if(g == Geometry::Hyperbolic) {
-			return lorentzDot(v, w);
+/**************************************************************************************************/
+/*** GeometryTraits - the maths of one geometry, chosen at compile time. ***/
+/**************************************************************************************************/
+
+	// Each specialisation has the metric (dot), the exponential map at the origin (exp), translation
+	// along a vector from the origin (translate), the inverse of one of its isometries (inverse,
+	// which is far cheaper than glm::inverse when the geometry has a metric) and the side of a
+	// triangle from its angles. Reflection, length and normalisation come from GeometryTraitsBase.
+	//
+	// Anything that loops should be a template on the geometry and use these directly, so the
+	// compiler sees exactly one geometry and no branches. The functions taking a runtime
+	// Geometry::V go through dispatchGeometry once, at the boundary.
+	template<Geometry::V G> struct GeometryTraits;
+
+	template<class Traits>
+	struct GeometryTraitsBase
+	{
+		template<typename T>
+		static auto length(const T& v) { return std::sqrt(std::fabs(Traits::dot(v, v))); }
+
+		template<typename T>
+		static T normalize(const T& v) { return v / length(v); }
+
+		// Reflects v in the plane with the dual point (normal) plane.
+		template<typename T>
+		static T reflect(const T& plane, const T& v) {
+			return v - plane * (2 * Traits::dot(plane, v) / Traits::dot(plane, plane));
 		}
-		else if(g == Geometry::Euclidean) {
-			return dotg(v, w);
+	}; // struct GeometryTraitsBase
+
+	// The translations of both the hyperboloid and the sphere are exponentials of the same kind of
+	// matrix, with a symmetric (sign = 1, a boost) or antisymmetric (sign = -1, a rotation) w row.
+	template<int sign>
+	glm::mat4 lorentzianTranslation(glm::vec3 v, float c1, float c2, float length) {
+		const glm::vec3 d = v / length;
+		glm::mat4 mat{ 0.0f };
+		mat[0] = glm::vec4(glm::vec3(0.0f), sign * d.x);
+		mat[1] = glm::vec4(glm::vec3(0.0f), sign * d.y);
+		mat[2] = glm::vec4(glm::vec3(0.0f), sign * d.z);
+		mat[3] = glm::vec4(d, 0.0f);
+		return glm::mat4(1.0f) + c1 * mat + c2 * (mat * mat);
+	};
+
+	template<>
+	struct GeometryTraits<Geometry::Hyperbolic> : GeometryTraitsBase<GeometryTraits<Geometry::Hyperbolic>>
+	{
+		static constexpr Geometry::V geometry = Geometry::Hyperbolic;
+
+		template<typename T>
+		static constexpr auto dot(const T& v, const T& w) { return lorentzDot(v, w); }
+
+		// dir's a tangent at the origin, so it's normalized as an ordinary vector - direction() would
+		// measure a vec3 with the Lorentzian dot, and take its z for time.
+		static glm::vec4 exp(glm::vec3 dir, float distance) {
+			const float w = std::cosh(distance);
+			const glm::vec3 d = glm::normalize(dir) * std::sqrt(w * w - 1);
+			return glm::vec4(d, w);
 		}
-		else if(g == Geometry::Spherical) {
-			return sphericalDot(v, w);
+
+		static glm::mat4 translate(glm::vec3 v) {
+			const float l = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+			return l == 0 ? glm::mat4(1.0f) : lorentzianTranslation<1>(v, std::sinh(l), std::cosh(l) - 1, l);
 		}
-		else {
-			AU_ASSERT(false, "The geometry value {0} passed in isn't recognised by this function."
-					" Check your arguments.", g);
-			return 0.0f;
+
+		// Isometries of the hyperboloid satisfy m^T J m = J, so m^-1 = J m^T J, J = diag(1, 1, 1, -1).
+		static glm::mat4 inverse(const glm::mat4& m) {
+			glm::mat4 t = glm::transpose(m);
+			for (int i = 0; i < 3; i++) {
+				t[i][3] = -t[i][3];
+				t[3][i] = -t[3][i];
+			}
+			return t;
 		}
+
+		static float triangleSide(float alpha, float beta, float gamma) {
+			return std::acosh((std::cos(alpha) + std::cos(beta) * std::cos(gamma)) / (std::sin(beta) * std::sin(gamma)));
+		}
+	}; // struct GeometryTraits<Geometry::Hyperbolic>
+
+	template<>
+	struct GeometryTraits<Geometry::Spherical> : GeometryTraitsBase<GeometryTraits<Geometry::Spherical>>
+	{
+		static constexpr Geometry::V geometry = Geometry::Spherical;
+
+		template<typename T>
+		static constexpr auto dot(const T& v, const T& w) { return sphericalDot(v, w); }
+
+		static glm::vec4 exp(glm::vec3 dir, float distance) {
+			const float w = std::cos(distance);
+			return glm::vec4(glm::normalize(dir) * std::sqrt(1 - w * w), w);
+		}
+
+		static glm::mat4 translate(glm::vec3 v) {
+			const float l = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+			return l == 0 ? glm::mat4(1.0f) : lorentzianTranslation<-1>(v, std::sin(l), 1 - std::cos(l), l);
+		}
+
+		// Rotations - orthogonal.
+		static glm::mat4 inverse(const glm::mat4& m) { return glm::transpose(m); }
+
+		static float triangleSide(float alpha, float beta, float gamma) {
+			return std::acos((std::cos(alpha) + std::cos(beta) * std::cos(gamma)) / (std::sin(beta) * std::sin(gamma)));
+		}
+	}; // struct GeometryTraits<Geometry::Spherical>
+
+	template<>
+	struct GeometryTraits<Geometry::Euclidean> : GeometryTraitsBase<GeometryTraits<Geometry::Euclidean>>
+	{
+		static constexpr Geometry::V geometry = Geometry::Euclidean;
+
+		template<typename T>
+		static constexpr auto dot(const T& v, const T& w) { return dotg(v, w); }
+
+		static glm::vec4 exp(glm::vec3 dir, float distance) {
+			return glm::vec4(glm::normalize(dir) * distance, 1);
+		}
+
+		static glm::mat4 translate(glm::vec3 v) { return glm::translate(glm::mat4(1.0f), v); }
+
+		static glm::mat4 inverse(const glm::mat4& m) { return glm::inverse(m); }
+
+		static float triangleSide(float alpha, float beta, float gamma) {
+			return 0.0f; // No such thing!
+		}
+	}; // struct GeometryTraits<Geometry::Euclidean>
+
+	// Calls f(GeometryTraits<g>{}) - the one place a runtime geometry turns into a compile-time one.
+	// Use it like:
+	//     dispatchGeometry(g, [&](auto traits) { return decltype(traits)::dot(v, w); });
+	template<class F>
+	constexpr auto dispatchGeometry(Geometry::V g, F&& f) {
+		switch (g) {
+			case Geometry::Hyperbolic:
+				return f(GeometryTraits<Geometry::Hyperbolic>{});
+			case Geometry::Euclidean:
+				return f(GeometryTraits<Geometry::Euclidean>{});
+			case Geometry::Spherical:
+				return f(GeometryTraits<Geometry::Spherical>{});
+			default:
+				AU_ASSERT(false, "The geometry value {0} passed in isn't recognised by this function."
+						" Check your arguments.", g);
+				return decltype(f(GeometryTraits<Geometry::Hyperbolic>{}))();
+		}
+	};
+
+/**************************************************************************************************/
+/*** Runtime geometry - for everything that isn't in a loop. ***/
+/**************************************************************************************************/
+
+	template<typename T>
+	constexpr auto dotg(Geometry::V g, const T& v, const T& w) {
+		return dispatchGeometry(g, [&](auto traits) { return decltype(traits)::dot(v, w); });
 	};
 
 	template<typename T>
 	constexpr float length(Geometry::V g, const T& v) {
-		return pow( fabs( dotg(g, v, v) ), 0.5f); // Check if there's a float absolute value?
+		return dispatchGeometry(g, [&](auto traits) { return decltype(traits)::length(v); });
 	};
 
 	template<typename T>
 	constexpr auto normalize(Geometry::V g, const T& v) {
-		return v / length(g, v);
+		return dispatchGeometry(g, [&](auto traits) { return decltype(traits)::normalize(v); });
 	};
 
 	glm::mat4 translateByVector(Geometry::V geometry, glm::vec3 v);
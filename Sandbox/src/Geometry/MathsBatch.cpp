@@ -0,0 +1,382 @@
+#include "MathsBatch.h"
+#include "Models.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+	#define AU_BATCH_X86 1
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#endif
+#endif
+
+namespace App
+{
+	namespace {
+		struct ConstSpan { const float *x, *y, *z, *w; };
+		struct Span { float *x, *y, *z, *w; };
+
+		ConstSpan span(const PointsSoA& p) { return { p.x.data(), p.y.data(), p.z.data(), p.w.data() }; }
+		Span span(PointsSoA& p) { return { p.x.data(), p.y.data(), p.z.data(), p.w.data() }; }
+
+/**************************************************************************************************/
+/*** Scalar - the reference, and the tails of the SIMD loops. ***/
+/**************************************************************************************************/
+
+		namespace Scalar {
+			void lorentzDot(ConstSpan a, ConstSpan b, float* out, size_t i, size_t n) {
+				for (; i < n; i++) {
+					out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] - a.w[i] * b.w[i];
+				}
+			}
+
+			void normalize(Span v, size_t i, size_t n) {
+				for (; i < n; i++) {
+					const float d = v.x[i] * v.x[i] + v.y[i] * v.y[i] + v.z[i] * v.z[i] - v.w[i] * v.w[i];
+					const float s = 1.0f / std::sqrt(std::fabs(d));
+					v.x[i] *= s; v.y[i] *= s; v.z[i] *= s; v.w[i] *= s;
+				}
+			}
+
+			void geodesicUniform(ConstSpan p, ConstSpan d, float c, float s, Span out, size_t i, size_t n) {
+				for (; i < n; i++) {
+					out.x[i] = p.x[i] * c + d.x[i] * s;
+					out.y[i] = p.y[i] * c + d.y[i] * s;
+					out.z[i] = p.z[i] * c + d.z[i] * s;
+					out.w[i] = p.w[i] * c + d.w[i] * s;
+				}
+			}
+
+			void geodesic(ConstSpan p, ConstSpan d, const float* c, const float* s, Span out, size_t i, size_t n) {
+				for (; i < n; i++) {
+					out.x[i] = p.x[i] * c[i] + d.x[i] * s[i];
+					out.y[i] = p.y[i] * c[i] + d.y[i] * s[i];
+					out.z[i] = p.z[i] * c[i] + d.z[i] * s[i];
+					out.w[i] = p.w[i] * c[i] + d.w[i] * s[i];
+				}
+			}
+
+			void transform(const float* m, ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) {
+					const float x = in.x[i], y = in.y[i], z = in.z[i], w = in.w[i];
+					out.x[i] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+					out.y[i] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+					out.z[i] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+					out.w[i] = m[3] * x + m[7] * y + m[11] * z + m[15] * w;
+				}
+			}
+
+			void klein(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) {
+					const float inverseW = 1.0f / in.w[i];
+					out.x[i] = in.x[i] * inverseW;
+					out.y[i] = in.y[i] * inverseW;
+					out.z[i] = in.z[i] * inverseW;
+					out.w[i] = 1.0f;
+				}
+			}
+
+			// The model conversions are Models.h's own, so the two can't disagree.
+			glm::vec3 at(ConstSpan p, size_t i) { return { p.x[i], p.y[i], p.z[i] }; }
+			void set(Span p, size_t i, const glm::vec3& v, float w) { p.x[i] = v.x; p.y[i] = v.y; p.z[i] = v.z; p.w[i] = w; }
+			void set(Span p, size_t i, const glm::vec4& v) { set(p, i, glm::vec3(v), v.w); }
+
+			void UHSToPoincare(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) { set(out, i, App::UHSToPoincare(at(in, i)), 1.0f); }
+			}
+			void poincareToUHS(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) { set(out, i, App::poincareToUHS(at(in, i)), 1.0f); }
+			}
+			void poincareToKlein(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) { set(out, i, App::poincareToKlein(at(in, i)), 1.0f); }
+			}
+			void kleinToPoincare(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) { set(out, i, App::kleinToPoincare(at(in, i)), 1.0f); }
+			}
+			void poincareToHyperboloid(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) { set(out, i, App::poincareToHyperboloid(at(in, i))); }
+			}
+			void hyperboloidToPoincare(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) {
+					set(out, i, App::hyperboloidToPoincare({ in.x[i], in.y[i], in.z[i], in.w[i] }), 1.0f);
+				}
+			}
+			void kleinToHyperboloid(ConstSpan in, Span out, size_t i, size_t n) {
+				for (; i < n; i++) { set(out, i, App::kleinToHyperboloid(at(in, i))); }
+			}
+
+			// The same signatures as the SIMD kernels, for the dispatch table.
+			void lorentzDot(ConstSpan a, ConstSpan b, float* out, size_t n) { lorentzDot(a, b, out, 0, n); }
+			void normalize(Span v, size_t n) { normalize(v, 0, n); }
+			void geodesicUniform(ConstSpan p, ConstSpan d, float c, float s, Span out, size_t n) {
+				geodesicUniform(p, d, c, s, out, 0, n);
+			}
+			void geodesic(ConstSpan p, ConstSpan d, const float* c, const float* s, Span out, size_t n) {
+				geodesic(p, d, c, s, out, 0, n);
+			}
+			void transform(const float* m, ConstSpan in, Span out, size_t n) { transform(m, in, out, 0, n); }
+			void klein(ConstSpan in, Span out, size_t n) { klein(in, out, 0, n); }
+			void UHSToPoincare(ConstSpan in, Span out, size_t n) { UHSToPoincare(in, out, 0, n); }
+			void poincareToUHS(ConstSpan in, Span out, size_t n) { poincareToUHS(in, out, 0, n); }
+			void poincareToKlein(ConstSpan in, Span out, size_t n) { poincareToKlein(in, out, 0, n); }
+			void kleinToPoincare(ConstSpan in, Span out, size_t n) { kleinToPoincare(in, out, 0, n); }
+			void poincareToHyperboloid(ConstSpan in, Span out, size_t n) { poincareToHyperboloid(in, out, 0, n); }
+			void hyperboloidToPoincare(ConstSpan in, Span out, size_t n) { hyperboloidToPoincare(in, out, 0, n); }
+			void kleinToHyperboloid(ConstSpan in, Span out, size_t n) { kleinToHyperboloid(in, out, 0, n); }
+		}; // namespace Scalar
+
+#ifdef AU_BATCH_X86
+/**************************************************************************************************/
+/*** SSE2 - always there on x86-64. ***/
+/**************************************************************************************************/
+
+		namespace SSE2 {
+			using F = __m128;
+			constexpr size_t W = 4;
+			inline F load(const float* p) { return _mm_loadu_ps(p); }
+			inline void store(float* p, F v) { _mm_storeu_ps(p, v); }
+			inline F set1(float v) { return _mm_set1_ps(v); }
+			inline F add(F a, F b) { return _mm_add_ps(a, b); }
+			inline F sub(F a, F b) { return _mm_sub_ps(a, b); }
+			inline F mul(F a, F b) { return _mm_mul_ps(a, b); }
+			inline F div(F a, F b) { return _mm_div_ps(a, b); }
+			inline F madd(F a, F b, F c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+			inline F nmadd(F a, F b, F c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+			inline F sqrt(F a) { return _mm_sqrt_ps(a); }
+			inline F abs(F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+			inline void leave() { }
+
+			#include "MathsBatchKernels.h"
+		}; // namespace SSE2
+
+/**************************************************************************************************/
+/*** AVX2 + FMA ***/
+/**************************************************************************************************/
+
+#if defined(__clang__)
+	#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("avx2,fma")
+#endif
+		namespace AVX2 {
+			using F = __m256;
+			constexpr size_t W = 8;
+			inline F load(const float* p) { return _mm256_loadu_ps(p); }
+			inline void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+			inline F set1(float v) { return _mm256_set1_ps(v); }
+			inline F add(F a, F b) { return _mm256_add_ps(a, b); }
+			inline F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+			inline F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+			inline F div(F a, F b) { return _mm256_div_ps(a, b); }
+			inline F madd(F a, F b, F c) { return _mm256_fmadd_ps(a, b, c); }
+			inline F nmadd(F a, F b, F c) { return _mm256_fnmadd_ps(a, b, c); }
+			inline F sqrt(F a) { return _mm256_sqrt_ps(a); }
+			inline F abs(F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+			// GCC doesn't always put this in itself when the function ends in a tail call.
+			inline void leave() { _mm256_zeroupper(); }
+
+			#include "MathsBatchKernels.h"
+		}; // namespace AVX2
+#if defined(__clang__)
+	#pragma clang attribute pop
+#elif defined(__GNUC__)
+	#pragma GCC pop_options
+#endif
+
+/**************************************************************************************************/
+/*** AVX-512 ***/
+/**************************************************************************************************/
+
+#if defined(__clang__)
+	#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("avx512f")
+#endif
+		namespace AVX512 {
+			using F = __m512;
+			constexpr size_t W = 16;
+			inline F load(const float* p) { return _mm512_loadu_ps(p); }
+			inline void store(float* p, F v) { _mm512_storeu_ps(p, v); }
+			inline F set1(float v) { return _mm512_set1_ps(v); }
+			inline F add(F a, F b) { return _mm512_add_ps(a, b); }
+			inline F sub(F a, F b) { return _mm512_sub_ps(a, b); }
+			inline F mul(F a, F b) { return _mm512_mul_ps(a, b); }
+			inline F div(F a, F b) { return _mm512_div_ps(a, b); }
+			inline F madd(F a, F b, F c) { return _mm512_fmadd_ps(a, b, c); }
+			inline F nmadd(F a, F b, F c) { return _mm512_fnmadd_ps(a, b, c); }
+			inline F sqrt(F a) { return _mm512_sqrt_ps(a); }
+			inline F abs(F a) { return _mm512_abs_ps(a); }
+			inline void leave() { _mm256_zeroupper(); }
+
+			#include "MathsBatchKernels.h"
+		}; // namespace AVX512
+#if defined(__clang__)
+	#pragma clang attribute pop
+#elif defined(__GNUC__)
+	#pragma GCC pop_options
+#endif
+#endif // AU_BATCH_X86
+
+/**************************************************************************************************/
+/*** Dispatch ***/
+/**************************************************************************************************/
+
+		struct Kernels {
+			void (*lorentzDot)(ConstSpan, ConstSpan, float*, size_t);
+			void (*normalize)(Span, size_t);
+			void (*geodesicUniform)(ConstSpan, ConstSpan, float, float, Span, size_t);
+			void (*geodesic)(ConstSpan, ConstSpan, const float*, const float*, Span, size_t);
+			void (*transform)(const float*, ConstSpan, Span, size_t);
+			void (*klein)(ConstSpan, Span, size_t);
+			// Models.h
+			void (*UHSToPoincare)(ConstSpan, Span, size_t);
+			void (*poincareToUHS)(ConstSpan, Span, size_t);
+			void (*poincareToKlein)(ConstSpan, Span, size_t);
+			void (*kleinToPoincare)(ConstSpan, Span, size_t);
+			void (*poincareToHyperboloid)(ConstSpan, Span, size_t);
+			void (*hyperboloidToPoincare)(ConstSpan, Span, size_t);
+			void (*kleinToHyperboloid)(ConstSpan, Span, size_t);
+		}; // struct Kernels
+
+		#define KERNELS_OF(ns) Kernels{ &ns::lorentzDot, &ns::normalize, &ns::geodesicUniform, &ns::geodesic,\
+		                                &ns::transform, &ns::klein,\
+		                                &ns::UHSToPoincare, &ns::poincareToUHS, &ns::poincareToKlein,\
+		                                &ns::kleinToPoincare, &ns::poincareToHyperboloid,\
+		                                &ns::hyperboloidToPoincare, &ns::kleinToHyperboloid }
+
+		const Kernels& kernelsFor(SimdLevel level) {
+			static const Kernels scalar = KERNELS_OF(Scalar);
+#ifdef AU_BATCH_X86
+			static const Kernels sse2 = KERNELS_OF(SSE2);
+			static const Kernels avx2 = KERNELS_OF(AVX2);
+			static const Kernels avx512 = KERNELS_OF(AVX512);
+			switch (level) {
+				case SimdLevel::AVX512: return avx512;
+				case SimdLevel::AVX2: return avx2;
+				case SimdLevel::SSE2: return sse2;
+				default: break;
+			}
+#endif
+			return scalar;
+		}
+
+		#undef KERNELS_OF
+
+		SimdLevel sLevel = detectSimdLevel();
+		const Kernels* sKernels = &kernelsFor(sLevel);
+	};
+
+	SimdLevel detectSimdLevel() {
+#if defined(AU_BATCH_X86) && defined(__GNUC__)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) {
+			return SimdLevel::AVX512;
+		}
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+			return SimdLevel::AVX2;
+		}
+		return SimdLevel::SSE2;
+#elif defined(AU_BATCH_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		const bool fma = info[2] & (1 << 12);
+		// The OS has to save the wider registers on context switches, too.
+		const bool osxsave = info[2] & (1 << 27);
+		const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+		__cpuidex(info, 7, 0);
+		const bool avx2 = info[1] & (1 << 5);
+		const bool avx512f = info[1] & (1 << 16);
+		if (avx512f && (xcr0 & 0xe6) == 0xe6) {
+			return SimdLevel::AVX512;
+		}
+		if (avx2 && fma && (xcr0 & 0x6) == 0x6) {
+			return SimdLevel::AVX2;
+		}
+		return SimdLevel::SSE2;
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	SimdLevel getSimdLevel() {
+		return sLevel;
+	}
+
+	void setSimdLevel(SimdLevel level) {
+		sLevel = std::min(level, detectSimdLevel());
+		sKernels = &kernelsFor(sLevel);
+	}
+
+	const char* simdLevelName(SimdLevel level) {
+		switch (level) {
+			case SimdLevel::Scalar: return "Scalar";
+			case SimdLevel::SSE2: return "SSE2";
+			case SimdLevel::AVX2: return "AVX2";
+			case SimdLevel::AVX512: return "AVX-512";
+			default: return "Unknown";
+		}
+	}
+
+	void lorentzDotBatch(const PointsSoA& a, const PointsSoA& b, float* out) {
+		AU_ASSERT(a.size() == b.size(), "[lorentzDotBatch] Got {0} and {1} points.", a.size(), b.size());
+		sKernels->lorentzDot(span(a), span(b), out, a.size());
+	}
+
+	void normalizeBatch(PointsSoA& v) {
+		sKernels->normalize(span(v), v.size());
+	}
+
+	void pointOnGeodesicBatch(const PointsSoA& p, const PointsSoA& dir, float t, PointsSoA& out) {
+		AU_ASSERT(p.size() == dir.size(), "[pointOnGeodesicBatch] Got {0} points and {1} directions.",
+		          p.size(), dir.size());
+		out.resize(p.size());
+		sKernels->geodesicUniform(span(p), span(dir), std::cosh(t), std::sinh(t), span(out), p.size());
+	}
+
+	void pointOnGeodesicBatch(const PointsSoA& p, const PointsSoA& dir, const float* t, PointsSoA& out) {
+		AU_ASSERT(p.size() == dir.size(), "[pointOnGeodesicBatch] Got {0} points and {1} directions.",
+		          p.size(), dir.size());
+		// The cosh/sinh are the only scalar part - one exp for both.
+		thread_local std::vector<float> c, s;
+		c.resize(p.size());
+		s.resize(p.size());
+		for (size_t i = 0; i < p.size(); i++) {
+			const float e = std::exp(t[i]);
+			const float inverseE = 1.0f / e;
+			c[i] = 0.5f * (e + inverseE);
+			s[i] = 0.5f * (e - inverseE);
+		}
+		out.resize(p.size());
+		sKernels->geodesic(span(p), span(dir), c.data(), s.data(), span(out), p.size());
+	}
+
+	void transformBatch(const glm::mat4& m, const PointsSoA& in, PointsSoA& out) {
+		out.resize(in.size());
+		sKernels->transform(glm::value_ptr(m), span(in), span(out), in.size());
+	}
+
+	void projectToKleinBatch(const PointsSoA& in, PointsSoA& out) {
+		out.resize(in.size());
+		sKernels->klein(span(in), span(out), in.size());
+	}
+
+	// One wrapper per conversion, all alike.
+	#define MODEL_CONVERSION(name, kernel) \
+	void name(const PointsSoA& in, PointsSoA& out) { \
+		out.resize(in.size()); \
+		sKernels->kernel(span(in), span(out), in.size()); \
+	}
+
+	MODEL_CONVERSION(UHSToPoincareBatch, UHSToPoincare)
+	MODEL_CONVERSION(poincareToUHSBatch, poincareToUHS)
+	MODEL_CONVERSION(poincareToKleinBatch, poincareToKlein)
+	MODEL_CONVERSION(kleinToPoincareBatch, kleinToPoincare)
+	MODEL_CONVERSION(poincareToHyperboloidBatch, poincareToHyperboloid)
+	MODEL_CONVERSION(hyperboloidToPoincareBatch, hyperboloidToPoincare)
+	MODEL_CONVERSION(kleinToHyperboloidBatch, kleinToHyperboloid)
+
+	#undef MODEL_CONVERSION
+}; // namespace App
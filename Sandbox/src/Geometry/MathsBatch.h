@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Aulys.h"
+
+#include <vector>
+
+/* Batch versions of the Lorentz (Minkowski) maths in Maths.h, for whenever there are many points to
+ * push through the same operation - light placement, object boosts, tiling enumeration, CPU-side
+ * marching. The points are kept as a structure of arrays (PointsSoA), so that one SIMD register
+ * holds the same coordinate of 4, 8 or 16 points.
+ *
+ * Every function picks the widest instruction set the CPU has (SSE2, AVX2+FMA or AVX-512) the
+ * first time it's called, and falls back to plain scalar code for the leftover points and on
+ * anything else. The results agree with the scalar versions (and with lorentzDot & co.) to within
+ * float rounding - the FMA paths round once where the scalar code rounds twice, so they aren't
+ * bit-identical, but they're no further apart than a few ulps.
+ *
+ * All of these are hyperbolic: the metric is diag(1, 1, 1, -1) and points live on the upper sheet
+ * of the hyperboloid. Inputs and outputs may be the same arrays. */
+
+namespace App
+{
+	// N points, as four arrays of coordinates.
+	struct PointsSoA
+	{
+		std::vector<float> x, y, z, w;
+
+		PointsSoA() = default;
+		explicit PointsSoA(size_t n) { resize(n); };
+
+		inline size_t size() const { return x.size(); };
+		inline void resize(size_t n) { x.resize(n); y.resize(n); z.resize(n); w.resize(n); };
+
+		inline glm::vec4 get(size_t i) const { return { x[i], y[i], z[i], w[i] }; };
+		inline void set(size_t i, const glm::vec4& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; w[i] = v.w; };
+	}; // struct PointsSoA
+
+	enum class SimdLevel { Scalar = 0, SSE2 = 1, AVX2 = 2, AVX512 = 3 };
+
+	// The widest level this CPU (and this build) supports.
+	SimdLevel detectSimdLevel();
+	// The level the batch functions use. Defaults to detectSimdLevel(), can be lowered (e.g. to
+	// compare the paths in a benchmark) but not raised past it.
+	SimdLevel getSimdLevel();
+	void setSimdLevel(SimdLevel level);
+	const char* simdLevelName(SimdLevel level);
+
+	// out[i] = lorentzDot(a[i], b[i]). out needs room for a.size() floats.
+	void lorentzDotBatch(const PointsSoA& a, const PointsSoA& b, float* out);
+
+	// v[i] /= sqrt(|lorentzDot(v[i], v[i])|), i.e. normalize(Geometry::Hyperbolic, v[i]).
+	void normalizeBatch(PointsSoA& v);
+
+	// The point at distance t along the geodesic through p[i] with unit tangent dir[i]:
+	// p cosh(t) + dir sinh(t). The first moves every point by the same t, the second by t[i].
+	void pointOnGeodesicBatch(const PointsSoA& p, const PointsSoA& dir, float t, PointsSoA& out);
+	void pointOnGeodesicBatch(const PointsSoA& p, const PointsSoA& dir, const float* t, PointsSoA& out);
+
+	// out[i] = m * in[i] - boosting a whole set of points at once.
+	void transformBatch(const glm::mat4& m, const PointsSoA& in, PointsSoA& out);
+
+	// Hyperboloid to the Klein model: (x, y, z, w) -> (x/w, y/w, z/w, 1).
+	void projectToKleinBatch(const PointsSoA& in, PointsSoA& out);
+
+	// The model conversions in Models.h, point by point. Points in the UHS and the two balls are
+	// (x, y, z, 1), as projectToKleinBatch leaves them; the w of the ones going in is ignored.
+	void UHSToPoincareBatch(const PointsSoA& in, PointsSoA& out);
+	void poincareToUHSBatch(const PointsSoA& in, PointsSoA& out);
+	void poincareToKleinBatch(const PointsSoA& in, PointsSoA& out);
+	void kleinToPoincareBatch(const PointsSoA& in, PointsSoA& out);
+	void poincareToHyperboloidBatch(const PointsSoA& in, PointsSoA& out);
+	void hyperboloidToPoincareBatch(const PointsSoA& in, PointsSoA& out);
+	void kleinToHyperboloidBatch(const PointsSoA& in, PointsSoA& out);
+}; // namespace App
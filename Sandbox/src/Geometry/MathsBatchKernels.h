@@ -0,0 +1,210 @@
+// No include guard on purpose: MathsBatch.cpp includes this once per instruction set, each time in
+// its own namespace and with its own target options. Before each include, that namespace defines
+//
+//     F                       the register type (e.g. __m256)
+//     W                       how many floats one holds
+//     load, store, set1       memory and broadcast
+//     add, sub, mul, div      the obvious
+//     madd(a, b, c)           a * b + c
+//     nmadd(a, b, c)          c - a * b
+//     sqrt, abs
+//     leave()                 before going back to scalar code (vzeroupper, for AVX)
+//
+// and the loops below handle W points at a time, leaving the rest to the Scalar:: versions.
+
+	void lorentzDot(ConstSpan a, ConstSpan b, float* out, size_t n) {
+		size_t i = 0;
+		for (; i + W <= n; i += W) {
+			F r = mul(load(a.x + i), load(b.x + i));
+			r = madd(load(a.y + i), load(b.y + i), r);
+			r = madd(load(a.z + i), load(b.z + i), r);
+			r = nmadd(load(a.w + i), load(b.w + i), r);
+			store(out + i, r);
+		}
+		leave();
+		Scalar::lorentzDot(a, b, out, i, n);
+	}
+
+	void normalize(Span v, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f);
+		for (; i + W <= n; i += W) {
+			const F x = load(v.x + i), y = load(v.y + i), z = load(v.z + i), w = load(v.w + i);
+			F d = mul(x, x);
+			d = madd(y, y, d);
+			d = madd(z, z, d);
+			d = nmadd(w, w, d);
+			const F s = div(one, sqrt(abs(d)));
+			store(v.x + i, mul(x, s));
+			store(v.y + i, mul(y, s));
+			store(v.z + i, mul(z, s));
+			store(v.w + i, mul(w, s));
+		}
+		leave();
+		Scalar::normalize(v, i, n);
+	}
+
+	void geodesicUniform(ConstSpan p, ConstSpan d, float c, float s, Span out, size_t n) {
+		size_t i = 0;
+		const F vc = set1(c), vs = set1(s);
+		for (; i + W <= n; i += W) {
+			store(out.x + i, madd(load(d.x + i), vs, mul(load(p.x + i), vc)));
+			store(out.y + i, madd(load(d.y + i), vs, mul(load(p.y + i), vc)));
+			store(out.z + i, madd(load(d.z + i), vs, mul(load(p.z + i), vc)));
+			store(out.w + i, madd(load(d.w + i), vs, mul(load(p.w + i), vc)));
+		}
+		leave();
+		Scalar::geodesicUniform(p, d, c, s, out, i, n);
+	}
+
+	void geodesic(ConstSpan p, ConstSpan d, const float* c, const float* s, Span out, size_t n) {
+		size_t i = 0;
+		for (; i + W <= n; i += W) {
+			const F vc = load(c + i), vs = load(s + i);
+			store(out.x + i, madd(load(d.x + i), vs, mul(load(p.x + i), vc)));
+			store(out.y + i, madd(load(d.y + i), vs, mul(load(p.y + i), vc)));
+			store(out.z + i, madd(load(d.z + i), vs, mul(load(p.z + i), vc)));
+			store(out.w + i, madd(load(d.w + i), vs, mul(load(p.w + i), vc)));
+		}
+		leave();
+		Scalar::geodesic(p, d, c, s, out, i, n);
+	}
+
+	// m is column major, as glm keeps it: m[4 * column + row].
+	void transform(const float* m, ConstSpan in, Span out, size_t n) {
+		F c[16];
+		for (int k = 0; k < 16; k++) {
+			c[k] = set1(m[k]);
+		}
+		size_t i = 0;
+		for (; i + W <= n; i += W) {
+			const F x = load(in.x + i), y = load(in.y + i), z = load(in.z + i), w = load(in.w + i);
+			float* const rows[4] = { out.x + i, out.y + i, out.z + i, out.w + i };
+			for (int r = 0; r < 4; r++) {
+				F v = mul(c[r], x);
+				v = madd(c[4 + r], y, v);
+				v = madd(c[8 + r], z, v);
+				v = madd(c[12 + r], w, v);
+				store(rows[r], v);
+			}
+		}
+		leave();
+		Scalar::transform(m, in, out, i, n);
+	}
+
+	void klein(ConstSpan in, Span out, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f);
+		for (; i + W <= n; i += W) {
+			const F inverseW = div(one, load(in.w + i));
+			store(out.x + i, mul(load(in.x + i), inverseW));
+			store(out.y + i, mul(load(in.y + i), inverseW));
+			store(out.z + i, mul(load(in.z + i), inverseW));
+			store(out.w + i, one);
+		}
+		leave();
+		Scalar::klein(in, out, i, n);
+	}
+
+	// UHSToPoincare (s = 1) and poincareToUHS (s = -1): (2x, 2y, s (|v|^2 - 1)) / (|v|^2 + 2sz + 1).
+	// Returns where it got to.
+	size_t cayley(ConstSpan in, Span out, float s, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f), two = set1(2.0f), vs = set1(s), twoS = set1(2.0f * s);
+		for (; i + W <= n; i += W) {
+			const F x = load(in.x + i), y = load(in.y + i), z = load(in.z + i);
+			const F n2 = madd(z, z, madd(y, y, mul(x, x)));
+			const F inverseD = div(one, madd(twoS, z, add(n2, one)));
+			store(out.x + i, mul(mul(two, x), inverseD));
+			store(out.y + i, mul(mul(two, y), inverseD));
+			store(out.z + i, mul(mul(vs, sub(n2, one)), inverseD));
+			store(out.w + i, one);
+		}
+		leave();
+		return i;
+	}
+
+	void UHSToPoincare(ConstSpan in, Span out, size_t n) {
+		Scalar::UHSToPoincare(in, out, cayley(in, out, 1.0f, n), n);
+	}
+
+	void poincareToUHS(ConstSpan in, Span out, size_t n) {
+		Scalar::poincareToUHS(in, out, cayley(in, out, -1.0f, n), n);
+	}
+
+	void poincareToKlein(ConstSpan in, Span out, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f), two = set1(2.0f);
+		for (; i + W <= n; i += W) {
+			const F x = load(in.x + i), y = load(in.y + i), z = load(in.z + i);
+			const F f = div(two, add(one, madd(z, z, madd(y, y, mul(x, x)))));
+			store(out.x + i, mul(x, f));
+			store(out.y + i, mul(y, f));
+			store(out.z + i, mul(z, f));
+			store(out.w + i, one);
+		}
+		leave();
+		Scalar::poincareToKlein(in, out, i, n);
+	}
+
+	void kleinToPoincare(ConstSpan in, Span out, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f);
+		for (; i + W <= n; i += W) {
+			const F x = load(in.x + i), y = load(in.y + i), z = load(in.z + i);
+			const F n2 = madd(z, z, madd(y, y, mul(x, x)));
+			const F f = div(one, add(one, sqrt(sub(one, n2))));
+			store(out.x + i, mul(x, f));
+			store(out.y + i, mul(y, f));
+			store(out.z + i, mul(z, f));
+			store(out.w + i, one);
+		}
+		leave();
+		Scalar::kleinToPoincare(in, out, i, n);
+	}
+
+	void poincareToHyperboloid(ConstSpan in, Span out, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f), two = set1(2.0f);
+		for (; i + W <= n; i += W) {
+			const F x = load(in.x + i), y = load(in.y + i), z = load(in.z + i);
+			const F n2 = madd(z, z, madd(y, y, mul(x, x)));
+			const F inverse = div(one, sub(one, n2));
+			const F f = mul(two, inverse);
+			store(out.x + i, mul(x, f));
+			store(out.y + i, mul(y, f));
+			store(out.z + i, mul(z, f));
+			store(out.w + i, mul(add(one, n2), inverse));
+		}
+		leave();
+		Scalar::poincareToHyperboloid(in, out, i, n);
+	}
+
+	void hyperboloidToPoincare(ConstSpan in, Span out, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f);
+		for (; i + W <= n; i += W) {
+			const F f = div(one, add(one, load(in.w + i)));
+			store(out.x + i, mul(load(in.x + i), f));
+			store(out.y + i, mul(load(in.y + i), f));
+			store(out.z + i, mul(load(in.z + i), f));
+			store(out.w + i, one);
+		}
+		leave();
+		Scalar::hyperboloidToPoincare(in, out, i, n);
+	}
+
+	void kleinToHyperboloid(ConstSpan in, Span out, size_t n) {
+		size_t i = 0;
+		const F one = set1(1.0f);
+		for (; i + W <= n; i += W) {
+			const F x = load(in.x + i), y = load(in.y + i), z = load(in.z + i);
+			const F f = div(one, sqrt(sub(one, madd(z, z, madd(y, y, mul(x, x))))));
+			store(out.x + i, mul(x, f));
+			store(out.y + i, mul(y, f));
+			store(out.z + i, mul(z, f));
+			store(out.w + i, f);
+		}
+		leave();
+		Scalar::kleinToHyperboloid(in, out, i, n);
+	}
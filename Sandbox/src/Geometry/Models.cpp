@@ -1,6 +1,6 @@
 #include "Models.h"
 
-namespace App 
+namespace App
 {
 
 	template<typename T>
@@ -25,17 +25,10 @@ namespace App
 		return (a * z + b) / (c * z + d);
 	}
 
-	Mobius Mobius::PoincareToUHS() {
-		float t = sqrt(2.0f)/2.0f;
-		return Mobius({t, 0}, {0, t}, {0, t}, {t, 0});
-	}
-
-	Mobius Mobius::UHSToPoincare() {
-		return Mobius::PoincareToUHS().inverse();
-	}
-
+	// glm::length, not ours: that's the Lorentzian one, which this used to get by mistake.
 	glm::vec3 cartesianToSpherical(glm::vec3 v) {
-		return { length(v), acos( v.z / length(v) ), atan2(v.y, v.x) };
+		const float r = glm::length(v);
+		return { r, acos( v.z / r ), atan2(v.y, v.x) };
 	}
 
 	glm::vec3 sphericalToCartesian(glm::vec3 v) {
@@ -43,14 +36,28 @@ namespace App
 	}
 
 	glm::vec3 transformHelper(glm::vec3 v, Mobius m) {
-		auto spherical = cartesianToSpherical(v);
-		auto c1 = std::polar(spherical.x, PI / 2 - spherical.y);
-		auto c2 = m * c1;
-		auto s2 = glm::vec3(abs(c2), PI / 2 - arg(c2), spherical.z);
-		return sphericalToCartesian(s2);
-	}
-
-	glm::vec3 UHSToPoincare(glm::vec3 vUHS) {
-		return transformHelper(vUHS, Mobius::UHSToPoincare());
+		// No angles needed: the point is rho + iz in its half plane, and the map doesn't change
+		// which half plane that is.
+		const float rho = std::sqrt(v.x * v.x + v.y * v.y);
+		const std::complex<float> c2 = m * std::complex<float>(rho, v.z);
+		const glm::vec2 horizontal = rho == 0 ? glm::vec2(1.0f, 0.0f) : glm::vec2(v.x, v.y) / rho;
+		return { horizontal * c2.real(), c2.imag() };
+	}
+
+	glm::vec4 kleinPlaneFromUHSCircle(glm::vec2 centre, float radius) {
+		// UHSToPoincare takes the boundary point v to X = (2v, |v|^2 - 1) / (|v|^2 + 1), and
+		// substituting that into |v|^2 - 2 centre.v + k = 0 (k = |centre|^2 - radius^2) leaves
+		// -2 centre.X_xy + (1 - k) X_z = -(1 + k). The sign is the one three points round the circle,
+		// anticlockwise, gave the cross product that used to find it.
+		const float k = glm::dot(centre, centre) - radius * radius;
+		const glm::vec3 normal(2.0f * centre, k - 1.0f);
+		const float inverseLength = 1.0f / glm::length(normal);
+		return glm::vec4(normal * inverseLength, (1.0f + k) * inverseLength);
+	}
+
+	glm::vec4 kleinPlaneFromUHSLine(glm::vec2 normal, float offset) {
+		// The same, with normal.v = offset: normal.X_xy + offset X_z = offset.
+		const float inverseLength = 1.0f / std::sqrt(1.0f + offset * offset);
+		return glm::vec4(glm::vec3(normal, offset) * inverseLength, offset * inverseLength);
 	}
 }; // namespace App
@@ -5,12 +5,21 @@
 
 #include <complex>
 
-namespace App 
+/* Conversions between the models of H^3: the upper half space (UHS, z > 0), the Poincaré ball, the
+ * Klein ball and the hyperboloid (w > 0, lorentzDot(v, v) = -1).
+ *
+ * All of them are closed forms - a handful of multiplies, one divide, and a square root going out of
+ * Klein - with no trigonometry and no branches, so they're fine in loops. The UHS <-> Poincaré pair
+ * is the Cayley transform, the Möbius map z -> (z - i) / (1 - iz) turned about the vertical axis,
+ * which Mobius::UHSToPoincare() still has in its original form. For many points at once, see the
+ * *Batch versions in MathsBatch.h. */
+
+namespace App
 {
-	class Mobius 
+	class Mobius
 	{
 	public:
-		Mobius(std::complex<float> a, std::complex<float> b, std::complex<float> c, 
+		constexpr Mobius(std::complex<float> a, std::complex<float> b, std::complex<float> c,
 				std::complex<float> d) : a(a), b(b), c(c), d(d) {};
 
 		template<typename T>
@@ -23,13 +32,20 @@ namespace App
 		template<typename T>
 		T operator*(T z);
 
-		static Mobius PoincareToUHS();
+		// Both already normalized, and each the other's inverse.
+		static constexpr Mobius PoincareToUHS() {
+			return Mobius({ sHalfSqrt2, 0 }, { 0, sHalfSqrt2 }, { 0, sHalfSqrt2 }, { sHalfSqrt2, 0 });
+		}
 
-		static Mobius UHSToPoincare();
+		static constexpr Mobius UHSToPoincare() {
+			return Mobius({ sHalfSqrt2, 0 }, { 0, -sHalfSqrt2 }, { 0, -sHalfSqrt2 }, { sHalfSqrt2, 0 });
+		}
 	private:
+		static constexpr float sHalfSqrt2 = 0.70710678118654752f;
+
 		std::complex<float> a;
 		std::complex<float> b;
-		std::complex<float> c; 
+		std::complex<float> c;
 		std::complex<float> d;
 	}; // class Mobius
 
@@ -37,7 +53,59 @@ namespace App
 
 	glm::vec3 sphericalToCartesian(glm::vec3 v);
 
+	// Applies m in every vertical half plane through the z axis (a point there being the complex
+	// number horizontal distance + i height), which is how a Möbius map of the UHS's boundary
+	// plane extends into the space above it.
 	glm::vec3 transformHelper(glm::vec3 v, Mobius m);
 
-	glm::vec3 UHSToPoincare(glm::vec3 vUHS);
+/**************************************************************************************************/
+/*** Closed forms ***/
+/**************************************************************************************************/
+
+	inline glm::vec3 UHSToPoincare(glm::vec3 vUHS) {
+		const float n = glm::dot(vUHS, vUHS);
+		const float inverseD = 1.0f / (n + 2.0f * vUHS.z + 1.0f); // x^2 + y^2 + (1 + z)^2
+		return glm::vec3(2.0f * vUHS.x, 2.0f * vUHS.y, n - 1.0f) * inverseD;
+	}
+
+	inline glm::vec3 poincareToUHS(glm::vec3 vPoincare) {
+		const float n = glm::dot(vPoincare, vPoincare);
+		const float inverseD = 1.0f / (n - 2.0f * vPoincare.z + 1.0f); // x^2 + y^2 + (1 - z)^2
+		return glm::vec3(2.0f * vPoincare.x, 2.0f * vPoincare.y, 1.0f - n) * inverseD;
+	}
+
+	inline glm::vec3 poincareToKlein(glm::vec3 vPoincare) {
+		return vPoincare * (2.0f / (1.0f + glm::dot(vPoincare, vPoincare)));
+	}
+
+	inline glm::vec3 kleinToPoincare(glm::vec3 vKlein) {
+		return vKlein * (1.0f / (1.0f + std::sqrt(1.0f - glm::dot(vKlein, vKlein))));
+	}
+
+	inline glm::vec4 poincareToHyperboloid(glm::vec3 vPoincare) {
+		const float n = glm::dot(vPoincare, vPoincare);
+		return glm::vec4(2.0f * vPoincare, 1.0f + n) * (1.0f / (1.0f - n));
+	}
+
+	inline glm::vec3 hyperboloidToPoincare(glm::vec4 vHyperboloid) {
+		return glm::vec3(vHyperboloid) * (1.0f / (1.0f + vHyperboloid.w));
+	}
+
+	inline glm::vec3 hyperboloidToKlein(glm::vec4 vHyperboloid) {
+		return glm::vec3(vHyperboloid) * (1.0f / vHyperboloid.w);
+	}
+
+	inline glm::vec4 kleinToHyperboloid(glm::vec3 vKlein) {
+		return glm::vec4(vKlein, 1.0f) * (1.0f / std::sqrt(1.0f - glm::dot(vKlein, vKlein)));
+	}
+
+	inline glm::vec3 UHSToKlein(glm::vec3 vUHS) { return poincareToKlein(UHSToPoincare(vUHS)); }
+	inline glm::vec3 kleinToUHS(glm::vec3 vKlein) { return poincareToUHS(kleinToPoincare(vKlein)); }
+
+	// The Klein plane (normal, offset: dot(normal, p) = offset) through the ideal points of the
+	// geodesic plane over the circle |v - centre| = radius in the UHS's boundary (z = 0). Those
+	// points go to a circle on the sphere at infinity, and the plane is the one it lies in.
+	glm::vec4 kleinPlaneFromUHSCircle(glm::vec2 centre, float radius);
+	// The same, for the vertical plane over the line dot(normal, v) = offset, normal a unit vector.
+	glm::vec4 kleinPlaneFromUHSLine(glm::vec2 normal, float offset);
 }; // namespace App
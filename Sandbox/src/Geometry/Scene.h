@@ -10,7 +10,8 @@ namespace App
 
 	inline void addPointLightObj(Geometry::V g, int i, glm::vec3 pos, glm::vec4 colorInt,
 			Aulys::Ref<std::array<glm::vec4, 4>> lightPositions, Aulys::Ref<std::array<glm::vec4, 5>>& lightIntensities) {
-		(*lightPositions)[i] = constructPointInGeometry(g, direction(pos), length(pos));
+		// pos is Euclidean, in the tangent space at the origin: App::length would take its z for time.
+		(*lightPositions)[i] = constructPointInGeometry(g, pos, glm::length(pos));
 		(*lightIntensities)[i] = colorInt;
 	}
 
@@ -153,27 +153,16 @@ namespace App
 		return {start, mid, end};
 	}
 
-	auto kleinFromUHS(Sphere f) {
-		std::array<glm::vec3, 3> idealPoints;
+	glm::vec4 kleinFromUHS(Sphere f) {
 		if (f.radius == std::numeric_limits<float>::infinity() ) {
 			if(f.offset < pow(10, -7)) {
 				return glm::vec4( f.normal, 0.0f );
 			}
-			idealPoints = planePoints(f);
+			// The line is the one planePoints(f) goes along: f.normal isn't always a unit vector.
+			const float normalLength = glm::length(f.normal);
+			return kleinPlaneFromUHSLine(glm::vec2(f.normal) / normalLength, f.offset * normalLength);
 		}
-		else {
-			idealPoints = circlePoints(f.center, f.radius);
-		}
-
-		Sphere plane;
-		
-		plane.setPlaneFromPoints(
-			UHSToPoincare( idealPoints[0] ),
-			UHSToPoincare( idealPoints[1] ),
-			UHSToPoincare( idealPoints[2] )
-		);
-
-		return glm::vec4(plane.normal.x, plane.normal.y, plane.normal.z, plane.offset);
+		return kleinPlaneFromUHSCircle(glm::vec2(f.center), f.radius);
 	}
 
 	std::array<glm::vec4, 4> simplexFacetsKlein(uint32_t p, uint32_t q, uint32_t r) {
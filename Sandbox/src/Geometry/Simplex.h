@@ -70,7 +70,8 @@ namespace App
 
 	std::array<glm::vec3, 3> planePoints(Sphere f);
 
-	auto kleinFromUHS(Sphere f);
+	// The Klein plane through f's ideal points, f being a hemisphere or vertical plane of the UHS.
+	glm::vec4 kleinFromUHS(Sphere f);
 
 	std::array<glm::vec4, 4> simplexFacetsKlein(uint32_t p, uint32_t q, uint32_t r);
 
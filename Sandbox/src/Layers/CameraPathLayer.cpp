@@ -0,0 +1,633 @@
+#include "CameraPathLayer.h"
+
+#include "Events/Event.h"
+#include "Events/KeyEvent.h"
+
+#include "imgui/imgui.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace App
+{
+	namespace
+	{
+		// The nearest-rank percentile of an already sorted list.
+		float percentile(const std::vector<float>& sorted, float p) {
+			const size_t rank = (size_t)std::ceil(p / 100.0f * sorted.size());
+			return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+		}
+
+		// {"mean": ..., "median": ..., ...} of the values that aren't negative (not reported).
+		void writeSummary(std::ostream& out, std::vector<float> values) {
+			values.erase(std::remove_if(values.begin(), values.end(), [](float v) { return v < 0.0f; }),
+			             values.end());
+			if (values.empty()) {
+				out << "null";
+				return;
+			}
+			std::sort(values.begin(), values.end());
+			double sum = 0.0;
+			for (float v : values) {
+				sum += v;
+			}
+			out << "{ \"count\": " << values.size() << ", \"mean\": " << sum / values.size()
+			    << ", \"median\": " << percentile(values, 50.0f) << ", \"p90\": " << percentile(values, 90.0f)
+			    << ", \"p95\": " << percentile(values, 95.0f) << ", \"p99\": " << percentile(values, 99.0f)
+			    << ", \"min\": " << values.front() << ", \"max\": " << values.back() << " }";
+		}
+
+		void writeList(std::ostream& out, const std::vector<float>& values) {
+			out << "[";
+			for (size_t i = 0; i < values.size(); i++) {
+				out << (i == 0 ? "" : ", ");
+				if (values[i] < 0.0f) {
+					out << "null";
+				}
+				else {
+					out << values[i];
+				}
+			}
+			out << "]";
+		}
+
+		std::string defaultReportFile(const std::string& pathFile) {
+			return "bench/" + std::filesystem::path(pathFile).stem().string() + ".json";
+		}
+	}; // namespace
+
+	void CameraPathLayer::onAttach() {
+		Application::get().getFramePacer().setFrameListener([this](const FrameTimes& times) {
+			if (times.frame < mFirstTimedFrame || times.frame - mFirstTimedFrame >= mTimedFrames.size()) {
+				return;
+			}
+			TimedFrame& frame = mTimedFrames[times.frame - mFirstTimedFrame];
+			frame.cpuMs = times.cpuMs;
+			frame.gpuMs = times.gpuMs;
+		});
+	}
+
+	void CameraPathLayer::onDetach() {
+		Application::get().getFramePacer().setFrameListener(nullptr);
+	}
+
+	bool CameraPathLayer::play(const std::string& pathFile, const std::string& reportFile, bool closeWhenDone) {
+		if (mMode == Mode::Recording || !mPath.load(pathFile)) {
+			return false;
+		}
+		mPathFile = pathFile;
+		mReportFile = reportFile.empty() ? defaultReportFile(pathFile) : reportFile;
+		mCloseWhenDone = closeWhenDone;
+		mMode = Mode::Starting;
+		LOG_INFO("Playing camera path \"{0}\" ({1:.2f}s at {2}ms a frame), the report goes to \"{3}\".",
+			pathFile, mPath.length(), mPath.stepMs, mReportFile);
+		return true;
+	}
+
+	void CameraPathLayer::onUpdate(Timestep ts) {
+		auto& app = Application::get();
+
+		if (mMode == Mode::Starting) {
+			applySettings(mPath);
+			resetCamera();
+			mPreviousFixedStep = app.getFixedTimestep();
+			app.setFixedTimestep(Timestep(mPath.stepMs / 1000.0f));
+
+			// The warmup frames go first, with the camera still, then the path - one step a frame.
+			mPathStartStep = app.getFixedStepCount() + mPath.warmup;
+			mFirstTimedFrame = mFrame + 1 + mPath.warmup;
+			// One for every step from time 0 to the end, both included. A length written down to
+			// a few digits shouldn't lose the last step to rounding.
+			const size_t steps = (size_t)std::floor(mPath.length() * 1000.0 / mPath.stepMs + 1e-3);
+			mTimedFrames.assign(steps + 1, TimedFrame());
+			mNextKeyframe = 0;
+
+			// Before the warmup, so the recompile isn't in any timed frame.
+			mCounting = mPath.instrument || mInstrumentInput;
+			if (mCounting) {
+				MarchStatsRequestedEvent e(true);
+				app.onEvent(e);
+				mStopMarchStats = !e.wasEnabled;
+			}
+			mHeldKeys.clear();
+			mMode = Mode::Playing;
+		}
+
+		if (mMode == Mode::Playing) {
+			// Our onUpdate comes after SceneLayer's onFixedUpdate, so whatever's due by the next
+			// step goes in now, before the next frame takes it.
+			const uint64_t nextStep = app.getFixedStepCount();
+			if (nextStep >= mPathStartStep) {
+				const double stepSeconds = mPath.stepMs / 1000.0;
+				const double time = (nextStep - mPathStartStep) * stepSeconds;
+				while (mNextKeyframe < mPath.keyframes.size()
+				       && mPath.keyframes[mNextKeyframe].time < time + 0.5 * stepSeconds) {
+					applyKeyframe(mPath.keyframes[mNextKeyframe++]);
+				}
+			}
+
+			// The GPU times (and counts) come in a few frames late, so keep going until they have.
+			const uint64_t lastTimedFrame = mFirstTimedFrame + mTimedFrames.size() - 1;
+			if (mFrame > lastTimedFrame) {
+				const bool allReported = std::all_of(mTimedFrames.begin(), mTimedFrames.end(),
+					[this](const TimedFrame& frame) { return frame.gpuMs >= 0.0f && (frame.counted || !mCounting); });
+				if (allReported || mFrame > lastTimedFrame + sReportFramesLate) {
+					finishPlaying();
+				}
+			}
+		}
+
+		mFrame++;
+	}
+
+	void CameraPathLayer::finishPlaying() {
+		auto& app = Application::get();
+
+		// So the camera doesn't carry on flying.
+		for (int keycode : mHeldKeys) {
+			KeyReleasedEvent e(keycode);
+			app.onEvent(e);
+		}
+		mHeldKeys.clear();
+		app.setFixedTimestep(mPreviousFixedStep);
+		mFirstTimedFrame = UINT64_MAX;
+		mMode = Mode::Idle;
+		if (mStopMarchStats) {
+			MarchStatsRequestedEvent e(false);
+			app.onEvent(e);
+			mStopMarchStats = false;
+		}
+
+		if (writeReport()) {
+			LOG_INFO("Camera path \"{0}\" done, wrote \"{1}\".", mPathFile, mReportFile);
+		}
+		if (mCloseWhenDone) {
+			WindowCloseEvent e;
+			app.onEvent(e);
+		}
+	}
+
+	bool CameraPathLayer::writeReport() const {
+		const std::filesystem::path reportPath(mReportFile);
+		if (reportPath.has_parent_path()) {
+			std::filesystem::create_directories(reportPath.parent_path());
+		}
+		std::ofstream file(reportPath, std::ios::trunc);
+		if (!file) {
+			LOG_ERROR("[CameraPathLayer::writeReport] Couldn't open \"{0}\".", mReportFile);
+			return false;
+		}
+
+		std::vector<float> cpuMs, gpuMs;
+		for (const TimedFrame& frame : mTimedFrames) {
+			cpuMs.push_back(frame.cpuMs);
+			gpuMs.push_back(frame.gpuMs);
+		}
+
+		const Window& window = Application::get().getWindow();
+		file << "{\n";
+		file << "  \"path\": \"" << mPathFile << "\",\n";
+		file << "  \"honeycomb\": [" << mPath.pqr[0] << ", " << mPath.pqr[1] << ", " << mPath.pqr[2] << "],\n";
+		file << "  \"maxSteps\": " << mPath.maxSteps << ",\n";
+		file << "  \"maxDist\": " << mPath.maxDist << ",\n";
+		file << "  \"hitPixelFraction\": " << mPath.hitPixelFraction << ",\n";
+		file << "  \"hitEpsilonMin\": " << mPath.hitEpsilonMin << ",\n";
+		file << "  \"stepping\": \"" << (mPath.overRelax ? "relaxed" : "series") << "\",\n";
+		file << "  \"overRelaxation\": " << mPath.overRelaxation << ",\n";
+		file << "  \"fov\": " << mPath.fov << ",\n";
+		file << "  \"tubeRad\": " << mPath.tubeRad << ",\n";
+		file << "  \"lighting\": " << (mPath.lighting ? "true" : "false") << ",\n";
+		file << "  \"shadows\": \"" << shadowsName(mPath.shadows) << "\",\n";
+		file << "  \"shadowSteps\": [" << mPath.shadowStepBudgets[0] << ", " << mPath.shadowStepBudgets[1] << ", "
+		     << mPath.shadowStepBudgets[2] << ", " << mPath.shadowStepBudgets[3] << "],\n";
+		file << "  \"shadowCache\": " << (mPath.shadowCache ? "true" : "false") << ",\n";
+		file << "  \"halfResShadows\": " << (mPath.halfResShadows ? "true" : "false") << ",\n";
+		file << "  \"step_ms\": " << mPath.stepMs << ",\n";
+		file << "  \"warmup\": " << mPath.warmup << ",\n";
+		file << "  \"raymarcher\": \"" << (mPath.computeRaymarcher ? "compute" : "fragment") << "\",\n";
+		file << "  \"tags\": {";
+		for (size_t i = 0; i < mPath.tags.size(); i++) {
+			file << (i == 0 ? " " : ", ") << "\"" << mPath.tags[i].first << "\": \"" << mPath.tags[i].second << "\"";
+		}
+		file << (mPath.tags.empty() ? "},\n" : " },\n");
+		file << "  \"width\": " << window.getWidth() << ",\n";
+		file << "  \"height\": " << window.getHeight() << ",\n";
+		file << "  \"frames\": " << mTimedFrames.size() << ",\n";
+		file << "  \"cpu\": "; writeSummary(file, cpuMs); file << ",\n";
+		file << "  \"gpu\": "; writeSummary(file, gpuMs); file << ",\n";
+		file << "  \"cpu_ms\": "; writeList(file, cpuMs); file << ",\n";
+		file << "  \"gpu_ms\": "; writeList(file, gpuMs);
+		writeMarchCounts(file);
+		file << "\n}\n";
+		return (bool)file;
+	}
+
+	// The MarchCounts, if any came in: totals over the whole path, and per pixel, per frame. The
+	// frames that weren't counted are left out of the totals, and null in the lists.
+	void CameraPathLayer::writeMarchCounts(std::ostream& out) const {
+		MarchCounts total;
+		uint64_t counted = 0;
+		std::vector<float> steps, localSDFs, globalSDFs, shadowSteps, outOfSteps, backtracks;
+		for (const TimedFrame& frame : mTimedFrames) {
+			const MarchCounts& c = frame.march;
+			if (frame.counted) {
+				counted++;
+				total.steps += c.steps;
+				total.localSDFs += c.localSDFs;
+				total.globalSDFs += c.globalSDFs;
+				total.shadowSteps += c.shadowSteps;
+				total.outOfSteps += c.outOfSteps;
+				total.pixels += c.pixels;
+				total.backtracks += c.backtracks;
+				for (uint32_t light = 0; light < MarchCounts::sLights; light++) {
+					total.lightShadowSteps[light] += c.lightShadowSteps[light];
+					total.shadowMarches[light] += c.shadowMarches[light];
+					total.shadowReuses[light] += c.shadowReuses[light];
+				}
+			}
+			steps.push_back(frame.counted ? c.perPixel(c.steps) : -1.0f);
+			localSDFs.push_back(frame.counted ? c.perPixel(c.localSDFs) : -1.0f);
+			globalSDFs.push_back(frame.counted ? c.perPixel(c.globalSDFs) : -1.0f);
+			shadowSteps.push_back(frame.counted ? c.perPixel(c.shadowSteps) : -1.0f);
+			outOfSteps.push_back(frame.counted ? c.perPixel(c.outOfSteps) : -1.0f);
+			backtracks.push_back(frame.counted ? c.perPixel(c.backtracks) : -1.0f);
+		}
+		if (counted == 0) {
+			return;
+		}
+
+		out << ",\n";
+		out << "  \"march_frames\": " << counted << ",\n";
+		out << "  \"march_totals\": { \"steps\": " << total.steps << ", \"local_sdf\": " << total.localSDFs
+		    << ", \"global_sdf\": " << total.globalSDFs << ", \"shadow_steps\": " << total.shadowSteps
+		    << ", \"out_of_steps_pixels\": " << total.outOfSteps << ", \"pixels\": " << total.pixels
+		    << ", \"backtracks\": " << total.backtracks << " },\n";
+		out << "  \"steps_per_pixel\": "; writeSummary(out, steps); out << ",\n";
+		out << "  \"local_sdf_per_pixel\": "; writeSummary(out, localSDFs); out << ",\n";
+		out << "  \"global_sdf_per_pixel\": "; writeSummary(out, globalSDFs); out << ",\n";
+		out << "  \"shadow_steps_per_pixel\": "; writeSummary(out, shadowSteps); out << ",\n";
+		out << "  \"out_of_steps_fraction\": "; writeSummary(out, outOfSteps); out << ",\n";
+		out << "  \"backtracks_per_pixel\": "; writeSummary(out, backtracks); out << ",\n";
+		// What each light's shadows cost, over every counted frame.
+		out << "  \"shadow_lights\": [";
+		for (uint32_t light = 0; light < MarchCounts::sLights; light++) {
+			out << (light == 0 ? "\n" : ",\n") << "    { \"shadow_steps\": " << total.lightShadowSteps[light]
+			    << ", \"shadow_steps_per_pixel\": " << total.perPixel(total.lightShadowSteps[light])
+			    << ", \"marches\": " << total.shadowMarches[light]
+			    << ", \"reuses\": " << total.shadowReuses[light] << " }";
+		}
+		out << "\n  ],\n";
+		out << "  \"steps_per_pixel_by_frame\": "; writeList(out, steps);
+	}
+
+	void CameraPathLayer::applySettings(const CameraPath& path) const {
+		auto& app = Application::get();
+		CameraPath settings = path;
+		// Before the honeycomb, whose uniforms depend on it.
+		{
+			TubeRadiusChangedEvent e("tubeRad", &settings.tubeRad); app.onEvent(e);
+		}
+		{
+			GeometryChangedEvent e(settings.pqr); app.onEvent(e);
+		}
+		{
+			MaxStepsChangedEvent e("maxSteps", &settings.maxSteps); app.onEvent(e);
+		}
+		{
+			MaxDistChangedEvent e("maxDist", &settings.maxDist); app.onEvent(e);
+		}
+		{
+			HitPixelFractionChangedEvent e("hitPixelFraction", &settings.hitPixelFraction); app.onEvent(e);
+		}
+		{
+			HitEpsilonMinChangedEvent e("hitEpsilonMin", &settings.hitEpsilonMin); app.onEvent(e);
+		}
+		{
+			UseOverRelaxationChangedEvent e("useOverRelaxation", &settings.overRelax); app.onEvent(e);
+		}
+		{
+			OverRelaxationChangedEvent e("overRelaxation", &settings.overRelaxation); app.onEvent(e);
+		}
+		{
+			FOVChangedEvent e("fov", &settings.fov); app.onEvent(e);
+		}
+		{
+			UseLightingChangedEvent e("useLighting", &settings.lighting); app.onEvent(e);
+		}
+		// After the honeycomb, as UIOverlay sends its own shadow settings again when that changes.
+		{
+			RenderShadsChangedEvent e("renderShadows", &settings.shadows); app.onEvent(e);
+		}
+		{
+			ShadowStepBudgetsChangedEvent e("shadowStepBudgets", &settings.shadowStepBudgets); app.onEvent(e);
+		}
+		{
+			UseShadowCacheChangedEvent e("useShadowCache", &settings.shadowCache); app.onEvent(e);
+		}
+		{
+			HalfResShadowsChangedEvent e("halfResShadows", &settings.halfResShadows); app.onEvent(e);
+		}
+		// These recompile the shader, which is why they're before the warmup.
+		for (const auto& [tag, file] : settings.tags) {
+			const std::string value = "\"" + file + "\"";
+			TagSwapRequestedEvent e(tag, value); app.onEvent(e);
+		}
+		{
+			ComputeRaymarcherRequestedEvent e(settings.computeRaymarcher); app.onEvent(e);
+		}
+	}
+
+	// As "Reset Position" does it.
+	void CameraPathLayer::resetCamera() const {
+		auto& app = Application::get();
+		const glm::mat4 identity{ 1.0f };
+		{
+			CellBoostChangedEvent e(&identity); app.onEvent(e);
+		}
+		{
+			invCellBoostChangedEvent e(&identity); app.onEvent(e);
+		}
+		{
+			CurrentBoostChangedEvent e(&identity); app.onEvent(e);
+		}
+	}
+
+	void CameraPathLayer::applyKeyframe(const CameraKeyframe& keyframe) {
+		auto& app = Application::get();
+		if (keyframe.kind == CameraKeyframe::Kind::Boost) {
+			const glm::mat4 invCellBoost = glm::inverse(keyframe.cellBoost);
+			{
+				CellBoostChangedEvent e(&keyframe.cellBoost); app.onEvent(e);
+			}
+			{
+				invCellBoostChangedEvent e(&invCellBoost); app.onEvent(e);
+			}
+			{
+				CurrentBoostChangedEvent e(&keyframe.currentBoost); app.onEvent(e);
+			}
+			return;
+		}
+
+		auto held = std::find(mHeldKeys.begin(), mHeldKeys.end(), keyframe.keycode);
+		if (keyframe.pressed) {
+			if (held == mHeldKeys.end()) {
+				mHeldKeys.push_back(keyframe.keycode);
+			}
+			KeyPressedEvent e(keyframe.keycode, 0);
+			app.onEvent(e);
+		}
+		else {
+			if (held != mHeldKeys.end()) {
+				mHeldKeys.erase(held);
+			}
+			KeyReleasedEvent e(keyframe.keycode);
+			app.onEvent(e);
+		}
+	}
+
+	void CameraPathLayer::startRecording() {
+		if (mMode != Mode::Idle) {
+			return;
+		}
+		auto& app = Application::get();
+		resetCamera();
+		mPath = mCurrentSettings;
+		mPath.keyframes.clear();
+		mPath.duration = 0.0;
+		mPath.stepMs = app.getFixedTimestep().getMilliSeconds();
+		mRecordStartStep = app.getFixedStepCount();
+		mMode = Mode::Recording;
+	}
+
+	void CameraPathLayer::stopRecording(const std::string& pathFile) {
+		if (mMode != Mode::Recording) {
+			return;
+		}
+		mMode = Mode::Idle;
+		mPath.duration = (Application::get().getFixedStepCount() - mRecordStartStep) * (mPath.stepMs / 1000.0);
+
+		const std::filesystem::path path(pathFile);
+		if (path.has_parent_path()) {
+			std::filesystem::create_directories(path.parent_path());
+		}
+		if (mPath.save(pathFile)) {
+			LOG_INFO("Recorded {0} keyframes over {1:.2f}s into \"{2}\".", mPath.keyframes.size(),
+				mPath.duration, pathFile);
+		}
+	}
+
+	void CameraPathLayer::onImGuiRender(Timestep ts) {
+		ImGui::Begin("Camera path");
+			ImGui::InputText("File", mPathFileInput.data(), mPathFileInput.size());
+			const std::string pathFile(mPathFileInput.data());
+			switch (mMode) {
+			case Mode::Idle:
+				if (ImGui::Button("Play")) {
+					play(pathFile, defaultReportFile(pathFile));
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Record")) {
+					startRecording();
+				}
+				ImGui::Checkbox("Count raymarch work", &mInstrumentInput);
+				break;
+			case Mode::Recording:
+				ImGui::Text("Recording, %zu keyframes", mPath.keyframes.size());
+				ImGui::SameLine();
+				if (ImGui::Button("Stop and save")) {
+					stopRecording(pathFile);
+				}
+				break;
+			case Mode::Starting:
+			case Mode::Playing:
+				if (mFrame < mFirstTimedFrame) {
+					ImGui::Text("Warming up");
+				}
+				else {
+					ImGui::Text("Playing, frame %llu of %zu", (unsigned long long)(mFrame - mFirstTimedFrame),
+						mTimedFrames.size());
+				}
+				break;
+			}
+		ImGui::End();
+	}
+
+	void CameraPathLayer::onEvent(Event& event) {
+		EventDispatcher disp(event);
+
+		// None of these are handled here, SceneLayer (underneath) needs them too.
+		disp.dispatch<GeometryChangedEvent>(
+			[this](GeometryChangedEvent& e) {
+				this->mCurrentSettings.pqr = e.pqr;
+				return false;
+			}
+		);
+
+		disp.dispatch<MaxStepsChangedEvent>(
+			[this](MaxStepsChangedEvent& e) {
+				this->mCurrentSettings.maxSteps = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<MaxDistChangedEvent>(
+			[this](MaxDistChangedEvent& e) {
+				this->mCurrentSettings.maxDist = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<HitPixelFractionChangedEvent>(
+			[this](HitPixelFractionChangedEvent& e) {
+				this->mCurrentSettings.hitPixelFraction = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<HitEpsilonMinChangedEvent>(
+			[this](HitEpsilonMinChangedEvent& e) {
+				this->mCurrentSettings.hitEpsilonMin = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<UseOverRelaxationChangedEvent>(
+			[this](UseOverRelaxationChangedEvent& e) {
+				this->mCurrentSettings.overRelax = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<OverRelaxationChangedEvent>(
+			[this](OverRelaxationChangedEvent& e) {
+				this->mCurrentSettings.overRelaxation = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<FOVChangedEvent>(
+			[this](FOVChangedEvent& e) {
+				this->mCurrentSettings.fov = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<TubeRadiusChangedEvent>(
+			[this](TubeRadiusChangedEvent& e) {
+				this->mCurrentSettings.tubeRad = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<UseLightingChangedEvent>(
+			[this](UseLightingChangedEvent& e) {
+				this->mCurrentSettings.lighting = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<RenderShadsChangedEvent>(
+			[this](RenderShadsChangedEvent& e) {
+				this->mCurrentSettings.shadows = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<ShadowStepBudgetsChangedEvent>(
+			[this](ShadowStepBudgetsChangedEvent& e) {
+				this->mCurrentSettings.shadowStepBudgets = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<UseShadowCacheChangedEvent>(
+			[this](UseShadowCacheChangedEvent& e) {
+				this->mCurrentSettings.shadowCache = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<HalfResShadowsChangedEvent>(
+			[this](HalfResShadowsChangedEvent& e) {
+				this->mCurrentSettings.halfResShadows = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<MarchStatsRequestedEvent>(
+			[this](MarchStatsRequestedEvent& e) {
+				this->mCurrentSettings.instrument = e.enabled;
+				return false;
+			}
+		);
+
+		disp.dispatch<ComputeRaymarcherRequestedEvent>(
+			[this](ComputeRaymarcherRequestedEvent& e) {
+				this->mCurrentSettings.computeRaymarcher = e.enabled;
+				return false;
+			}
+		);
+
+		disp.dispatch<TagSwapRequestedEvent>(
+			[this](TagSwapRequestedEvent& e) {
+				// Paths keep the file without the quotes the tag's value has.
+				std::string file = e.val;
+				if (file.size() >= 2 && file.front() == '"' && file.back() == '"') {
+					file = file.substr(1, file.size() - 2);
+				}
+				auto& tags = this->mCurrentSettings.tags;
+				auto it = std::find_if(tags.begin(), tags.end(), [&](const auto& t) { return t.first == e.tag; });
+				if (it == tags.end()) {
+					tags.emplace_back(e.tag, file);
+				}
+				else {
+					it->second = file;
+				}
+				return false;
+			}
+		);
+
+		disp.dispatch<MarchCountsReadyEvent>(
+			[this](MarchCountsReadyEvent& e) {
+				const uint64_t frame = e.counts.frame;
+				if (frame < mFirstTimedFrame || frame - mFirstTimedFrame >= mTimedFrames.size()) {
+					return false;
+				}
+				TimedFrame& timed = mTimedFrames[frame - mFirstTimedFrame];
+				timed.march = e.counts;
+				timed.counted = true;
+				return false;
+			}
+		);
+
+		disp.dispatch<KeyPressedEvent>(
+			[this](KeyPressedEvent& e) {
+				if (this->mMode != Mode::Recording || e.getRepeatCount() || keyName(e.getKeyCode()) == nullptr) {
+					return false;
+				}
+				CameraKeyframe keyframe;
+				keyframe.time = (Application::get().getFixedStepCount() - mRecordStartStep) * (mPath.stepMs / 1000.0);
+				keyframe.keycode = e.getKeyCode();
+				keyframe.pressed = true;
+				this->mPath.keyframes.push_back(keyframe);
+				return false;
+			}
+		);
+
+		disp.dispatch<KeyReleasedEvent>(
+			[this](KeyReleasedEvent& e) {
+				if (this->mMode != Mode::Recording || keyName(e.getKeyCode()) == nullptr) {
+					return false;
+				}
+				CameraKeyframe keyframe;
+				keyframe.time = (Application::get().getFixedStepCount() - mRecordStartStep) * (mPath.stepMs / 1000.0);
+				keyframe.keycode = e.getKeyCode();
+				keyframe.pressed = false;
+				this->mPath.keyframes.push_back(keyframe);
+				return false;
+			}
+		);
+	}
+}; // namespace App
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Aulys.h"
+using namespace Aulys;
+
+#include "Benchmark/CameraPath.h"
+#include "Events/AppEvent.h"
+
+namespace App 
+{
+	/* Records camera paths, and plays them back as a benchmark.
+	 *
+	 * Playing a path sets the path's honeycomb and raymarch settings, puts the camera at the origin,
+	 * and then feeds in its keyframes at their times. While it plays, Sandbox::Run gives every frame
+	 * exactly one fixed step of the path's length, whatever the frame really took, so every run
+	 * renders exactly the same frames. Every frame's CPU and GPU time (see FramePacer::FrameTimes)
+	 * goes into a JSON report when it's done, with their percentiles. With `instrument 1` in the
+	 * path (or "Count raymarch work" ticked), the march stats are on while it plays, and each frame's
+	 * MarchCounts go in as well.
+	 *
+	 * Recording starts at the origin as well, and writes down the current settings and every
+	 * movement key pressed and released, by the fixed step it happened before.
+	 *
+	 * To run a benchmark without touching anything, set SANDBOX_CAMERA_PATH to the path's file: it
+	 * starts playing straight away and closes the app when done (add AULYS_HEADLESS=1 to not need a
+	 * display). The report goes to SANDBOX_CAMERA_PATH_OUT, or bench/<path name>.json. */
+	class CameraPathLayer : public Layer 
+	{
+	public:
+		CameraPathLayer(const std::string& name = "CameraPathLayer") : Layer(name) {};
+
+		virtual void onAttach() override;
+		virtual void onDetach() override;
+		virtual void onUpdate(Timestep ts) override;
+		virtual void onImGuiRender(Timestep ts) override;
+		virtual void onEvent(Event& event) override;
+
+		// Whether frames should be given exactly one fixed step each (see Sandbox::Run).
+		inline bool isPlaying() const { return mMode == Mode::Playing; };
+
+		// Starts playing at the next frame. Returns false if the file couldn't be loaded.
+		bool play(const std::string& pathFile, const std::string& reportFile, bool closeWhenDone = false);
+		void startRecording();
+		// Saves what's been recorded to pathFile.
+		void stopRecording(const std::string& pathFile);
+
+	private:
+		enum class Mode { Idle, Starting, Playing, Recording };
+
+		struct TimedFrame
+		{
+			float cpuMs = -1.0f; // -1 until the FramePacer reports the frame.
+			float gpuMs = -1.0f;
+			bool counted = false; // Whether march has come in (see MarchCountsReadyEvent).
+			MarchCounts march;
+		}; // struct TimedFrame
+
+		// Everything through events, the same ones the UI sends.
+		void applySettings(const CameraPath& path) const;
+		void resetCamera() const;
+		void applyKeyframe(const CameraKeyframe& keyframe);
+		void finishPlaying();
+		bool writeReport() const;
+		void writeMarchCounts(std::ostream& out) const;
+
+		Mode mMode = Mode::Idle;
+		CameraPath mPath;
+		// The frame being rendered, counted the same way as the FramePacer's.
+		uint64_t mFrame = 0;
+		// How long after the last timed frame we wait for the GPU times to come in.
+		static constexpr uint64_t sReportFramesLate = 16;
+
+		/* Playing */
+		std::string mPathFile, mReportFile;
+		bool mCloseWhenDone = false;
+		bool mCounting = false; // Are we waiting for MarchCounts as well as the times?
+		bool mStopMarchStats = false; // We turned them on, so they go off again at the end.
+		Timestep mPreviousFixedStep;
+		uint64_t mPathStartStep = 0; // The fixed step the path's time 0 is at.
+		uint64_t mFirstTimedFrame = UINT64_MAX; // The frame that renders the path's first step.
+		size_t mNextKeyframe = 0;
+		std::vector<int> mHeldKeys{}; // Pressed by the path, to be let go of when it ends.
+		std::vector<TimedFrame> mTimedFrames{};
+
+		/* Recording */
+		uint64_t mRecordStartStep = 0;
+		// The settings to write into the recorded path, kept up to date from the events that change
+		// them. This layer goes on after SceneLayer has sent its defaults, which are these.
+		CameraPath mCurrentSettings;
+
+		std::array<char, 256> mPathFileInput{ "Sandbox/assets/paths/flythrough.path" };
+		bool mInstrumentInput = false; // Counts the raymarch work, whatever the path says.
+	}; // class CameraPathLayer : public Layer
+}; // namespace App
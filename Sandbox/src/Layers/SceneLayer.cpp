@@ -39,6 +39,11 @@ namespace App
 		// so we don't bother holding onto it ourselves, hence why we create both the IB and VB
 		// just in this init function, wo/ making them members. Yay for good design.
 
+		// Everything that depends on the honeycomb lives in one uniform block, written all at once
+		// when it changes (see the HoneycombChangedEvent handler).
+		this->mHoneycombBuffer = UniformBuffer::create(sizeof(HoneycombUniforms), sHoneycombBinding);
+		mShaderProgram->setUniformBlockBinding("Honeycomb", sHoneycombBinding);
+
 		// Upload default set of uniforms.
 		mShaderProgram->bind();
 
@@ -68,10 +73,42 @@ namespace App
 			float maxDistDefault = 6.4f;
 			MaxDistChangedEvent e(&maxDistDefault); app.onEvent(e);
 		}
+		{
+			float hitPixelFractionDefault = 0.5f;
+			HitPixelFractionChangedEvent e(&hitPixelFractionDefault); app.onEvent(e);
+		}
+		{
+			float hitEpsilonMinDefault = 0.0001f; // What EPSILON was.
+			HitEpsilonMinChangedEvent e(&hitEpsilonMinDefault); app.onEvent(e);
+		}
+		{
+			bool useOverRelaxationDefault = false;
+			UseOverRelaxationChangedEvent e(&useOverRelaxationDefault); app.onEvent(e);
+		}
+		{
+			float overRelaxationDefault = 1.3f;
+			OverRelaxationChangedEvent e(&overRelaxationDefault); app.onEvent(e);
+		}
 		{
 			int attnModelDefault = 1;
 			AttenuationChangedEvent e(&attnModelDefault); app.onEvent(e);
 		}
+		{
+			bool useLightingDefault = true;
+			UseLightingChangedEvent e(&useLightingDefault); app.onEvent(e);
+		}
+		{
+			std::array<int, 4> shadowStepBudgetsDefault = { 32, 32, 32, 32 };
+			ShadowStepBudgetsChangedEvent e(&shadowStepBudgetsDefault); app.onEvent(e);
+		}
+		{
+			bool useShadowCacheDefault = true;
+			UseShadowCacheChangedEvent e(&useShadowCacheDefault); app.onEvent(e);
+		}
+		{
+			bool halfResShadowsDefault = false;
+			HalfResShadowsChangedEvent e(&halfResShadowsDefault); app.onEvent(e);
+		}
 		/* Scene Geometry */
 		{
 			float tubeRadDefault = 0.15f;
@@ -100,9 +137,17 @@ namespace App
 			this->mTexture = Texture2D::create(Path("Sandbox/assets/textures/brick.png"));
 			TextureChangedEvent e(mTexture.get()); app.onEvent(e);
 		}
+		// The baked SDF's sampler gets its own slot, used or not: a sampler2D and a sampler3D
+		// left on the same one (both default to 0) is an error, and some drivers don't survive it.
+		mShaderProgram->uploadUniformInt("bakedSDF", sBakedSDFSlot);
+		// And the shadow history's is an unsigned one, so that's a third.
+		mShaderProgram->uploadUniformInt("shadowHistory", sShadowHistorySlot);
 
 		mFrameBuffer->bind();
 		mFrameBuffer->attachTexture(mFrameBufferTexture);
+		// onUpdate binds it for each draw. The compute raymarcher doesn't draw, so it mustn't be left
+		// bound for the UI to draw into.
+		mFrameBuffer->unbind();
 
 		RequestUpdateUniformsFromUIEvent e;
 		app.onEvent(e);
@@ -115,10 +160,51 @@ namespace App
 	void SceneLayer::onDetach() { }
 
 	void SceneLayer::onUpdate(Timestep ts) {
+		// The simulation runs at its own rate (see onFixedUpdate), so what we draw is somewhere in
+		// between its last two states. Blending the matrices takes them off the hyperboloid a little,
+		// gramSchmidt puts them back - over one fixed step that's indistinguishable from the geodesic.
+		const float alpha = Application::get().getFixedAlpha();
+		const glm::mat4 renderBoost = mPrevBoost == currentBoost ?
+			currentBoost : gramSchmidt(g, mPrevBoost + alpha * (currentBoost - mPrevBoost));
+		if (renderBoost != mRenderBoost) {
+			// Not through a CurrentBoostChangedEvent: its handler would take this as the new
+			// simulation state.
+			mRenderBoost = renderBoost;
+			mShaderProgram->bind();
+			mShaderProgram->uploadUniformMat4("currentBoost", mRenderBoost);
+		}
+
+		if (mLocalSDFVolume) {
+			updateBakedSDF();
+		}
+
+		if (mMarchCounters) {
+			mMarchCounters->beginFrame(Application::get().getFramePacer().getFrame());
+		}
+
+		if (mShadowHistory[0]) {
+			beginShadowHistory();
+		}
+
 		RenderCommand::clear();
 
 		Renderer::beginScene(mCamera);
-			if(*mFrameBuffer) {
+			if (mComputeProgram) {
+				mComputeProgram->copyUniformsFrom(*mShaderProgram);
+				mFrameBufferTexture->bindImage(0, Texture::Access::WriteOnly);
+				if (mMarchStats) {
+					// Where the quad's second colour attachment would be.
+					mMarchStats->getMarchTexture()->bindImage(2, Texture::Access::WriteOnly);
+				}
+				if (mShadowHistory[0]) {
+					// Likewise for the third.
+					mShadowHistory[mShadowHistoryWrite]->bindImage(sShadowHistoryImage, Texture::Access::WriteOnly);
+				}
+				RenderCommand::dispatchCompute(
+					(mFrameBufferTexture->getWidth() + sComputeTileSize - 1) / sComputeTileSize,
+					(mFrameBufferTexture->getHeight() + sComputeTileSize - 1) / sComputeTileSize);
+			}
+			else if(*mFrameBuffer) {
 				mFrameBuffer->bind();
 				Renderer::submit(mShaderProgram, mRenderQuadVA,
 						glm::scale(glm::mat4(1.0f), glm::vec3(mScale)));
@@ -127,6 +213,21 @@ namespace App
 			}
 		Renderer::endScene();
 
+		if (mShadowHistory[0]) {
+			endShadowHistory();
+		}
+
+		if (mMarchStats) {
+			mMarchCounters->endFrame();
+			mMarchStats->update(mMaxSteps, mMaxDist);
+		}
+	}
+
+	// Always called with the same ts, so the same key presses on the same steps end up in exactly
+	// the same place, whatever the frame rate was.
+	void SceneLayer::onFixedUpdate(Timestep ts) {
+		mPrevBoost = currentBoost;
+
 		float speed = Input::isKeyPressed(AU_KEY_LEFT_SHIFT) ? 2 * mSpeed : mSpeed;
 
 		// deltaPosState contains information about what keys are being pressed, to indicate where
@@ -136,35 +237,37 @@ namespace App
 		// Similar to the above.
 		auto deltaRot = deltaRotState * speed * ts.getMilliSeconds();
 
-		bool change = false; bool posChange = false;
 		if (deltaRot != glm::vec3{ 0.0f }) {
-			change = true;
 			glm::fquat deltaRotQ(1.0f, deltaRot.x * mRotSpeed * ts.getMilliSeconds(),
 				deltaRot.y * mRotSpeed * ts.getMilliSeconds(),
 				deltaRot.z * mRotSpeed * ts.getMilliSeconds());
-			currentBoost = glm::toMat4(deltaRotQ) * currentBoost;
+			mBoost = AnyIsometry::rotation(g, glm::normalize(deltaRotQ)) * mBoost;
 		}
 
 		if (deltaPos != glm::vec3{ 0.0f }) {
-			change = true;
-			posChange = true;
-			auto m = translateByVector(g, eToHScale * deltaPos);
-
-			currentBoost = gramSchmidt(g, m * currentBoost);
-			if (auto fixIndex = fixOutsideCentralCell(currentBoost, invGens); fixIndex != -1) {
-				cellBoost = gramSchmidt(g, invGens[fixIndex] * cellBoost);
-				invCellBoost = inverse(cellBoost);
+			// The timestep is fixed, so while the same keys are held it's the same step every time,
+			// and the sinh and cosh only need doing when they change.
+			const glm::vec3 step = eToHScale * deltaPos;
+			if (step != mStepVector || mStep.getGeometry() != g) {
+				mStep = AnyIsometry::translation(g, step);
+				mStepVector = step;
 			}
+			mBoost = mStep * mBoost;
+		}
 
+		if (deltaRot == glm::vec3{ 0.0f } && deltaPos == glm::vec3{ 0.0f }) {
+			return;
 		}
+		renormalizeIfDrifted(mBoost, mBoostDrift);
+		currentBoost = mBoost.toMat4();
 
-		if (change) {
-			auto& app = Application::get();
-			{
-				CurrentBoostChangedEvent e(&currentBoost);
-				app.onEvent(e);
-			}
-			if (posChange) {
+		if (deltaPos != glm::vec3{ 0.0f }) {
+			if (auto fixIndex = fixOutsideCentralCell(currentBoost, mNeighbourCentres); fixIndex != -1) {
+				cellBoost = gramSchmidt(g, invGens[fixIndex] * cellBoost);
+				invCellBoost = inverse(cellBoost);
+
+				// currentBoost itself goes to the shader in onUpdate, interpolated.
+				auto& app = Application::get();
 				{
 					CellBoostChangedEvent e(&cellBoost);
 					app.onEvent(e);
@@ -175,12 +278,261 @@ namespace App
 				}
 			}
 		}
-		deltaPos = glm::vec3{ 0.0f };
+	}
+
+	void SceneLayer::onImGuiRender(Timestep ts) {
+		ImGui::Begin("Camera");
+			ImGui::Text("drift %.2e  (max %.2e)", mBoostDrift.lastDrift, mBoostDrift.maxDrift);
+			ImGui::Text("renormalized %llu times in %llu steps", (unsigned long long)mBoostDrift.renormalizations,
+			            (unsigned long long)mBoostDrift.checks);
+			if (ImGui::Button("Reset stats")) {
+				mBoostDrift = {};
+			}
+		ImGui::End();
+
+		ImGui::SetNextWindowSize(ImVec2(440, 620), ImGuiCond_FirstUseEver);
+		ImGui::Begin("March stats");
+			bool enabled = mMarchStats != nullptr;
+			if (ImGui::Checkbox("Instrument the raymarcher", &enabled)) {
+				// Through the app, so the overlay knows to stop showing the counts.
+				MarchStatsRequestedEvent e(enabled);
+				Application::get().onEvent(e);
+			}
+			if (mMarchStats) {
+				const MarchCounts& c = mMarchCounters->getLatest();
+				ImGui::Text("per pixel: steps %.1f  local SDFs %.1f  global SDFs %.1f  shadow steps %.1f",
+				            c.perPixel(c.steps), c.perPixel(c.localSDFs), c.perPixel(c.globalSDFs),
+				            c.perPixel(c.shadowSteps));
+				ImGui::Text("frame %llu: %llu steps (%llu taken back), %llu of %llu pixels out of steps  (waited %llu times)",
+				            (unsigned long long)c.frame, (unsigned long long)c.steps, (unsigned long long)c.backtracks,
+				            (unsigned long long)c.outOfSteps, (unsigned long long)c.pixels,
+				            (unsigned long long)mMarchCounters->getStalls());
+				mMarchStats->onImGuiRender();
+			}
+			else {
+				ImGui::TextWrapped("Records every ray's steps, cell crossings, depth and how it ended, as a"
+				                   " heatmap and histograms, and counts the frame's steps and SDF calls."
+				                   " Costs a recompile, and some frame time while on.");
+			}
+		ImGui::End();
+
+		ImGui::Begin("Baked local SDF");
+			bool baked = mLocalSDFVolume != nullptr;
+			if (ImGui::Checkbox("Look the local scene up in a baked volume", &baked)) {
+				setBakedSDF(baked);
+			}
+			int resolution = (int)mBakedSDFResolution;
+			if (ImGui::SliderInt("Resolution", &resolution, 16, 256)) {
+				mBakedSDFResolution = (uint32_t)resolution;
+				invalidateBakedSDF();
+			}
+			if (ImGui::DragFloat("Exact below", &mBakedSDFExactBelow, 0.001f, 0.0f, 0.5f, "%.3f")) {
+				mShaderProgram->bind();
+				mShaderProgram->uploadUniformFloat("bakedSDFExactBelow", mBakedSDFExactBelow);
+			}
+			ImGui::SameLine(); ImGui::TextDisabled("(?)");
+			if (ImGui::IsItemHovered()) {
+				ImGui::SetTooltip("Where the volume says the surface is nearer than this, the analytic SDF"
+				                  " has the last word - so hits are exactly where they'd be without it.");
+			}
+			if (mLocalSDFVolume) {
+				const LocalSDFVolume::Bake& latest = mLocalSDFVolume->getLatest();
+				const uint32_t n = latest.input.resolution;
+				if (mLocalSDFVolume->getTexture()) {
+					ImGui::Text("%u^3 samples (%.1f MB), baked in %.1f ms over %u threads", n,
+					            n * n * n * sizeof(float) / (1024.0f * 1024.0f), latest.milliseconds, latest.threads);
+					ImGui::Text("Klein box (%.3f, %.3f, %.3f) to (%.3f, %.3f, %.3f)", latest.boxMin.x,
+					            latest.boxMin.y, latest.boxMin.z, latest.boxMax.x, latest.boxMax.y, latest.boxMax.z);
+				}
+				ImGui::Text(mBakedSDFInUse ? "In use." : "Baking - the analytic SDF's in use until it's done.");
+			}
+		ImGui::End();
+	}
+
+	void SceneLayer::setGeometry(Geometry::V geometry) {
+		if (geometry != g) {
+			g = geometry;
+			mBoost = AnyIsometry::fromMat4(g, currentBoost);
+			currentBoost = mBoost.toMat4();
+			mPrevBoost = currentBoost; // Nothing to interpolate between two geometries.
+		}
+		mNeighbourCentres = neighbourCellCentres(g, invGens);
+	}
+
+	void SceneLayer::updateEdgeTubePlanes() {
+		writeHoneycomb(&HoneycombUniforms::edgeTubePlanes, edgeTubePlanes(mHoneycomb.useSimplex,
+			mHoneycomb.halfCubeDualPoints, mHoneycomb.simplexDualPoints));
+	}
+
+	void SceneLayer::setBakedSDF(bool enabled) {
+		if (enabled == (mLocalSDFVolume != nullptr)) {
+			return;
+		}
+		mShaderProgram->bind();
+		mShaderProgram->uploadUniformBool("useBakedSDF", false);
+		mBakedSDFInUse = false;
+		if (enabled) {
+			mLocalSDFVolume = std::make_shared<LocalSDFVolume>();
+			mShaderProgram->uploadUniformFloat("bakedSDFExactBelow", mBakedSDFExactBelow);
+			mBakedSDFWanted = true;
+		}
+		else {
+			mLocalSDFVolume = nullptr;
+		}
+		LOG_INFO("Baked local SDF {0}.", enabled ? "on" : "off");
+	}
+
+	void SceneLayer::invalidateBakedSDF() {
+		mBakedSDFWanted = true;
+		if (mBakedSDFInUse) {
+			mShaderProgram->bind();
+			mShaderProgram->uploadUniformBool("useBakedSDF", false);
+			mBakedSDFInUse = false;
+		}
+	}
+
+	void SceneLayer::updateBakedSDF() {
+		if (mBakedSDFWanted) {
+			// Once a frame at most, however many of the handlers below asked for it.
+			LocalSDFVolume::Input input;
+			input.useSimplex = mHoneycomb.useSimplex;
+			input.edgeTubePlanes = mHoneycomb.edgeTubePlanes;
+			input.simplexMirrorsKlein = mHoneycomb.simplexMirrorsKlein;
+			input.halfCubeWidthKlein = mHoneycomb.halfCubeWidthKlein;
+			input.tubeRadius = mTubeRad;
+			input.resolution = mBakedSDFResolution;
+			mLocalSDFVolume->request(input);
+			mBakedSDFWanted = false;
+		}
+
+		const bool uploaded = mLocalSDFVolume->poll();
+		const bool inUse = mLocalSDFVolume->isCurrent();
+		if (!uploaded && inUse == mBakedSDFInUse) {
+			return;
+		}
+		mShaderProgram->bind();
+		if (inUse) {
+			mLocalSDFVolume->getTexture()->bind(sBakedSDFSlot);
+			mShaderProgram->uploadUniformFloat3("bakedSDFMin", mLocalSDFVolume->getLatest().boxMin);
+			mShaderProgram->uploadUniformFloat3("bakedSDFScale", mLocalSDFVolume->getScale());
+			mShaderProgram->uploadUniformFloat("bakedSDFOffset", mLocalSDFVolume->getOffset());
+			mShaderProgram->uploadUniformFloat("bakedSDFVoxel", mLocalSDFVolume->getVoxelDiagonal());
+		}
+		mShaderProgram->uploadUniformBool("useBakedSDF", inUse);
+		mBakedSDFInUse = inUse;
+	}
+
+	void SceneLayer::setShadowCache(bool enabled) {
+		if (enabled == (mShadowHistory[0] != nullptr)) {
+			return;
+		}
+		mShadowHistory = {};
+		mShadowHistoryValid = false;
+		if (enabled) {
+			for (auto& history : mShadowHistory) {
+				history = Texture2D::create(mFrameBufferTexture->getWidth(), mFrameBufferTexture->getHeight(),
+				                            TextureFormat::RGBA32UI);
+			}
+		}
+		else {
+			mFrameBuffer->detachTexture(sShadowHistorySlot);
+		}
+		mShaderProgram->bind();
+		mShaderProgram->uploadUniformBool("useShadowCache", enabled);
+		mShaderProgram->uploadUniformBool("shadowHistoryValid", false);
+		LOG_INFO("Shadow cache {0}.", enabled ? "on" : "off");
+	}
+
+	void SceneLayer::beginShadowHistory() {
+		const uint32_t width = mFrameBufferTexture->getWidth(), height = mFrameBufferTexture->getHeight();
+		if (mShadowHistory[0]->getWidth() != width || mShadowHistory[0]->getHeight() != height) {
+			// The frame's changed size: nothing in them to read yet.
+			for (auto& history : mShadowHistory) {
+				history = Texture2D::create(width, height, TextureFormat::RGBA32UI);
+			}
+			mShadowHistoryValid = false;
+		}
+
+		mShaderProgram->bind();
+		mShaderProgram->uploadUniformBool("shadowHistoryValid", mShadowHistoryValid);
+		if (mShadowHistoryValid) {
+			mShadowHistory[1 - mShadowHistoryWrite]->bind(sShadowHistorySlot);
+			// It's in the cell's frame, and what the shader needs is the camera's, as it was.
+			mShaderProgram->uploadUniformMat4("shadowReprojection", glm::inverse(mShadowHistoryBoost));
+		}
+		mShaderProgram->uploadUniformInt("shadowFrame", (int)(mShadowFrame++ & 0xffff));
+		mFrameBuffer->attachTexture(mShadowHistory[mShadowHistoryWrite], sShadowHistorySlot);
+	}
+
+	void SceneLayer::endShadowHistory() {
+		mShadowHistoryBoost = mRenderBoost;
+		mShadowHistoryValid = true;
+		mShadowHistoryWrite = 1 - mShadowHistoryWrite;
+	}
+
+	void SceneLayer::setMarchStats(bool enabled) {
+		if (enabled == (mMarchStats != nullptr)) {
+			return;
+		}
+		if (enabled) {
+			mMarchStats = std::make_shared<MarchStats>(mFrameBufferTexture->getWidth(),
+			                                           mFrameBufferTexture->getHeight());
+			mFrameBuffer->attachTexture(mMarchStats->getMarchTexture(), 1);
+			mMarchCounters = std::make_shared<MarchCounters>();
+			mMarchCounters->setListener([](const MarchCounts& counts) {
+				MarchCountsReadyEvent e(counts);
+				Application::get().onEvent(e);
+			});
+			// The quotes are part of the value: the tag turns into an include of it.
+			mShaderProgram->setTag("instrumentation", "\"Sandbox/assets/shaders/instrumentation.glsl\"");
+			if (mComputeProgram) {
+				mComputeProgram->setTag("instrumentation", "\"Sandbox/assets/shaders/instrumentation.glsl\"");
+			}
+		}
+		else {
+			mShaderProgram->setTagToDefault("instrumentation");
+			if (mComputeProgram) {
+				mComputeProgram->setTagToDefault("instrumentation");
+			}
+			mFrameBuffer->detachTexture(1);
+			mMarchStats = nullptr;
+			mMarchCounters = nullptr;
+		}
+		LOG_INFO("March stats {0}.", enabled ? "on" : "off");
+	}
+
+	void SceneLayer::setComputeRaymarcher(bool enabled) {
+		if (enabled == (mComputeProgram != nullptr)) {
+			return;
+		}
+		if (enabled) {
+			mComputeProgram = Shader::create(Path("Sandbox/assets/shaders/raymarchCompute.glsl"));
+			for (const auto& [tag, value] : mShaderProgram->getTags()) {
+				if (!value.isDefault) {
+					mComputeProgram->setTag(tag, value.val);
+				}
+			}
+			// Everything, this first time. onUpdate does it again every frame, but then it's only
+			// whatever's changed.
+			mComputeProgram->copyUniformsFrom(*mShaderProgram);
+		}
+		else {
+			mComputeProgram = nullptr;
+		}
+		LOG_INFO("Raymarching in the {0} shader.", enabled ? "compute" : "fragment");
 	}
 
 	void SceneLayer::onEvent(Event& event) {
 		EventDispatcher disp(event);
 
+		// Any uniform, or the scene, changing might change the shadows, so the last frame's can't be
+		// used again - all but the camera moving, which is what they're kept for. The cell changing
+		// counts, though: the history's in its frame.
+		if (event.isCustomEvent() && event.getEventType() != EventTypes::CurrentBoostChanged
+		    && event.isInCustomCategory(EventCategory::UniformChanged | EventCategory::SceneChanged)) {
+			mShadowHistoryValid = false;
+		}
+
 		disp.dispatch<DebugInfoChangedEvent>(
 			[this](DebugInfoChangedEvent& e) {
 			this->mShaderProgram->bind();
@@ -204,6 +556,8 @@ namespace App
 			this->mShaderProgram->bind();
 			LT("Recieved FOVChangedEvent val={0} : {1}", *e.valptr(), e);
 			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			// The same for every pixel, so it's worked out here rather than in getRayPoint.
+			this->mShaderProgram->uploadUniformFloat("imagePlaneDepth", 0.1f / std::tan(glm::radians(*e.valptr() * 0.5f)));
 			return true;
 		}
 		);
@@ -213,6 +567,7 @@ namespace App
 			this->mShaderProgram->bind();
 			LT("Recieved MaxStepsChangedEvent val={0} : {1}", *e.valptr(), e);
 			this->mShaderProgram->uploadUniformInt(e.name(), *e.valptr());
+			this->mMaxSteps = *e.valptr();
 			return true;
 		}
 		);
@@ -222,6 +577,43 @@ namespace App
 			this->mShaderProgram->bind();
 			LT("Recieved MaxDistChangedEvent val={0} : {1}", *e.valptr(), e);
 			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			this->mMaxDist = *e.valptr();
+			return true;
+		}
+		);
+
+		disp.dispatch<HitPixelFractionChangedEvent>(
+			[this](HitPixelFractionChangedEvent& e) {
+			this->mShaderProgram->bind();
+			LT("Recieved HitPixelFractionChangedEvent val={0} : {1}", *e.valptr(), e);
+			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			return true;
+		}
+		);
+
+		disp.dispatch<HitEpsilonMinChangedEvent>(
+			[this](HitEpsilonMinChangedEvent& e) {
+			this->mShaderProgram->bind();
+			LT("Recieved HitEpsilonMinChangedEvent val={0} : {1}", *e.valptr(), e);
+			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			return true;
+		}
+		);
+
+		disp.dispatch<UseOverRelaxationChangedEvent>(
+			[this](UseOverRelaxationChangedEvent& e) {
+			this->mShaderProgram->bind();
+			LT("Recieved UseOverRelaxationChangedEvent val={0} : {1}", *e.valptr(), e);
+			this->mShaderProgram->uploadUniformBool(e.name(), *e.valptr());
+			return true;
+		}
+		);
+
+		disp.dispatch<OverRelaxationChangedEvent>(
+			[this](OverRelaxationChangedEvent& e) {
+			this->mShaderProgram->bind();
+			LT("Recieved OverRelaxationChangedEvent val={0} : {1}", *e.valptr(), e);
+			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
 			return true;
 		}
 		);
@@ -253,6 +645,42 @@ namespace App
 		}
 		);
 
+		disp.dispatch<UseLightingChangedEvent>(
+			[this](UseLightingChangedEvent& e) {
+			this->mShaderProgram->bind();
+			LT("Recieved UseLightingChangedEvent val={0} : {1}", *e.valptr(), e);
+			this->mShaderProgram->uploadUniformBool(e.name(), *e.valptr());
+			return true;
+		}
+		);
+
+		disp.dispatch<ShadowStepBudgetsChangedEvent>(
+			[this](ShadowStepBudgetsChangedEvent& e) {
+			this->mShaderProgram->bind();
+			LT("Recieved ShadowStepBudgetsChangedEvent val={0}, {1}, {2}, {3} : {4}", (*e.valptr())[0],
+				(*e.valptr())[1], (*e.valptr())[2], (*e.valptr())[3], e);
+			this->mShaderProgram->uploadUniformInt(e.name(), 4, e.valptr()->data());
+			return true;
+		}
+		);
+
+		disp.dispatch<UseShadowCacheChangedEvent>(
+			[this](UseShadowCacheChangedEvent& e) {
+			LT("Recieved UseShadowCacheChangedEvent val={0} : {1}", *e.valptr(), e);
+			this->setShadowCache(*e.valptr());
+			return true;
+		}
+		);
+
+		disp.dispatch<HalfResShadowsChangedEvent>(
+			[this](HalfResShadowsChangedEvent& e) {
+			this->mShaderProgram->bind();
+			LT("Recieved HalfResShadowsChangedEvent val={0} : {1}", *e.valptr(), e);
+			this->mShaderProgram->uploadUniformBool(e.name(), *e.valptr());
+			return true;
+		}
+		);
+
 		disp.dispatch<ShadSoftChangedEvent>(
 			[this](ShadSoftChangedEvent& e) {
 			this->mShaderProgram->bind();
@@ -267,78 +695,79 @@ namespace App
 			this->mShaderProgram->bind();
 			LT("Recieved TubeRadiusChangedEvent val={0} : {1}", *e.valptr(), e);
 			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			this->mShaderProgram->uploadUniformFloat("tubeRadSinh", std::sinh(*e.valptr()));
+			this->mTubeRad = *e.valptr();
+			this->invalidateBakedSDF();
 			return true;
 		}
 		);
 
 		disp.dispatch<CellPositionChangedEvent>(
 			[this](CellPositionChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Recieved CellPositionChangedEvent val={0} : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat4(e.name(), *e.valptr());
+			this->writeHoneycomb(&HoneycombUniforms::cellPosition, *e.valptr());
 			return true;
 		}
 		);
 
 		disp.dispatch<CellSurfaceOffsetChangedEvent>(
 			[this](CellSurfaceOffsetChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Recieved CellSurfaceOffsetChangedEvent val={0} : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			this->writeHoneycomb(&HoneycombUniforms::cellSurfaceOffset, *e.valptr());
 			return false;
 		}
 		);
 
 		disp.dispatch<VertexPositionChangedEvent>(
 			[this](VertexPositionChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Recieved VertexPositionChangedEvent val={0} : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat4(e.name(), *e.valptr());
+			this->writeHoneycomb(&HoneycombUniforms::vertexPosition, *e.valptr());
 			return false;
 		}
 		);
 
 		disp.dispatch<VertexSurfaceOffsetChangedEvent>(
 			[this](VertexSurfaceOffsetChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Recieved VertexSurfaceOffsetChangedEvent val={0}, : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			this->writeHoneycomb(&HoneycombUniforms::vertexSurfaceOffset, *e.valptr());
 			return false;
 		}
 		);
 
 		disp.dispatch<UseSimplexChangedEvent>(
 			[this](UseSimplexChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Recieved UseSimplexChangedEvent val={0}, : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformBool(e.name(), *e.valptr());
+			this->writeHoneycomb(&HoneycombUniforms::useSimplex, (int32_t)*e.valptr());
+			this->updateEdgeTubePlanes();
+			this->invalidateBakedSDF();
 			return false;
 		}
 		);
 
 		disp.dispatch<SimplexMirrorsChangedEvent>(
 			[this](SimplexMirrorsChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Recieved SimplexMirrorsChangedEvent val=\n{0}, : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat4(e.name(), 4, e.valptr()->data());
+			this->writeHoneycomb(&HoneycombUniforms::simplexMirrorsKlein, *e.valptr());
+			this->invalidateBakedSDF();
 			return false;
 		}
 		);
 
 		disp.dispatch<SimplexDualPointsChangedEvent>(
 			[this](SimplexDualPointsChangedEvent& e) {
-				this->mShaderProgram->bind();
 				LT("Recieved SimplexDualPointsChangedEvent val=\n{0}, : {1}", *e.valptr(), e);
-				this->mShaderProgram->uploadUniformFloat4(e.name(), 4, e.valptr()->data());
+				this->writeHoneycomb(&HoneycombUniforms::simplexDualPoints, *e.valptr());
+				this->updateEdgeTubePlanes();
+				this->invalidateBakedSDF();
 				return false;
 			}
 		);
 
 		disp.dispatch<CutChangedEvent>(
 			[this](CutChangedEvent& e) {
-				this->mShaderProgram->bind();
 				LT("Recieved CutChangedEvent val={0} : {1}", *e.valptr(), e);
-				this->mShaderProgram->uploadUniformInt(e.name(), *e.valptr());
+				this->writeHoneycomb(e.name() == "cut1" ? &HoneycombUniforms::cut1 : &HoneycombUniforms::cut4,
+						(int32_t)*e.valptr());
 				return false;
 			}
 		);
@@ -404,10 +833,10 @@ namespace App
 
 		disp.dispatch<invGeneratorsChangedEvent>(
 			[this](invGeneratorsChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Received invGeneratorsChangedEvent val={0} : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformMat4(e.name(), 6, e.valptr()->data());
+			this->writeHoneycomb(&HoneycombUniforms::invGenerators, *e.valptr());
 			this->invGens = *e.valptr();
+			this->mNeighbourCentres = neighbourCellCentres(g, invGens);
 			return true;
 		}
 		);
@@ -417,25 +846,27 @@ namespace App
 			this->mShaderProgram->bind();
 			// LT("Received CurrentBoostChangedEvent val={0} : {1}", *e.valptr(), e);
 			this->mShaderProgram->uploadUniformMat4(e.name(), *e.valptr());
+			// Someone put us somewhere else (e.g. "Reset Position") - jump there, don't interpolate.
+			this->mBoost = AnyIsometry::fromMat4(g, *e.valptr());
 			this->currentBoost = *e.valptr();
+			this->mPrevBoost = this->currentBoost;
+			this->mRenderBoost = this->currentBoost;
 			return true;
 		}
 		);
 
 		disp.dispatch<LightPositionsChangedEvent>(
 			[this](LightPositionsChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Received LightPositionsChangedEvent val={0} : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat4(e.name(), 4, e.valptr()->data());
+			this->writeHoneycomb(&HoneycombUniforms::lightPositions, *e.valptr());
 			return true;
 		}
 		);
 
 		disp.dispatch<LightIntensitiesChangedEvent>(
 			[this](LightIntensitiesChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Received LightIntensitiesChangedEvent val={0} : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat4(e.name(), 5, e.valptr()->data());
+			this->writeHoneycomb(&HoneycombUniforms::lightIntensities, *e.valptr());
 			return true;
 		}
 		);
@@ -469,25 +900,19 @@ namespace App
 
 		disp.dispatch<HalfCubeDualPointChangedEvent>(
 			[this](HalfCubeDualPointChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Received HalfCubeDualPointChangedEvent val={0} : {1}", *e.valptr(), e);
-			float a = 0.70710678120f;
-			float b = 1.22474487140f;
-			std::array<glm::vec4, 3> buf = {
-				glm::vec4{ b, 0.0f, 0.0f, a },
-				glm::vec4{ 0.0f, b, 0.0f, a },
-				glm::vec4{ 0.0f, 0.0f, b, a }
-			};
-			this->mShaderProgram->uploadUniformFloat4(e.name(), 3, e.valptr()->data());
+			this->writeHoneycomb(&HoneycombUniforms::halfCubeDualPoints, *e.valptr());
+			this->updateEdgeTubePlanes();
+			this->invalidateBakedSDF();
 			return true;
 		}
 		);
 
 		disp.dispatch<HalfCubeWidthChangedEvent>(
 			[this](HalfCubeWidthChangedEvent& e) {
-			this->mShaderProgram->bind();
 			LT("Recieved HalfCubeWidthChangedEvent val={0} : {1}", *e.valptr(), e);
-			this->mShaderProgram->uploadUniformFloat(e.name(), *e.valptr());
+			this->writeHoneycomb(&HoneycombUniforms::halfCubeWidthKlein, *e.valptr());
+			this->invalidateBakedSDF();
 			return true;
 		}
 		);
@@ -510,11 +935,23 @@ namespace App
 			}
 		);
 
+		disp.dispatch<HoneycombChangedEvent>(
+			[this](HoneycombChangedEvent& e) {
+			LT("Recieved {0}", e);
+			this->mHoneycomb = *e.uniforms;
+			this->mHoneycombBuffer->setData(&this->mHoneycomb, sizeof(HoneycombUniforms));
+			this->invGens = e.params->invGens;
+			this->setGeometry(e.params->g);
+			this->invalidateBakedSDF();
+			return true;
+		}
+		);
+
 		disp.dispatch<GeometryChangedEvent>(
 			[this](GeometryChangedEvent& e) {
 			this->mShaderProgram->bind();
 			LT("Recieved GeometryChangedEvent val={0}, {1}, {2} : {3}", e.pqr[0], e.pqr[1], e.pqr[2], e);
-			this->g = getGeometry(e.pqr[0], e.pqr[1], e.pqr[2]);
+			this->setGeometry(getGeometry(e.pqr[0], e.pqr[1], e.pqr[2]));
 			return true;
 		}
 		);
@@ -535,10 +972,28 @@ namespace App
 		
 		disp.dispatch<TagSwapRequestedEvent>(
 			[this](TagSwapRequestedEvent& e) {
+				if (this->mComputeProgram) {
+					this->mComputeProgram->setTag(e.tag, e.val);
+				}
 				return this->mShaderProgram->setTag(e.tag, e.val);
 			}
 		);
 
+		disp.dispatch<MarchStatsRequestedEvent>(
+			[this](MarchStatsRequestedEvent& e) {
+				e.wasEnabled = this->mMarchStats != nullptr;
+				this->setMarchStats(e.enabled);
+				return true;
+			}
+		);
+
+		disp.dispatch<ComputeRaymarcherRequestedEvent>(
+			[this](ComputeRaymarcherRequestedEvent& e) {
+				this->setComputeRaymarcher(e.enabled);
+				return true;
+			}
+		);
+
 		disp.dispatch<KeyPressedEvent>(
 			[this](KeyPressedEvent& e) {
 				if (e.getRepeatCount()) {
@@ -5,8 +5,13 @@ using namespace Aulys;
 
 #include "Renderer/FrameBuffer.h"
 
+#include "Benchmark/MarchCounters.h"
+#include "Benchmark/MarchStats.h"
 #include "Events/AppEvent.h"
 #include "Geometry/GeometryMaths.h"
+#include "Geometry/HoneycombParams.h"
+#include "Geometry/Isometry.h"
+#include "Geometry/LocalSDFVolume.h"
 
 namespace App 
 {
@@ -20,23 +25,107 @@ namespace App
 		virtual void onAttach() override;
 		virtual void onDetach() override;
 		virtual void onUpdate(Timestep ts) override;
+		virtual void onFixedUpdate(Timestep ts) override;
+		virtual void onImGuiRender(Timestep ts) override;
 		virtual void onEvent(Event& event) override;
 
 	private:
+		// Moves the camera (mBoost) over to the new geometry, as best it can.
+		void setGeometry(Geometry::V geometry);
+
+		// Swaps the instrumented raymarcher in or out (see MarchStats.h and MarchCounters.h).
+		// Recompiles it, so not something to do every frame.
+		void setMarchStats(bool enabled);
+
+		// Swaps between fragment.glsl over the quad and raymarchCompute.glsl (see mComputeProgram).
+		// Compiles the compute one when it's turned on, so not something to do every frame either.
+		void setComputeRaymarcher(bool enabled);
+
+		// For when one of the dual points edgeTubePlanes comes from has been changed on its own.
+		void updateEdgeTubePlanes();
+
+		// Starts or stops baking the local scene into mLocalSDFVolume for the raymarcher.
+		void setBakedSDF(bool enabled);
+		// Something the local scene depends on has changed: stops the shader using the volume until
+		// it's been rebaked, which onUpdate starts.
+		void invalidateBakedSDF();
+		// onUpdate's side of it: starts a wanted bake, and hands the shader a finished one.
+		void updateBakedSDF();
+
+		// Makes or drops the shadow history (see shadowCache.glsl and mShadowHistory).
+		void setShadowCache(bool enabled);
+		// onUpdate's side of it, either side of the draw: hands the shader last frame's history to
+		// read and this frame's to write, then swaps them.
+		void beginShadowHistory();
+		void endShadowHistory();
+
+		// Writes one member of the Honeycomb uniform block, to our copy and to the buffer.
+		template<typename T>
+		void writeHoneycomb(T HoneycombUniforms::* member, const T& value) {
+			mHoneycomb.*member = value;
+			const auto offset = reinterpret_cast<const char*>(&(mHoneycomb.*member))
+				- reinterpret_cast<const char*>(&mHoneycomb);
+			mHoneycombBuffer->setData(&(mHoneycomb.*member), sizeof(T), (uint32_t)offset);
+		}
+
 		Ref<Shader> mShaderProgram;
+		// The compute raymarcher, only while it's the one in use. Everything still uploads to
+		// mShaderProgram, and this copies what's changed before each dispatch - so the two can't
+		// disagree. Its tags follow mShaderProgram's.
+		Ref<Shader> mComputeProgram;
+		static constexpr uint32_t sComputeTileSize = 8; // raymarchCompute.glsl's TILE_SIZE.
 		Ref<VertexArray> mRenderQuadVA;
 
 		Ref<Texture2D> mTexture;
 		Ref<FrameBuffer> mFrameBuffer = FrameBuffer::create();
 		Ref<Texture2D> mFrameBufferTexture;
+		Ref<MarchStats> mMarchStats; // Only while the march stats are on.
+		Ref<MarchCounters> mMarchCounters; // Likewise.
+		Ref<LocalSDFVolume> mLocalSDFVolume; // Only while the baked SDF is on.
+		static constexpr uint32_t sBakedSDFSlot = 1; // uTexture is in 0.
+		uint32_t mBakedSDFResolution = 64;
+		float mBakedSDFExactBelow = 0.02f;
+		bool mBakedSDFWanted = false; // Does the scene need rebaking?
+		bool mBakedSDFInUse = false;  // What useBakedSDF was last set to.
+
+		// The shadows kept between frames (see shadowCache.glsl), only while that's on: one's written
+		// while the other's read, and they swap every frame. The quad writes to its colour attachment
+		// 2, the compute raymarcher to its image unit 3, and both read the other from texture slot 2.
+		std::array<Ref<Texture2D>, 2> mShadowHistory{};
+		static constexpr uint32_t sShadowHistorySlot = 2;
+		static constexpr uint32_t sShadowHistoryImage = 3;
+		uint32_t mShadowHistoryWrite = 0; // Which one this frame writes.
+		// Whether the last one written still says anything about the scene - anything but the camera
+		// changing means it doesn't.
+		bool mShadowHistoryValid = false;
+		glm::mat4 mShadowHistoryBoost{ 1.0f }; // The camera it was written from.
+		uint32_t mShadowFrame = 0;
+
+		// The Honeycomb uniform block (see includes.glsl), and what's in it.
+		static constexpr uint32_t sHoneycombBinding = 0;
+		Ref<UniformBuffer> mHoneycombBuffer;
+		HoneycombUniforms mHoneycomb{};
 
 		float mScale = 4.0f;
+		uint32_t mMaxSteps = 29; // Copies of the uniforms, for the march stats' scales.
+		float mMaxDist = 6.4f;
+		float mTubeRad = 0.15f; // For the bake.
 		float mTimeElapsed = 0.0f;
 
 		OrthographicCamera mCamera;
 
 		// Scene state
+		// The camera is moved as an Isometry, which is far cheaper to compose than the matrices and
+		// only needs renormalizing once in a while (see renormalizeIfDrifted). currentBoost is
+		// always mBoost.toMat4().
+		AnyIsometry mBoost;
+		IsometryDriftStats mBoostDrift;
+		// One fixed step's translation, kept while the same keys are held.
+		AnyIsometry mStep;
+		glm::vec3 mStepVector{ 0.0f };
 		glm::mat4 currentBoost{ 1.0f };
+		glm::mat4 mPrevBoost{ 1.0f }; // currentBoost before the last fixed step.
+		glm::mat4 mRenderBoost{ 1.0f }; // What the shader was last given, between the two above.
 		glm::mat4 cellBoost{ 1.0f };
 		glm::mat4 invCellBoost{ 1.0f };
 		Geometry::V g = Geometry::Hyperbolic;
@@ -44,6 +133,7 @@ namespace App
 		float mSpeed = 0.01f;
 		float mRotSpeed = 0.001f;
 		std::array<glm::mat4, 6> invGens;
+		std::array<glm::vec4, 6> mNeighbourCentres{}; // neighbourCellCentres(g, invGens)
 
 		glm::vec2 lastMousePos;
 		glm::vec3 deltaPosState{0.0f};
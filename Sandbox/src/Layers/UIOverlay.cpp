@@ -3,8 +3,6 @@
 #include "Events/AppEvent.h"
 
 #include "Geometry/GeometryMaths.h"
-#include "Geometry/Simplex.h"
-#include "Geometry/Honeycomb.h"
 #include "Geometry/Scene.h"
 
 #include "Log/ConsoleSink.h"
@@ -109,6 +107,15 @@ DockSpace     ID=0x16C4D719 Window=0xE2091CDF Pos=8,8 Size=1904,1064 Split=X
     DockNode  ID=0x00000005 Parent=0x00000002 SizeRef=389,857 Selected=0x8C45687A
     DockNode  ID=0x00000006 Parent=0x00000002 SizeRef=389,205 Selected=0x01940FD6)";
 		ImGui::LoadIniSettingsFromMemory(guibuf, 1025);
+
+		// Everything about every honeycomb we can draw, worked out on the first run and read back
+		// from disk after that.
+		const Path cachePath("cache/honeycombs.bin");
+		if (!mHoneycombs.load(cachePath.get())) {
+			const size_t added = mHoneycombs.prewarm(sMaxHoneycombValue);
+			mHoneycombs.save(cachePath.get());
+			LOG_INFO("Worked out {0} honeycombs, saved them to \"{1}\".", added, cachePath.get());
+		}
 	};
 
 
@@ -168,6 +175,50 @@ DockSpace     ID=0x16C4D719 Window=0xE2091CDF Pos=8,8 Size=1904,1064 Split=X
 					MaxDistChangedEvent e("maxDist", &mMaxDist);
 					app.onEvent(e);
 				}
+
+				// A hit is anything nearer than this much of a pixel at that depth (0 is never more
+				// than the minimum), see hitEpsilon in raymarch.glsl.
+				if(ImGui::DragFloat("Hit pixel fraction", &mHitPixelFraction, 0.005f, 0.0f, 4.0f))
+				{
+					HitPixelFractionChangedEvent e("hitPixelFraction", &mHitPixelFraction);
+					app.onEvent(e);
+				}
+
+				if(ImGui::DragFloat("Min hit distance", &mHitEpsilonMin, 0.00001f, 0.000001f, 0.01f, "%.6f"))
+				{
+					HitEpsilonMinChangedEvent e("hitEpsilonMin", &mHitEpsilonMin);
+					app.onEvent(e);
+				}
+
+				// See MarchStepper in general.glsl. The shadows step the same way.
+				const char* steppings[] = { "Series distance", "Over-relaxed" };
+				if(ImGui::Combo("Stepping", &mStepping, steppings, IM_ARRAYSIZE(steppings))) {
+					bool useOverRelaxation = mStepping == 1;
+					UseOverRelaxationChangedEvent e("useOverRelaxation", &useOverRelaxation);
+					app.onEvent(e);
+				}
+
+				if(mStepping == 1 && ImGui::DragFloat("Over-relaxation", &mOverRelaxation, 0.005f, 1.0f, 1.99f))
+				{
+					OverRelaxationChangedEvent e("overRelaxation", &mOverRelaxation);
+					app.onEvent(e);
+				}
+
+				// Recompiles the shader, see geodesicsExact.glsl and geodesicsIncremental.glsl.
+				const char* geodesics[] = { "Exact", "Incremental" };
+				if(ImGui::Combo("Geodesics", &mGeodesics, geodesics, IM_ARRAYSIZE(geodesics))) {
+					const std::string tag = "geodesics";
+					const std::string file = mGeodesics == 0 ? sGeodesicsExact : sGeodesicsIncremental;
+					TagSwapRequestedEvent e(tag, file);
+					app.onEvent(e);
+				}
+
+				// The same raymarch either way, see raymarchCompute.glsl.
+				const char* raymarchers[] = { "Fragment shader", "Compute, 8x8 tiles" };
+				if(ImGui::Combo("Raymarcher", &mRaymarcher, raymarchers, IM_ARRAYSIZE(raymarchers))) {
+					ComputeRaymarcherRequestedEvent e(mRaymarcher == 1);
+					app.onEvent(e);
+				}
 			}
 
 			ImGui::SetNextItemOpen(true, ImGuiCond_Once);
@@ -176,6 +227,67 @@ DockSpace     ID=0x16C4D719 Window=0xE2091CDF Pos=8,8 Size=1904,1064 Split=X
 					AmbientChangedEvent e("ambient", &mAmbient);
 					app.onEvent(e);
 				}
+
+				if (ImGui::Checkbox("Lights", &mUseLighting)) {
+					UseLightingChangedEvent e("useLighting", &mUseLighting);
+					app.onEvent(e);
+				}
+
+				if (mUseLighting) {
+					bool shadowsChanged = ImGui::Checkbox("Local shadows", &mRenderShads[0]);
+					ImGui::SameLine();
+					shadowsChanged |= ImGui::Checkbox("Global shadows", &mRenderShads[1]);
+					if (shadowsChanged) {
+						RenderShadsChangedEvent e("renderShadows", &mRenderShads);
+						app.onEvent(e);
+					}
+
+					if (ImGui::DragFloat("Shadow softness", &mShadowSoftness, 0.005f, 0.0f, 10.0f)) {
+						ShadSoftChangedEvent e("shadSoft", &mShadowSoftness);
+						app.onEvent(e);
+					}
+
+					// See shadowCache.glsl.
+					if (ImGui::Checkbox("Keep shadows between frames", &mShadowCache)) {
+						UseShadowCacheChangedEvent e("useShadowCache", &mShadowCache);
+						app.onEvent(e);
+					}
+
+					if (ImGui::Checkbox("Half resolution shadows", &mHalfResShadows)) {
+						HalfResShadowsChangedEvent e("halfResShadows", &mHalfResShadows);
+						app.onEvent(e);
+					}
+					ImGui::SameLine(); ImGui::TextDisabled("(?)");
+					if (ImGui::IsItemHovered()) {
+						ImGui::SetTooltip("A pixel in four marches its shadows, and the rest share them where"
+						                  " they're on the same surface. The compute raymarcher's only.");
+					}
+
+					// Each light's budget, and what it's costing (while the march stats are on).
+					bool budgetsChanged = false;
+					for (int light = 0; light < 4; light++) {
+						char label[32];
+						std::snprintf(label, sizeof(label), "Light %d shadow steps", light);
+						budgetsChanged |= ImGui::DragInt(label, &mShadowStepBudgets[light], 0.2f, 0, 127);
+					}
+					if (budgetsChanged) {
+						ShadowStepBudgetsChangedEvent e("shadowStepBudgets", &mShadowStepBudgets);
+						app.onEvent(e);
+					}
+					if (mMarchCounts.pixels > 0) {
+						const MarchCounts& c = mMarchCounts;
+						for (uint32_t light = 0; light < MarchCounts::sLights; light++) {
+							const uint64_t shadows = c.shadowMarches[light] + c.shadowReuses[light];
+							ImGui::Text("light %u: %.2f steps a pixel, %.1f a march, %.0f%% reused", light,
+							            c.perPixel(c.lightShadowSteps[light]),
+							            c.shadowMarches[light] ? (float)c.lightShadowSteps[light] / c.shadowMarches[light] : 0.0f,
+							            shadows ? 100.0f * c.shadowReuses[light] / shadows : 0.0f);
+						}
+					}
+					else {
+						ImGui::TextDisabled("Turn the march stats on for what each light costs.");
+					}
+				}
 			}
 		ImGui::End();
 
@@ -218,172 +330,79 @@ DockSpace     ID=0x16C4D719 Window=0xE2091CDF Pos=8,8 Size=1904,1064 Split=X
 			//	GeometryChangedEvent e(pqr);
 			//	app.onEvent(e);
 			//}
+			{
+				// Only the ones in the cache, so picking one never has to work anything out.
+				char label[32];
+				std::snprintf(label, sizeof(label), "{%d, %d, %d}", pqr[0], pqr[1], pqr[2]);
+				bool changed = false;
+				if (ImGui::BeginCombo("Honeycomb", label)) {
+					for (const auto& [key, params] : mHoneycombs.getEntries()) {
+						std::snprintf(label, sizeof(label), "{%d, %d, %d}", key[0], key[1], key[2]);
+						if (ImGui::Selectable(label, key == pqr)) {
+							pqr = key;
+							changed = true;
+						}
+					}
+					ImGui::EndCombo();
+				}
+				if (changed) {
+					GeometryChangedEvent e(pqr);
+					app.onEvent(e);
+				}
+			}
 			if(ImGui::DragFloat("Tube Radius", &mTubeRad, 0.00007f, 0.0f, 3.0f)) {
 				TubeRadiusChangedEvent e("tubeRad", &mTubeRad);
 				app.onEvent(e);
 			}
+
+			if(ImGui::CollapsingHeader("Frame pacing")) {
+				// These are read by the FramePacer every frame, so there's nothing to send.
+				auto& pacing = app.getFramePacer().getSettings();
+				ImGui::Checkbox("Low latency", &pacing.lowLatency);
+				int maxQueued = (int)pacing.maxQueuedFrames;
+				if (ImGui::SliderInt("Max queued frames", &maxQueued, 0, 3)) {
+					pacing.maxQueuedFrames = (uint32_t)maxQueued;
+				}
+				ImGui::Checkbox("Throttle with glFinish", &pacing.useFinish);
+				ImGui::DragFloat("Deadline margin (ms)", &pacing.marginMs, 0.01f, 0.0f, 16.0f);
+
+				const FrameStats& stats = app.getFramePacer().getStats();
+				ImGui::Text("frame %.2fms  cpu %.2fms  gpu %.2fms", stats.frameMs, stats.cpuMs, stats.gpuMs);
+				ImGui::Text("slept %.2fms  throttled %.2fms  (%.0fHz)", stats.sleepMs, stats.throttleMs,
+				            stats.refreshRate);
+				ImGui::Text("input to photon ~%.1fms", stats.latencyMs);
+				// Comes a few frames after the frame itself, so it's for an older frame than the rest.
+				if (mMarchCounts.pixels > 0) {
+					const MarchCounts& c = mMarchCounts;
+					ImGui::Text("per pixel: steps %.1f  SDFs %.1f local, %.1f global  shadow steps %.1f",
+					            c.perPixel(c.steps), c.perPixel(c.localSDFs), c.perPixel(c.globalSDFs),
+					            c.perPixel(c.shadowSteps));
+					ImGui::Text("out of steps %.1f%%  backtracks %.2f  (frame %llu)", 100.0f * c.perPixel(c.outOfSteps),
+					            c.perPixel(c.backtracks), (unsigned long long)c.frame);
+				}
+			}
 		ImGui::End();
 	}
 
 	bool UIOverlay::updateUniformsFromUI(GeometryChangedEvent& e) {
-		Geometry::V g = getGeometry(e.p, e.q, e.r);
-		bool isCubical = (e.p == 4) && (e.q == 3);
 		// Here, we could rebuild the shader as necessary in the future.
+		const HoneycombParams& params = mHoneycombs.get(e.pqr);
+		const HoneycombUniforms uniforms = params.uniforms(this->mTubeRad);
+
+		this->hCWH = params.hCWH;
+		this->hCWK = params.hCWK;
+		this->mCellPosition = uniforms.cellPosition;
+		this->mCellSurfaceOffset = uniforms.cellSurfaceOffset;
+		this->mVertexPosition = uniforms.vertexPosition;
+		this->mVertexSurfaceOffset = uniforms.vertexSurfaceOffset;
+		this->mTargetFPS = params.targetFPS;
+		this->mMaxSteps = params.maxSteps;
 
-		float inRadius = inRadiusCalc(e.p, e.q, e.r, g);
-		float midRadius = midRadiusCalc(e.p, e.q, e.r, g, inRadius);
-		this->hCWH = this->hCWK = inRadius;
-		if (g == Geometry::Spherical) {
-			this->hCWK = stereographicToGnomonic(sphericalToStereographic(inRadius));
-		}
-		if(g == Geometry::Hyperbolic) {
-			this->hCWK = poincareToKlein(hyperbolicToPoincare(inRadius));
-		}
-
-		float tubeRad = this->mTubeRad;
-		float hOffset = tubeRad;
-
-		Geometry::V cut1 = getGeometry2D(e.p, e.q);
-		Geometry::V cut4 = getGeometry2D(e.q, e.r);
-
-		switch(cut1) {
-			case Geometry::Euclidean:
-			{
-				this->mCellPosition = {0.0f, 0.0f, 1.0f, 1.0f};
-
-				auto facetsUHS = simplexFacetsUHS(e.p, e.q, e.r);
-				auto a = getTrianglePSide(e.q, e.p);
-				// facetsUHS[3]
-				auto c = facetsUHS.cellMirror.radius;
-				auto b = sqrt(c*c - a*a);
-				glm::vec3 vUHS(0.0f, 0.0f, b);
-				auto poincare = UHSToPoincare(vUHS);
-				this->mCellSurfaceOffset = poincareToHyperbolic(-poincare.z) - hOffset;
-			}
-			case Geometry::Hyperbolic:
-			{
-				this->mCellPosition = {0.0f, 0.0f, 1.0f, 0.0f};
-
-				float a = getTrianglePSide(e.q, e.p);
-				float c = sinh(sin(a) / cos(piOver(e.r)));
-				float b = acosh(cosh(c) / cosh(a));
-				glm::vec3 poincare = UHSToPoincare({0.0f, 0.0f, hyperbolicToPoincare(b)});
-				this->mCellSurfaceOffset = poincareToHyperbolic(-poincare.z) - hOffset;
-			}
-			case Geometry::Spherical:
-		   	{
-				this->mCellPosition = {0.0f, 0.0f, 0.0f, 1.0f};
-				this->mCellSurfaceOffset = midRadius - hOffset;
-			}
-			default:
-				AU_ASSERT(true, "Geometry value g=\"{0}\" (calculated from p={1}, q={2}, "
-					"r={3}) isn't appropriate for this function. Check your arguments.");
-		}
-
-		auto midEdge = constructPointInGeometry(g,
-				glm::vec3(cos(PI/4.0f), cos(PI/4.0f), 1),
-				this->mCellSurfaceOffset);
-
-		this->mVertexPosition = glm::vec4( hCWK, hCWK, hCWK, 1.0f );
-		if(g != Geometry::Euclidean) {
-			this->mVertexPosition = normalize(g, mVertexPosition);
-		}
-
-		switch(cut4) {
-			case Geometry::Euclidean:
-			{
-				auto distToMidEdge = horosphereHSDF(g, midEdge, IDEALCUBECORNERKLEIN, 
-						-mCellSurfaceOffset);
-				this->mVertexPosition = IDEALCUBECORNERKLEIN;
-				this->mVertexSurfaceOffset = -(mCellSurfaceOffset - distToMidEdge);
-				break;
-			}
-			case Geometry::Hyperbolic:
-				this->mVertexSurfaceOffset = geodesicPlaneHSDF(g, midEdge, mVertexPosition, 0.0f);
-				break;
-			case Geometry::Spherical:
-				this->mVertexSurfaceOffset = length(g, mVertexPosition - midEdge);
-				break;
-		}
-
-		if(isCubical) {
-			this->mTargetFPS = 27.5f;
-			this->mMaxSteps = 31;
-		}
-		else {
-			this->mVertexSurfaceOffset = 0.0f;
-			cut4 = Geometry::Invalid;
-
-			this->mTargetFPS = 17.0f;
-			this->mMaxSteps = 55;
-		}
-
-		float maxDist = 10.0f;
-		if(g == Geometry::Euclidean) {
-			maxDist = 50.0f;
-		}
-
-		auto gens = initGenerators(e.p, e.q, e.r, defhCWK);
-		auto lights = initLights(g);
-
-		// Upload literally every uniform here.
 		auto& app = Application::get();
 
 		{
-			LightPositionsChangedEvent e(lights.first.get());
-			app.onEvent(e);
-		}
-		{
-			LightIntensitiesChangedEvent e(lights.second.get());
-			app.onEvent(e);
-		}
-		{
-			CellPositionChangedEvent e("cellPosition", &mCellPosition);
-			app.onEvent(e);
-		}
-		{
-			CellSurfaceOffsetChangedEvent e("cellSurfaceOffset", &mCellSurfaceOffset);
-			app.onEvent(e);
-		}
-		{
-			VertexPositionChangedEvent e("vertexPosition", &mVertexPosition);
-			app.onEvent(e);
-		}
-		{
-			VertexSurfaceOffsetChangedEvent e("vertexSurfaceOffset", &mVertexSurfaceOffset);
-			app.onEvent(e);
-		}
-		{
-			bool useSimplex = !isCubical;
-			UseSimplexChangedEvent e("useSimplex", &useSimplex);
-			app.onEvent(e);
-		}
-		{
-			SimplexMirrorsChangedEvent e("simplexMirrorsKlein", &gens.simplexMirrors);
-			app.onEvent(e);
-		}
-		{
-			invGeneratorsChangedEvent e(&gens.invGens);
-			app.onEvent(e);
-		}
-		{
-			SimplexDualPointsChangedEvent e("simplexDualPoints", &gens.simplexDualPoints);
-			app.onEvent(e);
-		}
-		{
-			HalfCubeDualPointChangedEvent e(&gens.halfCubeDualPoints);
-			app.onEvent(e);
-		}
-		{
-			HalfCubeWidthChangedEvent e(&this->hCWK);
-			app.onEvent(e);
-		}
-		{
-			CutChangedEvent e("cut1", reinterpret_cast<int*>(&cut1));
-			app.onEvent(e);
-		}
-		{
-			CutChangedEvent e("cut4", reinterpret_cast<int*>(&cut4));
+			// Generators, lights, cell and vertex cuts, the lot: one write to the uniform block.
+			HoneycombChangedEvent e(&params, &uniforms);
 			app.onEvent(e);
 		}
 		{
@@ -410,10 +429,142 @@ DockSpace     ID=0x16C4D719 Window=0xE2091CDF Pos=8,8 Size=1904,1064 Split=X
 
 		disp.dispatch<GeometryChangedEvent>(
 			[this](GeometryChangedEvent& e){
+				this->pqr = e.pqr; // It didn't necessarily come from us, e.g. a camera path.
 				return this->updateUniformsFromUI(e);
 			}
 		);
 
+		disp.dispatch<TagSwapRequestedEvent>(
+			[this](TagSwapRequestedEvent& e) {
+				if (e.tag == "geodesics") {
+					this->mGeodesics = e.val == sGeodesicsIncremental ? 1 : 0;
+				}
+				return false;
+			}
+		);
+
+		disp.dispatch<MarchCountsReadyEvent>(
+			[this](MarchCountsReadyEvent& e) {
+				this->mMarchCounts = e.counts;
+				return false;
+			}
+		);
+
+		disp.dispatch<MarchStatsRequestedEvent>(
+			[this](MarchStatsRequestedEvent& e) {
+				if (!e.enabled) {
+					this->mMarchCounts = {};
+				}
+				return false;
+			}
+		);
+
+		disp.dispatch<ComputeRaymarcherRequestedEvent>(
+			[this](ComputeRaymarcherRequestedEvent& e) {
+				this->mRaymarcher = e.enabled ? 1 : 0;
+				return false;
+			}
+		);
+
+		// The same for these: keep what the UI shows in step with whoever set them.
+		disp.dispatch<MaxStepsChangedEvent>(
+			[this](MaxStepsChangedEvent& e) {
+				this->mSteps = (int)*e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<MaxDistChangedEvent>(
+			[this](MaxDistChangedEvent& e) {
+				this->mMaxDist = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<HitPixelFractionChangedEvent>(
+			[this](HitPixelFractionChangedEvent& e) {
+				this->mHitPixelFraction = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<HitEpsilonMinChangedEvent>(
+			[this](HitEpsilonMinChangedEvent& e) {
+				this->mHitEpsilonMin = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<UseOverRelaxationChangedEvent>(
+			[this](UseOverRelaxationChangedEvent& e) {
+				this->mStepping = *e.valptr() ? 1 : 0;
+				return false;
+			}
+		);
+
+		disp.dispatch<OverRelaxationChangedEvent>(
+			[this](OverRelaxationChangedEvent& e) {
+				this->mOverRelaxation = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<FOVChangedEvent>(
+			[this](FOVChangedEvent& e) {
+				this->mFov = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<UseLightingChangedEvent>(
+			[this](UseLightingChangedEvent& e) {
+				this->mUseLighting = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<RenderShadsChangedEvent>(
+			[this](RenderShadsChangedEvent& e) {
+				this->mRenderShads = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<ShadSoftChangedEvent>(
+			[this](ShadSoftChangedEvent& e) {
+				this->mShadowSoftness = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<ShadowStepBudgetsChangedEvent>(
+			[this](ShadowStepBudgetsChangedEvent& e) {
+				this->mShadowStepBudgets = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<UseShadowCacheChangedEvent>(
+			[this](UseShadowCacheChangedEvent& e) {
+				this->mShadowCache = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<HalfResShadowsChangedEvent>(
+			[this](HalfResShadowsChangedEvent& e) {
+				this->mHalfResShadows = *e.valptr();
+				return false;
+			}
+		);
+
+		disp.dispatch<TubeRadiusChangedEvent>(
+			[this](TubeRadiusChangedEvent& e) {
+				this->mTubeRad = *e.valptr();
+				return false;
+			}
+		);
+
 		disp.dispatch<AppTickEvent>(
 			[](AppTickEvent& e) {
 				ALIL("{0} recieved by UI", e);
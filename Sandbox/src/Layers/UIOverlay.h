@@ -3,6 +3,7 @@
 #include "Aulys.h"
 
 #include "Geometry/Maths.h"
+#include "Geometry/HoneycombParams.h"
 #include "Events/AppEvent.h"
 
 #include "Log/ConsoleSink.h"
@@ -37,15 +38,30 @@ namespace App
 
 		int mSteps = 29;
 		float mMaxDist = 6.4f;
+		float mHitPixelFraction = 0.5f;
+		float mHitEpsilonMin = 0.0001f;
+		int mStepping = 0; // 0 for the series distance, 1 for over-relaxed.
+		float mOverRelaxation = 1.3f;
+		// The "geodesics" tag's value: 0 for exact, 1 for incremental. The quotes are part of it.
+		int mGeodesics = 0;
+		int mRaymarcher = 0; // 0 for fragment.glsl, 1 for raymarchCompute.glsl.
+		inline static const std::string sGeodesicsExact = "\"Sandbox/assets/shaders/geodesicsExact.glsl\"";
+		inline static const std::string sGeodesicsIncremental = "\"Sandbox/assets/shaders/geodesicsIncremental.glsl\"";
 
 		int mAttenuation = 1;
 		float mAttnSpd = 0.05f;
+		bool mUseLighting = true;
 		std::array<bool, 2> mRenderShads = {false, false};
 		float mShadowSoftness = 0.25f;
+		std::array<int, 4> mShadowStepBudgets = {32, 32, 32, 32};
+		bool mShadowCache = true;
+		bool mHalfResShadows = false;
 		float mAmbient = 0.8f;
 
 		/* Scene Geometry Settings */
 		std::array<int, 3> pqr = {4,3,6};
+		HoneycombCache mHoneycombs;
+		static constexpr int sMaxHoneycombValue = 6; // Largest p, q or r prewarmed.
 		float mTubeRad = 0.15f;
 
 		// UI Configuration settings, there are just TEMPorary.
@@ -75,6 +91,9 @@ namespace App
 		float mRotSpeed = 0.001f;
 		float fontScale = 1.0f;
 
+		// The last frame's raymarch work, while SceneLayer's counting it (pixels is 0 otherwise).
+		MarchCounts mMarchCounts;
+
 		std::shared_ptr<ConsoleSink> consoleSink = std::make_shared<ConsoleSink>();
 		Ref<Texture2D> mCurrentTexture;
 	}; // class UIOverlay : public Layer
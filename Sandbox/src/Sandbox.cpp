@@ -4,17 +4,43 @@ namespace App
 {
 	Sandbox::Sandbox() : Application({"A real hyperbolic mess.", 1920, 1080}){
 		// this->getWindow().setFullscreen();
+		// RGBA, as the compute raymarcher stores to it as an image, and RGB8 can't be one.
 		Ref<Texture2D> renderTexture = Texture2D::create(this->getWindow().getWidth(),
-		                                                 this->getWindow().getHeight());
+		                                                 this->getWindow().getHeight(), TextureFormat::RGBA8);
 		this->pushOverlay(new UIOverlay(renderTexture));
 		// Manages input and output, communicates changes to SceneLayer through events.
 		this->pushLayer(new SceneLayer(renderTexture));
 			// Manages rendering, assets, etc.
+		this->mCameraPath = new CameraPathLayer();
+		this->pushLayer(mCameraPath);
+			// Records and plays back camera paths, see CameraPathLayer.h - above SceneLayer, so it
+			// sees the movement keys before SceneLayer handles them.
+
+		if (const char* pathFile = std::getenv("SANDBOX_CAMERA_PATH")) {
+			const char* reportFile = std::getenv("SANDBOX_CAMERA_PATH_OUT");
+			if (!mCameraPath->play(pathFile, reportFile ? reportFile : "", true)) {
+				// Whatever ran us is waiting for a report that isn't coming.
+				this->mRunning = false;
+			}
+		}
 	}
 
 	void Sandbox::Run() { // The central function of the whole program.
 		while (this->mRunning) {
+			// Input is polled here rather than right after the swap, so that in low latency mode it's
+			// polled after the FramePacer has slept until the last moment it could start the frame.
+			mFramePacer->beginFrame();
+			mWindow->pollEvents();
+
 			Timestep deltaTime = this->mWindow->calculateDeltaTime(mLastFrameTime);
+			// A camera path plays back exactly one fixed step a frame, however long the frame took.
+			if (mCameraPath->isPlaying()) {
+				deltaTime = this->getFixedTimestep();
+			}
+
+			// Movement and anything else that should be frame rate independent, see
+			// Application::runFixedUpdates. The layers' onUpdate then render in between the steps.
+			this->runFixedUpdates(deltaTime);
 
 			for (Layer* layer : this->mLayerStack) {
 				layer->onUpdate(deltaTime);
@@ -25,7 +51,7 @@ namespace App
 				layer->onImGuiRender(deltaTime);
 			}
 			mImGuiLayer->end();
-			mWindow->onUpdate();
+			mFramePacer->present(*mWindow);
 		}
 	}
 }; // namespace App
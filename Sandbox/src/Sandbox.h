@@ -8,6 +8,7 @@ using namespace Aulys;
 
 #include "Layers/SceneLayer.h"
 #include "Layers/UIOverlay.h"
+#include "Layers/CameraPathLayer.h"
 
 namespace App 
 {
@@ -18,6 +19,7 @@ namespace App
 
 			void Run() override;
 		private:
+			CameraPathLayer* mCameraPath;
 
 	}; // class Sandbox : public Application
 }; // namespace App
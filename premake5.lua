@@ -87,6 +87,8 @@ project "Aulys"
              -- "dl",
              -- "pthread",
 			"X11",
+			-- For HeadlessWindow.
+			"EGL",
 		}
 
 	defines {
@@ -164,6 +166,7 @@ project "Sandbox"
 	filter "system:linux"
 		links {
 			"X11",
+			"EGL",
 			"dl",
 			"pthread",
 		}
@@ -195,3 +198,135 @@ project "Sandbox"
 		optimize "on"
 		symbols "off"
 
+
+project "LogDecode"
+	location "LogDecode"
+	kind "ConsoleApp"
+	staticruntime "on"
+
+	language "C++"
+	cppdialect "C++17"
+
+	targetname "aulys-logdecode"
+	targetdir ("build/" .. outputdir .. "/%{prj.name}")
+	objdir ("build/int/" .. outputdir .. "/%{prj.name}")
+
+	files {
+		"%{prj.name}/src/**.cpp",
+		"%{prj.name}/src/**.h",
+		"Aulys/src/Log/BinaryLogFormat.h",
+	}
+
+	includedirs {
+		"Aulys/src/",
+		"dependencies/spdlog/include/",
+	}
+
+	filter "system:windows"
+		defines {
+			"AU_PLATFORM_WINDOWS",
+		}
+
+	filter "system:linux"
+		defines {
+			"AU_PLATFORM_LINUX",
+		}
+
+	filter "configurations:Debug"
+		defines "AU_DEBUG"
+		runtime "Debug"
+
+		optimize "off"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "AU_RELEASE"
+		runtime "Release"
+
+		optimize "on"
+		symbols "on"
+
+	filter "configurations:Dist"
+		defines "AU_DIST"
+		runtime "Release"
+
+		optimize "on"
+		symbols "off"
+
+
+project "AulysBench"
+	location "AulysBench"
+	kind "ConsoleApp"
+	staticruntime "on"
+
+	language "C++"
+	cppdialect "C++17"
+
+	targetdir ("build/" .. outputdir .. "/%{prj.name}")
+	objdir ("build/int/" .. outputdir .. "/%{prj.name}")
+
+	-- The benchmarks, and the Sandbox's geometry that they time.
+	files {
+		"%{prj.name}/src/**.cpp",
+		"%{prj.name}/src/**.h",
+		"Sandbox/src/Geometry/**.cpp",
+		"Sandbox/src/Geometry/**.h",
+	}
+
+	includedirs {
+		"Aulys/src/",
+		"Sandbox/src/",
+		"dependencies/spdlog/include/",
+		"dependencies/spdlog/include/spdlog/",
+		"dependencies/Glad/include/",
+		"dependencies/imgui/",
+		"dependencies/glm/",
+		"dependencies/stb/",
+		"dependencies/",
+	}
+
+	links {
+		"Aulys",
+		"Glad",
+		"GLFW",
+		"ImGui",
+	}
+
+	filter "system:windows"
+		defines {
+			"AU_PLATFORM_WINDOWS",
+		}
+
+	filter "system:linux"
+		links {
+			"X11",
+			"EGL",
+			"dl",
+			"pthread",
+		}
+
+		defines {
+			"AU_PLATFORM_LINUX",
+			"SANDBOX_AU"
+		}
+
+	filter "configurations:Debug"
+		defines "AU_DEBUG"
+		runtime "Debug"
+
+		optimize "off"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "AU_RELEASE"
+		runtime "Release"
+
+		optimize "on"
+		symbols "on"
+
+	filter "configurations:Dist"
+		defines "AU_DIST"
+		runtime "Release"
+
+		optimize "on"
+		symbols "off"